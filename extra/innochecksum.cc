@@ -51,6 +51,10 @@ The parts not included are excluded by #ifndef UNIV_INNOCHECKSUM. */
 #include "fil0crypt.h"           /* fil_space_verify_crypt_checksum */
 
 #include <string.h>
+#include <zlib.h>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifdef UNIV_NONINL
 # include "fsp0fsp.inl"
@@ -73,6 +77,7 @@ static bool			do_one_page;
 static my_bool do_leaf;
 static my_bool per_page_details;
 static ulint n_merge;
+static my_bool estimate_dict;
 static ulint physical_page_size;  /* Page size in bytes on disk. */
 ulong srv_page_size;
 uint32_t srv_page_size_shift;
@@ -1154,6 +1159,250 @@ print_summary(
 	}
 }
 
+/** Size of a trained compression dictionary in bytes */
+static constexpr size_t DICT_SIZE = 16384;
+/** Maximum number of sampled pages per index */
+static constexpr size_t DICT_SAMPLES = 128;
+/** Length of the segments that a dictionary consists of */
+static constexpr size_t DICT_SEGMENT = 64;
+/** Length of the substrings whose frequency is counted */
+static constexpr size_t DICT_DMER = 8;
+
+/** Index pages sampled for --estimate-dict */
+struct dict_sample {
+	/** number of index pages seen */
+	unsigned long long pages = 0;
+	/** reservoir sample of the page images */
+	std::vector<std::vector<byte> > sample;
+};
+
+static std::map<unsigned long long, dict_sample> dict_samples;
+static std::mt19937_64 dict_rnd;
+
+/** Sample an index page for --estimate-dict.
+@param page	uncompressed, unencrypted page that is not free */
+static void dict_sample_page(const byte* page)
+{
+	switch (fil_page_get_type(page)) {
+	case FIL_PAGE_INDEX:
+	case FIL_PAGE_TYPE_INSTANT:
+	case FIL_PAGE_RTREE:
+		break;
+	default:
+		return;
+	}
+
+	dict_sample& s = dict_samples[mach_read_from_8(
+		page + PAGE_HEADER + PAGE_INDEX_ID)];
+	const unsigned long long n = s.pages++;
+
+	if (s.sample.size() < DICT_SAMPLES) {
+		s.sample.emplace_back(page, page + physical_page_size);
+	} else {
+		const unsigned long long i =
+			std::uniform_int_distribution<unsigned long long>(
+				0, n)(dict_rnd);
+		if (i < DICT_SAMPLES) {
+			s.sample[size_t(i)].assign(page,
+						   page + physical_page_size);
+		}
+	}
+}
+
+/** Train a compression dictionary from sampled pages. Like the
+COVER algorithm of Zstandard, the sample is divided into epochs, and
+from each epoch the segment whose substrings occur in the most pages
+is picked. The most useful segments end up at the end of the
+dictionary, closest to the data that is being compressed.
+@param pages	training pages of physical_page_size bytes
+@return the dictionary */
+static std::vector<byte> dict_train(const std::vector<const byte*>& pages)
+{
+	const size_t size = physical_page_size;
+	/* number of training pages that contain each substring */
+	std::unordered_map<uint64_t, uint32_t> freq;
+	std::unordered_set<uint64_t> seen;
+
+	for (const byte* page : pages) {
+		seen.clear();
+		for (size_t i = 0; i + DICT_DMER <= size; i++) {
+			uint64_t d;
+			memcpy(&d, page + i, sizeof d);
+			if (seen.insert(d).second) {
+				freq[d]++;
+			}
+		}
+	}
+
+	std::vector<byte> dict(DICT_SIZE);
+	size_t tail = DICT_SIZE;
+	const size_t total = pages.size() * size;
+	const size_t epoch = std::max(total / (DICT_SIZE / DICT_SEGMENT),
+				      DICT_SEGMENT);
+	constexpr size_t n_dmers = DICT_SEGMENT - DICT_DMER + 1;
+	std::vector<uint32_t> f(epoch + DICT_SEGMENT);
+
+	for (size_t start = 0; start < total && tail >= DICT_SEGMENT;
+	     start += epoch) {
+		/* Look for the best segment within the current page. */
+		const byte* page = pages[start / size];
+		const size_t begin = start % size;
+		const size_t end = std::min(begin + epoch, size);
+		if (end - begin < DICT_SEGMENT) {
+			continue;
+		}
+
+		for (size_t i = begin; i + DICT_DMER <= end; i++) {
+			uint64_t d;
+			memcpy(&d, page + i, sizeof d);
+			auto it = freq.find(d);
+			f[i - begin] = it == freq.end() ? 0 : it->second;
+		}
+
+		uint64_t score = 0;
+		for (size_t i = 0; i < n_dmers; i++) {
+			score += f[i];
+		}
+
+		uint64_t best_score = score;
+		size_t best = begin;
+
+		for (size_t i = begin + 1; i + DICT_SEGMENT <= end; i++) {
+			score += f[i - begin + n_dmers - 1];
+			score -= f[i - begin - 1];
+			if (score > best_score) {
+				best_score = score;
+				best = i;
+			}
+		}
+
+		/* Skip segments whose substrings mostly occur only
+		in a single page. */
+		if (best_score <= 2 * n_dmers) {
+			continue;
+		}
+
+		tail -= DICT_SEGMENT;
+		memcpy(&dict[tail], page + best, DICT_SEGMENT);
+
+		/* Let other segments cover other substrings. */
+		for (size_t i = best; i < best + n_dmers; i++) {
+			uint64_t d;
+			memcpy(&d, page + i, sizeof d);
+			freq[d] = 0;
+		}
+	}
+
+	dict.erase(dict.begin(), dict.begin() + ptrdiff_t(tail));
+	return dict;
+}
+
+/** Compress a page with raw deflate.
+@param strm	deflate stream
+@param page	page of physical_page_size bytes
+@param dict	preset dictionary, or empty
+@param out	output buffer of deflateBound() bytes
+@param out_size	size of out
+@return compressed size in bytes */
+static size_t dict_deflate(
+	z_stream&			strm,
+	const byte*			page,
+	const std::vector<byte>&	dict,
+	byte*				out,
+	size_t				out_size)
+{
+	deflateReset(&strm);
+	if (!dict.empty()) {
+		deflateSetDictionary(&strm, dict.data(), uInt(dict.size()));
+	}
+	strm.next_in = const_cast<byte*>(page);
+	strm.avail_in = uInt(physical_page_size);
+	strm.next_out = out;
+	strm.avail_out = uInt(out_size);
+	int err = deflate(&strm, Z_FINISH);
+	ut_a(err == Z_STREAM_END);
+	return out_size - strm.avail_out;
+}
+
+/*
+ Print the estimated effect of compressing the index pages of a
+ tablespace with a dictionary that is trained for each index.
+ Half of the sampled pages of an index are used for training, and
+ the other half for measuring the compressed size.
+
+ This only estimates whether per-index dictionaries would pay off.
+ No page format uses such dictionaries, and the pages are compressed
+ with zlib raw deflate and a preset dictionary, because zlib is what
+ InnoDB links. A Zstandard or LZ4 dictionary format would need a new
+ FSP_SPACE_FLAGS bit and persistent storage for the dictionaries, and
+ its compression ratio may differ from this estimate.
+ @param [in] fil_out	stream where the output goes.
+*/
+static void print_dict_estimate(FILE* fil_out)
+{
+	z_stream strm;
+	memset(&strm, 0, sizeof strm);
+	if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15,
+			 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		fputs("Error: deflateInit2() failed\n", stderr);
+		return;
+	}
+
+	const size_t out_size = deflateBound(&strm, uLong(physical_page_size));
+	std::vector<byte> out(out_size);
+	unsigned long long total_pages = 0, total_plain = 0, total_dict = 0;
+
+	fprintf(fil_out, "\n================DICTIONARY COMPRESSION"
+		" ESTIMATE================\n");
+	fprintf(fil_out, "index_id\t#pages\t#sampled\tdict_bytes"
+		"\tdeflate_bytes_per_page\tdict_deflate_bytes_per_page"
+		"\tsavings\n");
+
+	for (const auto& it : dict_samples) {
+		const dict_sample& s = it.second;
+		if (s.sample.size() < 2) {
+			fprintf(fil_out, "%llu\t%llu\t%zu\t-\t-\t-\t-\n",
+				it.first, s.pages, s.sample.size());
+			continue;
+		}
+
+		std::vector<const byte*> train;
+		for (size_t i = 0; i < s.sample.size(); i += 2) {
+			train.push_back(s.sample[i].data());
+		}
+
+		const std::vector<byte> dict = dict_train(train);
+		const std::vector<byte> no_dict;
+		unsigned long long plain = 0, with_dict = 0, n = 0;
+
+		for (size_t i = 1; i < s.sample.size(); i += 2, n++) {
+			plain += dict_deflate(strm, s.sample[i].data(),
+					      no_dict, out.data(), out_size);
+			with_dict += dict_deflate(strm, s.sample[i].data(),
+						  dict, out.data(), out_size);
+		}
+
+		plain /= n;
+		with_dict /= n;
+		total_pages += s.pages;
+		total_plain += plain * s.pages;
+		total_dict += with_dict * s.pages;
+
+		fprintf(fil_out, "%llu\t%llu\t%zu\t%zu\t%llu\t%llu\t%.1f%%\n",
+			it.first, s.pages, s.sample.size(), dict.size(),
+			plain, with_dict,
+			plain ? 100.0 * double(plain - std::min(plain, with_dict))
+			/ double(plain) : 0.0);
+	}
+
+	deflateEnd(&strm);
+
+	fprintf(fil_out, "Estimated index page bytes: %llu uncompressed,"
+		" %llu with deflate, %llu with dictionary deflate\n",
+		total_pages * physical_page_size, total_plain, total_dict);
+	dict_samples.clear();
+}
+
 /* command line argument for innochecksum tool. */
 static struct my_option innochecksum_options[] = {
   {"help", '?', "Displays this help and exits.",
@@ -1201,6 +1450,10 @@ static struct my_option innochecksum_options[] = {
     &do_leaf, &do_leaf, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
   {"merge", 'm', "leaf page count if merge given number of consecutive pages",
    &n_merge, &n_merge, 0, GET_ULONG, REQUIRED_ARG, 0, 0, (longlong)10L, 0, 1, 0},
+  {"estimate-dict", 'z', "Estimate the size of the index pages if they "
+   "were compressed with zlib deflate and a preset dictionary trained for "
+   "each index. Only an estimate: no such page format exists.",
+   &estimate_dict, &estimate_dict, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
 
   {0, 0, 0, 0, 0, 0, GET_NO_ARG, NO_ARG, 0, 0, 0, 0, 0, 0}
 };
@@ -1227,7 +1480,8 @@ static void usage(void)
 	printf("Usage: %s [-c] [-s <start page>] [-e <end page>] "
 		"[-p <page>] [-i] [-v]  [-a <allow mismatches>] [-n] "
 		"[-S] [-D <page type dump>] "
-		"[-l <log>] [-l] [-m <merge pages>] <filename or [-]>\n", my_progname);
+		"[-l <log>] [-l] [-m <merge pages>] [-z] "
+		"<filename or [-]>\n", my_progname);
 	printf("See https://mariadb.com/kb/en/library/innochecksum/"
 	       " for usage hints.\n");
 	my_print_help(innochecksum_options);
@@ -1859,6 +2113,13 @@ int main(
 				parse_page(buf, xdes, fil_page_type, is_encrypted);
 			}
 
+			if (estimate_dict && !is_encrypted
+			    && physical_page_size == srv_page_size
+			    && !is_page_free(xdes, physical_page_size,
+					     cur_page_num)) {
+				dict_sample_page(buf);
+			}
+
 			/* do counter increase and progress printing */
 			cur_page_num++;
 
@@ -1893,6 +2154,11 @@ int main(
 				print_summary(stderr);
 			}
 		}
+
+		if (estimate_dict) {
+			print_dict_estimate(read_from_stdin
+					    ? stderr : stdout);
+		}
 	}
 
 	if (is_log_enabled) {
@@ -0,0 +1,51 @@
+/*
+   Copyright (c) 2023, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+#include "mariadb.h"
+#include "bloom_filter.h"
+
+/* The largest filter: 2^32 words of 64 bits */
+static constexpr ulonglong BLOOM_FILTER_MAX_WORDS= 0xffffffffULL;
+
+
+uint32 Bloom_filter::n_words_for(ulonglong n_elements)
+{
+  ulonglong n= (n_elements * BLOOM_FILTER_BITS_PER_ELEMENT + 63) / 64;
+  return (uint32) MY_MIN(MY_MAX(n, 1), BLOOM_FILTER_MAX_WORDS);
+}
+
+
+bool Bloom_filter::init(MEM_ROOT *mem_root, ulonglong n_elements)
+{
+  n_words= n_words_for(n_elements);
+  if (!(words= (ulonglong*) alloc_root(mem_root, n_words * sizeof(ulonglong))))
+    return true;
+  clear();
+  return false;
+}
+
+
+ulonglong Bloom_filter::hash(const uchar *str, size_t length)
+{
+  /* FNV-1a, with the bits of the result spread by mix() */
+  ulonglong nr= 0xcbf29ce484222325ULL;
+  for (const uchar *end= str + length; str < end; str++)
+  {
+    nr^= *str;
+    nr*= 0x100000001b3ULL;
+  }
+  return mix(nr);
+}
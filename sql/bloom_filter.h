@@ -0,0 +1,103 @@
+/*
+   Copyright (c) 2023, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+#ifndef BLOOM_FILTER_INCLUDED
+#define BLOOM_FILTER_INCLUDED
+
+#include "sql_alloc.h"
+
+/* Number of bits of a Bloom filter per element that it is sized for */
+#define BLOOM_FILTER_BITS_PER_ELEMENT  10
+/*
+  The expected rate of false positives of a Bloom filter that contains
+  the number of elements it is sized for
+*/
+#define BLOOM_FILTER_FALSE_POSITIVE_RATE  0.02
+
+/**
+  A Bloom filter over 64-bit hash values of elements.
+
+  The filter is blocked: the bits of an element are all in the same 64-bit
+  word, selected by the low 32 bits of its hash value, so that adding or
+  checking an element touches one word. The other 32 bits of the hash
+  value select the bits within the word.
+
+  check() never returns false for an element that was added. It returns
+  true for an element that was not added with a probability that grows
+  with the number of the added elements, about
+  BLOOM_FILTER_FALSE_POSITIVE_RATE for the number of elements the filter
+  was sized for.
+*/
+
+class Bloom_filter : public Sql_alloc
+{
+public:
+  Bloom_filter() : words(NULL), n_words(0) {}
+
+  /*
+    Allocate the filter for n_elements elements on a MEM_ROOT
+    @return true if out of memory
+  */
+  bool init(MEM_ROOT *mem_root, ulonglong n_elements);
+
+  /* @return the size of the filter for n_elements elements, in bytes */
+  static size_t size_for(ulonglong n_elements)
+  {
+    return (size_t) n_words_for(n_elements) * sizeof(ulonglong);
+  }
+
+  void add(ulonglong hash) { words[word(hash)]|= bits(hash); }
+
+  bool check(ulonglong hash) const
+  {
+    ulonglong b= bits(hash);
+    return (words[word(hash)] & b) == b;
+  }
+
+  void clear() { memset(words, 0, n_words * sizeof(ulonglong)); }
+
+  /* @return the hash value of a byte string */
+  static ulonglong hash(const uchar *str, size_t length);
+  /* @return a hash value with all bits of a weaker hash value spread */
+  static ulonglong mix(ulonglong nr)
+  {
+    nr^= nr >> 33;
+    nr*= 0xff51afd7ed558ccdULL;
+    nr^= nr >> 33;
+    nr*= 0xc4ceb9fe1a85ec53ULL;
+    nr^= nr >> 33;
+    return nr;
+  }
+
+private:
+  static uint32 n_words_for(ulonglong n_elements);
+
+  uint32 word(ulonglong hash) const
+  {
+    return (uint32) (((hash & 0xffffffff) * n_words) >> 32);
+  }
+  static ulonglong bits(ulonglong hash)
+  {
+    return (1ULL << ((hash >> 32) & 63)) | (1ULL << ((hash >> 38) & 63)) |
+           (1ULL << ((hash >> 44) & 63)) | (1ULL << ((hash >> 50) & 63)) |
+           (1ULL << ((hash >> 56) & 63));
+  }
+
+  ulonglong *words;
+  uint32 n_words;
+};
+
+#endif /* BLOOM_FILTER_INCLUDED */
@@ -207,6 +207,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   ha_rows max_rows= filesort->limit;
   uint s_length= 0, sort_len;
   Sort_keys *sort_keys;
+  ulonglong start_cycles, read_cycles= 0, merge_cycles= 0;
   DBUG_ENTER("filesort");
 
   if (!(sort_keys= filesort->make_sortorder(thd, join, first_table_bit)))
@@ -255,6 +256,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
 
   param.set_all_read_bits= filesort->set_all_read_bits;
   param.unpack= filesort->unpack;
+  param.sort_threads= (uint) thd->variables.sort_parallel_threads;
 
   sort->addon_fields=  param.addon_fields;
   sort->sort_keys= param.sort_keys;
@@ -317,10 +319,12 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
     set_if_bigger(min_sort_memory, sizeof(Merge_chunk*)*MERGEBUFF2);
     while (memory_available >= min_sort_memory)
     {
-      ulonglong keys= memory_available / (param.rec_length + sizeof(char*));
+      ulonglong keys= memory_available /
+        (param.rec_length + sort_pointer_size(param.sort_threads));
       param.max_keys_per_buffer= (uint) MY_MAX(MERGEBUFF2,
                                                MY_MIN(num_rows, keys));
-      sort->alloc_sort_buffer(param.max_keys_per_buffer, param.rec_length);
+      sort->alloc_sort_buffer(param.max_keys_per_buffer, param.rec_length,
+                              param.sort_threads > 1);
       if (sort->sort_buffer_size() > 0)
         break;
       size_t old_memory_available= memory_available;
@@ -354,6 +358,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   param.local_sortorder=
     Bounds_checked_array<SORT_FIELD>(filesort->sortorder, s_length);
 
+  start_cycles= my_timer_cycles();
   num_rows= find_all_keys(thd, &param, select,
                           sort,
                           &buffpek_pointers,
@@ -362,6 +367,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
                           &sort->found_rows);
   if (num_rows == HA_POS_ERROR)
     goto err;
+  read_cycles= my_timer_cycles() - start_cycles - param.sort_cycles;
 
   maxbuffer= (uint) (my_b_tell(&buffpek_pointers)/sizeof(*buffpek));
   tracker->report_merge_passes_at_start(thd->query_plan_fsort_passes);
@@ -415,6 +421,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
     set_if_bigger(param.max_keys_per_buffer, 1);
     maxbuffer--;				// Offset from 0
 
+    start_cycles= my_timer_cycles();
     if (merge_many_buff(&param, sort->get_raw_buf(),
                         buffpek,&maxbuffer,
 	                      &tempfile))
@@ -429,8 +436,13 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
                     &tempfile,
                     outfile))
       goto err;
+    merge_cycles= my_timer_cycles() - start_cycles;
   }
 
+  if (param.sort_threads_used)
+    tracker->report_parallel_sort(param.sort_threads_used, read_cycles,
+                                  param.sort_cycles, merge_cycles);
+
   if (num_rows > param.max_rows)
   {
     // If find_all_keys() produced more results than the query LIMIT.
@@ -1033,6 +1045,22 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
 } /* find_all_keys */
 
 
+/**
+  Sort the key pointers of the sort buffer, accounting the time and
+  the number of threads used in param.
+*/
+
+static void sort_keys_in_buffer(Sort_param *param, SORT_INFO *fs_info,
+                                uint count)
+{
+  ulonglong start= my_timer_cycles();
+  uint threads= fs_info->sort_buffer(param, count);
+  param->sort_cycles+= my_timer_cycles() - start;
+  if (threads > 1)
+    set_if_bigger(param->sort_threads_used, threads);
+}
+
+
 /**
   @details
   Sort the buffer and write:
@@ -1062,7 +1090,7 @@ write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
   Merge_chunk buffpek;
   DBUG_ENTER("write_keys");
 
-  fs_info->sort_buffer(param, count);
+  sort_keys_in_buffer(param, fs_info, count);
 
   if (!my_b_inited(tempfile) &&
       open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX, DISK_BUFFER_SIZE,
@@ -1466,7 +1494,7 @@ static bool save_index(Sort_param *param, uint count,
   DBUG_ENTER("save_index");
   DBUG_ASSERT(table_sort->record_pointers == 0);
 
-  table_sort->sort_buffer(param, count);
+  sort_keys_in_buffer(param, table_sort, count);
 
   if (param->using_addon_fields())
   {
@@ -1550,8 +1578,9 @@ static bool check_if_pq_applicable(Sort_param *param,
     DBUG_RETURN(false);
   }
 
+  const size_t pointer_size= sort_pointer_size(param->sort_threads);
   size_t num_available_keys=
-    memory_available / (param->rec_length + sizeof(char*));
+    memory_available / (param->rec_length + pointer_size);
   // We need 1 extra record in the buffer, when using PQ.
   param->max_keys_per_buffer= (uint) param->max_rows + 1;
 
@@ -1561,7 +1590,8 @@ static bool check_if_pq_applicable(Sort_param *param,
     if (param->max_rows < num_rows/PQ_slowness )
     {
       filesort_info->alloc_sort_buffer(param->max_keys_per_buffer,
-                                       param->rec_length);
+                                       param->rec_length,
+                                       param->sort_threads > 1);
       DBUG_RETURN(filesort_info->sort_buffer_size() != 0);
     }
     else
@@ -1575,7 +1605,8 @@ static bool check_if_pq_applicable(Sort_param *param,
   if (param->max_keys_per_buffer < num_available_keys)
   {
     filesort_info->alloc_sort_buffer(param->max_keys_per_buffer,
-                                     param->rec_length);
+                                     param->rec_length,
+                                     param->sort_threads > 1);
     DBUG_RETURN(filesort_info->sort_buffer_size() != 0);
   }
 
@@ -1583,7 +1614,7 @@ static bool check_if_pq_applicable(Sort_param *param,
   if (param->addon_fields)
   {
     const size_t row_length=
-      param->sort_length + param->ref_length + sizeof(char*);
+      param->sort_length + param->ref_length + pointer_size;
     num_available_keys= memory_available / row_length;
 
     // Can we fit all the keys in memory?
@@ -1613,7 +1644,8 @@ static bool check_if_pq_applicable(Sort_param *param,
         DBUG_RETURN(false);
 
       filesort_info->alloc_sort_buffer(param->max_keys_per_buffer,
-                                       param->sort_length + param->ref_length);
+                                       param->sort_length + param->ref_length,
+                                       param->sort_threads > 1);
 
       if (filesort_info->sort_buffer_size() > 0)
       {
@@ -161,8 +161,8 @@ class SORT_INFO
   ha_rows   found_rows;         /* How many rows was accepted */
 
   /** Sort filesort_buffer */
-  void sort_buffer(Sort_param *param, uint count)
-  { filesort_buffer.sort_buffer(param, count); }
+  uint sort_buffer(Sort_param *param, uint count)
+  { return filesort_buffer.sort_buffer(param, count); }
 
   uchar **get_sort_keys()
   { return filesort_buffer.get_sort_keys(); }
@@ -170,8 +170,12 @@ class SORT_INFO
   uchar *get_sorted_record(uint ix)
   { return filesort_buffer.get_sorted_record(ix); }
 
-  uchar *alloc_sort_buffer(uint num_records, uint record_length)
-  { return filesort_buffer.alloc_sort_buffer(num_records, record_length); }
+  uchar *alloc_sort_buffer(uint num_records, uint record_length,
+                           bool parallel= false)
+  {
+    return filesort_buffer.alloc_sort_buffer(num_records, record_length,
+                                             parallel);
+  }
 
   void free_sort_buffer()
   { filesort_buffer.free_sort_buffer(); }
@@ -19,6 +19,8 @@
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
+#include <tpool.h>
+#include <atomic>
 
 
 PSI_memory_key key_memory_Filesort_buffer_sort_keys;
@@ -100,14 +102,15 @@ double get_merge_many_buffs_cost_fast(ha_rows num_rows,
 */
 
 uchar *Filesort_buffer::alloc_sort_buffer(uint num_records,
-                                          uint record_length)
+                                          uint record_length, bool parallel)
 {
   size_t buff_size;
   DBUG_ENTER("alloc_sort_buffer");
   DBUG_EXECUTE_IF("alloc_sort_buffer_fail",
                   DBUG_SET("+d,simulate_out_of_memory"););
 
-  buff_size= ALIGN_SIZE(num_records * (record_length + sizeof(uchar*)));
+  m_pointer_size= uint(parallel ? 2 * sizeof(uchar*) : sizeof(uchar*));
+  buff_size= ALIGN_SIZE(num_records * (record_length + m_pointer_size));
 
   if (m_rawmem)
   {
@@ -159,18 +162,284 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+namespace {
+/** Completion of the pool tasks of one sort_tasks_execute() call */
+struct Sort_round
+{
+  mysql_mutex_t mutex;
+  mysql_cond_t cond;
+  uint pending;                         // number of unfinished pool tasks
+};
+
+
+/**
+  A piece of work of a parallel Filesort_buffer::sort_buffer():
+  either sorting one chunk of the key pointers, or merging (a part of)
+  two sorted runs into the other pointer array.
+*/
+struct Sort_task
+{
+  void (*run)(Sort_task *task);
+  const Sort_param *param;
+  uchar **a, **b;                       // input runs
+  uint na, nb;                          // number of keys in a, b
+  uchar **out;                          // output, or radixsort scratch
+};
+
+
+/** Sort one chunk of key pointers in place. */
+void sort_task_sort(Sort_task *task)
+{
+  const Sort_param *param= task->param;
+  size_t size= param->sort_length;
+
+  if (!param->using_packed_sortkeys() &&
+      radixsort_is_appliccable(task->na, param->sort_length))
+    radixsort_for_str_ptr(task->a, task->na, param->sort_length, task->out);
+  else
+    my_qsort2(task->a, task->na, sizeof(uchar*),
+              param->get_compare_function(),
+              param->get_compare_argument(&size));
+}
+
+
+/** Merge two sorted runs of key pointers into task->out. */
+void sort_task_merge(Sort_task *task)
+{
+  const Sort_param *param= task->param;
+  size_t size= param->sort_length;
+  qsort2_cmp cmp= param->get_compare_function();
+  void *arg= param->get_compare_argument(&size);
+  uchar **a= task->a, **a_end= a + task->na;
+  uchar **b= task->b, **b_end= b + task->nb;
+  uchar **out= task->out;
+
+  while (a < a_end && b < b_end)
+    *out++= cmp(arg, b, a) < 0 ? *b++ : *a++;
+  if (a < a_end)
+    memcpy(out, a, (a_end - a) * sizeof(uchar*));
+  else if (b < b_end)
+    memcpy(out, b, (b_end - b) * sizeof(uchar*));
+}
+
+
+/** @return the number of keys in the sorted run b that sort before key */
+uint sort_lower_bound(const Sort_param *param, uchar **b, uint nb, uchar **key)
+{
+  size_t size= param->sort_length;
+  qsort2_cmp cmp= param->get_compare_function();
+  void *arg= param->get_compare_argument(&size);
+  uint lo= 0, hi= nb;
+
+  while (lo < hi)
+  {
+    uint mid= lo + (hi - lo) / 2;
+    if (cmp(arg, b + mid, key) < 0)
+      lo= mid + 1;
+    else
+      hi= mid;
+  }
+  return lo;
+}
+
+
+void sort_task_run(void *arg)
+{
+  Sort_task *task= static_cast<Sort_task*>(arg);
+  task->run(task);
+}
+
+
+/**
+  A Sort_task submitted to sort_thread_pool. The pool invokes release()
+  as its last access to the task, after the task has been run.
+*/
+struct Sort_pool_task : public tpool::task
+{
+  Sort_round *round;
+
+  void release() override
+  {
+    mysql_mutex_lock(&round->mutex);
+    if (!--round->pending)
+      mysql_cond_signal(&round->cond);
+    mysql_mutex_unlock(&round->mutex);
+  }
+};
+
+
+/**
+  The worker threads of all parallel sorts. Its size is the global limit
+  of concurrently running sort helper threads; tasks of concurrent sorts
+  that exceed it are queued.
+*/
+std::atomic<tpool::thread_pool*> sort_thread_pool;
+
+void sort_thread_init() { my_thread_init(); }
+void sort_thread_end() { my_thread_end(); }
+
+tpool::thread_pool *get_sort_thread_pool()
+{
+  tpool::thread_pool *pool= sort_thread_pool.load(std::memory_order_acquire);
+  if (pool)
+    return pool;
+  pool= tpool::create_thread_pool_generic(1, std::max(2U, std::min(
+                                          my_getncpus(), MAX_SORT_THREADS)));
+  if (!pool)
+    return NULL;
+  pool->set_thread_callbacks(sort_thread_init, sort_thread_end);
+  tpool::thread_pool *old= NULL;
+  if (sort_thread_pool.compare_exchange_strong(old, pool))
+    return pool;
+  delete pool;
+  return old;
+}
+
+
+/**
+  Execute sort tasks concurrently in sort_thread_pool. The calling thread
+  executes the first task itself; if the pool cannot be created, all
+  tasks are run inline.
+*/
+void sort_tasks_execute(Sort_task *tasks, uint n_tasks)
+{
+  DBUG_ASSERT(n_tasks <= MAX_SORT_THREADS + 1);
+  tpool::thread_pool *pool= n_tasks > 1 ? get_sort_thread_pool() : NULL;
+  if (!pool)
+  {
+    for (uint i= 0; i < n_tasks; i++)
+      tasks[i].run(&tasks[i]);
+    return;
+  }
+
+  Sort_pool_task pool_tasks[MAX_SORT_THREADS + 1];
+  Sort_round round;
+  mysql_mutex_init(0, &round.mutex, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(0, &round.cond, NULL);
+  round.pending= n_tasks - 1;
+  for (uint i= 1; i < n_tasks; i++)
+  {
+    pool_tasks[i].round= &round;
+    pool_tasks[i].m_func= sort_task_run;
+    pool_tasks[i].m_arg= &tasks[i];
+    pool_tasks[i].m_group= NULL;
+    pool->submit_task(&pool_tasks[i]);
+  }
+  tasks[0].run(&tasks[0]);
+  mysql_mutex_lock(&round.mutex);
+  while (round.pending)
+    mysql_cond_wait(&round.cond, &round.mutex);
+  mysql_mutex_unlock(&round.mutex);
+  mysql_cond_destroy(&round.cond);
+  mysql_mutex_destroy(&round.mutex);
+}
+} // namespace
+
+
+void sort_thread_pool_end()
+{
+  delete sort_thread_pool.exchange(NULL);
+}
+
+
+/**
+  Sort the key pointers with several threads: every thread sorts a chunk,
+  and then the sorted chunks are merged pairwise. Each pair is split by
+  binary search into independent parts, so that all threads stay busy
+  also in the last merge rounds.
+
+  The merge rounds need a second array of count pointers. It is taken
+  from the unused space between the records and the record pointers,
+  which alloc_sort_buffer() reserved.
+
+  @return whether the keys were sorted (false if the space was not reserved)
+*/
+bool Filesort_buffer::sort_buffer_parallel(const Sort_param *param,
+                                           uint count, uint n_threads)
+{
+  if (size_t(reinterpret_cast<uchar*>(m_sort_keys) - m_next_rec_ptr) <
+      count * sizeof(uchar*))
+    return false;
+  uchar **buf= m_sort_keys - count;
+
+  Sort_task tasks[MAX_SORT_THREADS + 1];
+  uint bounds[MAX_SORT_THREADS + 1];
+  uint n_runs= n_threads;
+
+  for (uint i= 0; i <= n_runs; i++)
+    bounds[i]= uint(ulonglong{count} * i / n_runs);
+  for (uint i= 0; i < n_runs; i++)
+    tasks[i]= {sort_task_sort, param, m_sort_keys + bounds[i], NULL,
+               bounds[i + 1] - bounds[i], 0, buf + bounds[i]};
+  sort_tasks_execute(tasks, n_runs);
+
+  uchar **src= m_sort_keys, **dst= buf;
+  while (n_runs > 1)
+  {
+    const uint n_pairs= n_runs / 2;
+    const uint parts= std::max(1U, n_threads / n_pairs);
+    uint n_tasks= 0;
+
+    for (uint r= 0; r + 1 < n_runs; r+= 2)
+    {
+      uchar **a= src + bounds[r], **b= src + bounds[r + 1];
+      const uint na= bounds[r + 1] - bounds[r];
+      const uint nb= bounds[r + 2] - bounds[r + 1];
+      uint a_lo= 0, b_lo= 0;
+      for (uint j= 1; j <= parts; j++)
+      {
+        uint a_hi= na, b_hi= nb;
+        if (j < parts)
+        {
+          a_hi= uint(ulonglong{na} * j / parts);
+          b_hi= sort_lower_bound(param, b, nb, a + a_hi);
+        }
+        tasks[n_tasks++]= {sort_task_merge, param, a + a_lo, b + b_lo,
+                           a_hi - a_lo, b_hi - b_lo,
+                           dst + bounds[r] + a_lo + b_lo};
+        a_lo= a_hi;
+        b_lo= b_hi;
+      }
+    }
+    if (n_runs & 1)
+    {
+      const uint r= n_runs - 1;
+      tasks[n_tasks++]= {sort_task_merge, param, src + bounds[r], NULL,
+                         bounds[r + 1] - bounds[r], 0, dst + bounds[r]};
+    }
+    sort_tasks_execute(tasks, n_tasks);
+
+    /* Every merged pair becomes one run. */
+    for (uint r= 0; r < n_runs; r+= 2)
+      bounds[r / 2]= bounds[r];
+    n_runs= (n_runs + 1) / 2;
+    bounds[n_runs]= count;
+    std::swap(src, dst);
+  }
+
+  if (src != m_sort_keys)
+    memcpy(m_sort_keys, src, count * sizeof(uchar*));
+  return true;
+}
+
+
+uint Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
   m_sort_keys= get_sort_keys();
 
   if (count <= 1 || size == 0)
-    return;
+    return 1;
 
   // don't reverse for PQ, it is already done
   if (!param->using_pq)
     reverse_record_pointers();
 
+  uint n_threads= std::min(std::min(param->sort_threads, MAX_SORT_THREADS),
+                           count / MIN_KEYS_PER_SORT_THREAD);
+  if (n_threads > 1 && sort_buffer_parallel(param, count, n_threads))
+    return n_threads;
+
   uchar **buffer= NULL;
   if (!param->using_packed_sortkeys() &&
       radixsort_is_appliccable(count, param->sort_length) &&
@@ -179,10 +448,11 @@ void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
   {
     radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer);
     my_free(buffer);
-    return;
+    return 1;
   }
 
   my_qsort2(m_sort_keys, count, sizeof(uchar*),
             param->get_compare_function(),
             param->get_compare_argument(&size));
+  return 1;
 }
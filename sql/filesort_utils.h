@@ -43,6 +43,27 @@ double get_merge_many_buffs_cost_fast(ha_rows num_rows,
                                       ha_rows num_keys_per_buffer,
                                       uint    elem_size);
 
+/**
+  @return bytes to reserve in the sort buffer for the pointers to a record
+  @param sort_threads  @@sort_parallel_threads
+*/
+static inline size_t sort_pointer_size(uint sort_threads)
+{
+  return sort_threads > 1 ? 2 * sizeof(uchar*) : sizeof(uchar*);
+}
+
+/** Upper limit of @@sort_parallel_threads */
+static constexpr uint MAX_SORT_THREADS= 64;
+/**
+  Minimum number of keys that each thread of a parallel
+  Filesort_buffer::sort_buffer() must get. Smaller buffers are sorted
+  by the calling thread alone.
+*/
+static constexpr uint MIN_KEYS_PER_SORT_THREAD= 16384;
+
+/** Stop the worker threads of parallel sorts at server shutdown */
+void sort_thread_pool_end();
+
 
 /**
   A wrapper class around the buffer used by filesort().
@@ -58,6 +79,11 @@ double get_merge_many_buffs_cost_fast(ha_rows num_rows,
   Record pointers will be inserted "right-to-left", as a side-effect
   of inserting the actual records.
 
+  For a parallel sort, one more pointer is reserved for each record.
+  The merge rounds use the unused space below the record pointers as
+  the second array of pointers, so that no memory beyond
+  sort_buffer_size is needed.
+
   We wrap the buffer in order to be able to do lazy initialization of the
   pointers: the buffer is often much larger than what we actually need.
 
@@ -77,12 +103,15 @@ class Filesort_buffer
     m_next_rec_ptr(NULL), m_rawmem(NULL), m_record_pointers(NULL),
     m_sort_keys(NULL),
     m_num_records(0), m_record_length(0),
-    m_sort_length(0),
+    m_sort_length(0), m_pointer_size(sizeof(uchar*)),
     m_size_in_bytes(0), m_idx(0)
   {}
 
-  /** Sort me... */
-  void sort_buffer(const Sort_param *param, uint count);
+  /**
+    Sort me...
+    @return number of threads that were used for sorting
+  */
+  uint sort_buffer(const Sort_param *param, uint count);
 
   /**
     Reverses the record pointer array, to avoid recording new results for
@@ -139,7 +168,7 @@ class Filesort_buffer
     DBUG_ASSERT(m_next_rec_ptr >= m_rawmem);
     const size_t spaceused=
       (m_next_rec_ptr - m_rawmem) +
-      (static_cast<size_t>(m_idx) * sizeof(uchar*));
+      (static_cast<size_t>(m_idx) * m_pointer_size);
     return m_size_in_bytes - spaceused;
   }
 
@@ -150,7 +179,7 @@ class Filesort_buffer
   {
     if (m_idx < m_num_records)
       return false;
-    return spaceleft() < (m_record_length + sizeof(uchar*));
+    return spaceleft() < (m_record_length + m_pointer_size);
   }
 
   /**
@@ -195,9 +224,12 @@ class Filesort_buffer
 
     @param num_records   Number of records.
     @param record_length (maximum) size of each record.
+    @param parallel      Whether to reserve space for a parallel sort_buffer()
+                         (2 pointers per record instead of 1)
     @returns Pointer to allocated area, or NULL in case of out-of-memory.
   */
-  uchar *alloc_sort_buffer(uint num_records, uint record_length);
+  uchar *alloc_sort_buffer(uint num_records, uint record_length,
+                           bool parallel= false);
 
   /// Frees the buffer.
   void free_sort_buffer();
@@ -248,6 +280,9 @@ class Filesort_buffer
   void set_sort_length(uint val) { m_sort_length= val; }
 
 private:
+  bool sort_buffer_parallel(const Sort_param *param, uint count,
+                            uint n_threads);
+
   uchar  *m_next_rec_ptr;    /// The next record will be inserted here.
   uchar  *m_rawmem;          /// The raw memory buffer.
   uchar **m_record_pointers; /// The "right-to-left" array of record pointers.
@@ -255,6 +290,7 @@ class Filesort_buffer
   uint    m_num_records;     /// Saved value from alloc_sort_buffer()
   uint    m_record_length;   /// Saved value from alloc_sort_buffer()
   uint    m_sort_length;     /// The length of the sort key.
+  uint    m_pointer_size;    /// Bytes reserved for pointers per record
   size_t  m_size_in_bytes;   /// Size of raw buffer, in bytes.
 
   /**
@@ -0,0 +1,146 @@
+/*
+   Copyright (c) 2023, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "key.h"                                // key_hashnr
+#include "group_by_hash.h"
+
+/** Number of slots allocated at first */
+static constexpr uint32 GROUP_BY_HASH_MIN_SLOTS= 1024;
+
+
+Group_by_hash::~Group_by_hash()
+{
+  my_free(slots);
+  my_free(entries);
+}
+
+
+uint32 Group_by_hash::hash_key(const uchar *key) const
+{
+  /*
+    key_hashnr() mixes the key bytes mostly into the high bits.
+    Spread them also to the low bits that select the slot.
+  */
+  uint32 h= (uint32) key_hashnr(key_info, key_info->user_defined_key_parts,
+                                key);
+  h^= h >> 16;
+  h*= 0x85ebca6b;
+  h^= h >> 13;
+  h*= 0xc2b2ae35;
+  h^= h >> 16;
+  return h;
+}
+
+
+uchar *Group_by_hash::find(const uchar *key, uint32 hash) const
+{
+  if (!slots)
+    return NULL;
+  for (uint32 i= hash & slot_mask;; i= (i + 1) & slot_mask)
+  {
+    const Slot &slot= slots[i];
+    if (!slot.entry)
+      return NULL;
+    if (slot.hash == hash)
+    {
+      uchar *e= entry(slot.entry - 1);
+      if (!key_buf_cmp(key_info, key_info->user_defined_key_parts, key, e))
+        return e + key_length;
+    }
+  }
+}
+
+
+bool Group_by_hash::grow_slots()
+{
+  const uint32 n_slots= slots ? (slot_mask + 1) * 2 : GROUP_BY_HASH_MIN_SLOTS;
+  if (n_slots * sizeof(Slot) +
+      size_t{max_entries} * (key_length + rec_length) > max_memory)
+    return true;
+  Slot *new_slots= (Slot*) my_malloc(PSI_INSTRUMENT_ME, n_slots * sizeof(Slot),
+                                     MYF(MY_THREAD_SPECIFIC | MY_ZEROFILL));
+  if (!new_slots)
+    return true;
+
+  const uint32 new_mask= n_slots - 1;
+  if (slots)
+  {
+    for (uint32 i= 0; i <= slot_mask; i++)
+    {
+      if (!slots[i].entry)
+        continue;
+      uint32 j= slots[i].hash & new_mask;
+      while (new_slots[j].entry)
+        j= (j + 1) & new_mask;
+      new_slots[j]= slots[i];
+    }
+    my_free(slots);
+  }
+  slots= new_slots;
+  slot_mask= new_mask;
+  return false;
+}
+
+
+bool Group_by_hash::grow_entries()
+{
+  const uint32 n= max_entries ? max_entries * 2 : GROUP_BY_HASH_MIN_SLOTS / 2;
+  const size_t entry_length= key_length + rec_length;
+  if ((slot_mask + 1) * sizeof(Slot) + size_t{n} * entry_length > max_memory)
+    return true;
+  uchar *new_entries= (uchar*) my_realloc(PSI_INSTRUMENT_ME, entries,
+                                          size_t{n} * entry_length,
+                                          MYF(MY_THREAD_SPECIFIC |
+                                              MY_ALLOW_ZERO_PTR));
+  if (!new_entries)
+    return true;
+  entries= new_entries;
+  max_entries= n;
+  return false;
+}
+
+
+uchar *Group_by_hash::insert(const uchar *key, uint32 hash)
+{
+  DBUG_ASSERT(!find(key, hash));
+  /* Keep the load factor at most 1/2, so that probe sequences stay short */
+  if ((!slots || 2 * (n_entries + 1) > slot_mask + 1) && grow_slots())
+    return NULL;
+  if (n_entries == max_entries && grow_entries())
+    return NULL;
+
+  uchar *e= entry(n_entries);
+  memcpy(e, key, key_length);
+
+  uint32 i= hash & slot_mask;
+  while (slots[i].entry)
+    i= (i + 1) & slot_mask;
+  slots[i].hash= hash;
+  slots[i].entry= ++n_entries;
+  return e + key_length;
+}
+
+
+void Group_by_hash::clear()
+{
+  if (n_entries)
+  {
+    memset(slots, 0, (slot_mask + 1) * sizeof(Slot));
+    n_entries= 0;
+  }
+}
@@ -0,0 +1,104 @@
+/*
+   Copyright (c) 2023, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+#ifndef GROUP_BY_HASH_INCLUDED
+#define GROUP_BY_HASH_INCLUDED
+
+#include "structs.h"                            // KEY
+
+/**
+  An in-memory hash table of the groups of a GROUP BY, used by end_update()
+  instead of looking up and updating every group in the temporary table.
+
+  Every group is stored as an entry with the group key image
+  (TMP_TABLE_PARAM::group_buff) followed by the temporary table record
+  that accumulates the aggregate values. The entries are stored
+  contiguously in insertion order, and are written to the temporary table
+  at the end of the aggregation, or when the hash table has reached its
+  memory limit, after which the aggregation continues in the temporary
+  table.
+
+  The entries are looked up in an open addressing table with linear
+  probing. Each slot holds a 32-bit hash value and the number of an entry,
+  so that a probe sequence touches a few adjacent slots and compares keys
+  only on a hash match. Growing the table rehashes the slots from the
+  stored hash values, without touching the entries.
+
+  Keys are hashed and compared with key_hashnr() and key_buf_cmp(), which
+  follow the collations of the key parts like the index of the temporary
+  table does.
+*/
+
+class Group_by_hash
+{
+public:
+  Group_by_hash(KEY *key_info, uint key_length, uint rec_length,
+                size_t max_memory) :
+    key_info(key_info), key_length(key_length), rec_length(rec_length),
+    max_memory(max_memory), slots(NULL), slot_mask(0), entries(NULL),
+    n_entries(0), max_entries(0)
+  {}
+  ~Group_by_hash();
+
+  /** @return the hash value of a group key image */
+  uint32 hash_key(const uchar *key) const;
+
+  /**
+    Look up a group.
+    @return the record of the group, or NULL if it was not found
+  */
+  uchar *find(const uchar *key, uint32 hash) const;
+
+  /**
+    Add a group that find() did not find.
+    @return the record of the group, to be filled in by the caller before
+            the next insert(); NULL if the hash table would exceed
+            max_memory or out of memory
+  */
+  uchar *insert(const uchar *key, uint32 hash);
+
+  /** @return the number of groups */
+  uint32 elements() const { return n_entries; }
+  /** @return the record of the n-th group in insertion order */
+  uchar *record(uint32 n) const { return entry(n) + key_length; }
+
+  /** Forget all groups, keeping the allocated memory */
+  void clear();
+
+private:
+  struct Slot
+  {
+    uint32 hash;
+    /* 1 + the number of the entry, or 0 for an empty slot */
+    uint32 entry;
+  };
+
+  bool grow_slots();
+  bool grow_entries();
+  uchar *entry(uint32 n) const
+  { return entries + size_t{n} * (key_length + rec_length); }
+
+  KEY *const key_info;
+  const uint key_length, rec_length;
+  const size_t max_memory;
+
+  Slot *slots;
+  uint32 slot_mask;                     // number of slots - 1
+  uchar *entries;
+  uint32 n_entries, max_entries;
+};
+
+#endif /* GROUP_BY_HASH_INCLUDED */
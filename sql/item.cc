@@ -575,6 +575,23 @@ bool Item::cleanup_processor(void *arg)
 }
 
 
+void Item::val_bool_batch(TABLE *table, const uchar *const *records,
+                          uint *sel, uint *n_sel)
+{
+  uint n= 0;
+  for (uint i= 0; i < *n_sel; i++)
+  {
+    const uchar *record= records[sel[i]];
+    table->move_fields(table->field, record, table->record[0]);
+    const bool value= val_bool();
+    table->move_fields(table->field, table->record[0], record);
+    sel[n]= sel[i];
+    n+= value;
+  }
+  *n_sel= n;
+}
+
+
 /**
   Traverse item tree possibly transforming it (replacing items).
 
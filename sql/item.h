@@ -118,6 +118,7 @@ struct KEY_FIELD;
 struct SARGABLE_PARAM;
 class RANGE_OPT_PARAM;
 class SEL_TREE;
+class Record_filter;
 
 enum precedence {
   LOWEST_PRECEDENCE,
@@ -2394,6 +2395,25 @@ class Item :public Value_source,
   */
   virtual bool find_not_null_fields(table_map allowed) { return false; }
 
+  /*
+    Add this item, a conjunct of a condition attached to a join table, to
+    a filter that evaluates it directly on the record buffer.
+    Return TRUE if the item cannot be evaluated by the filter.
+  */
+  virtual bool add_to_record_filter(Record_filter *filter) { return true; }
+
+  /*
+    Evaluate this item as a condition on a batch of records of a table.
+    records[] are full records of the table in the format of record[0];
+    sel[0..*n_sel-1] are the positions in records[] of the records to
+    evaluate. The positions of the records for which the condition is not
+    true are removed from sel[], which stays in ascending order.
+    The default implementation calls val_bool() for every record with the
+    fields of the table moved to it.
+  */
+  virtual void val_bool_batch(TABLE *table, const uchar *const *records,
+                              uint *sel, uint *n_sel);
+
   /*
     Does not guarantee deep copy (depends on copy ctor).
     See build_clone() for deep copy.
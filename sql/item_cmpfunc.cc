@@ -36,6 +36,7 @@
 #define PCRE2_STATIC 1             /* Important on Windows */
 #include "pcre2.h"                 /* pcre2 header file */
 #include "my_json_writer.h"
+#include "record_filter.h"
 
 /*
   Compare row signature of two expressions
@@ -462,6 +463,52 @@ bool Item_bool_rowready_func2::fix_length_and_dec(THD *thd)
 }
 
 
+/**
+  Check if a constant can be compiled into a Record_filter predicate
+  that compares a column as cmp_type: a literal or a parameter of a
+  numeric type, whose value does not need a conversion that could
+  produce a warning for every record.
+*/
+
+static bool is_record_filter_constant(Item *item, Item_result cmp_type)
+{
+  if (!item->basic_const_item())
+    return false;
+  Item_result type= item->cmp_type();
+  return type == INT_RESULT ||
+         (cmp_type == REAL_RESULT &&
+          (type == REAL_RESULT || type == DECIMAL_RESULT));
+}
+
+
+bool Item_bool_rowready_func2::add_to_record_filter(Record_filter *filter)
+{
+  Item_result cmp_type;
+  if (cmp.func == &Arg_comparator::compare_int_signed ||
+      cmp.func == &Arg_comparator::compare_int_unsigned ||
+      cmp.func == &Arg_comparator::compare_int_signed_unsigned ||
+      cmp.func == &Arg_comparator::compare_int_unsigned_signed)
+    cmp_type= INT_RESULT;
+  else if (cmp.func == &Arg_comparator::compare_real)
+    cmp_type= REAL_RESULT;                      // Not compare_real_fixed()
+  else
+    return true;
+
+  Item *field= *cmp.a, *value= *cmp.b;
+  Functype op= functype();
+  if (field->type() != FIELD_ITEM)
+  {
+    std::swap(field, value);
+    op= rev_functype();
+  }
+  if (field->type() != FIELD_ITEM ||
+      !is_record_filter_constant(value, cmp_type))
+    return true;
+  return filter->add_comparison(((Item_field*) field)->field, op, value,
+                                cmp_type);
+}
+
+
 /**
   Prepare the comparator (set the comparison function) for comparing
   items *a1 and *a2 in the context of 'type'.
@@ -2095,6 +2142,19 @@ bool Item_func_between::find_not_null_fields(table_map allowed)
 }
 
 
+bool Item_func_between::add_to_record_filter(Record_filter *filter)
+{
+  Item_result cmp_type= m_comparator.cmp_type();
+  if ((cmp_type != INT_RESULT && cmp_type != REAL_RESULT) ||
+      args[0]->type() != FIELD_ITEM ||
+      !is_record_filter_constant(args[1], cmp_type) ||
+      !is_record_filter_constant(args[2], cmp_type))
+    return true;
+  return filter->add_between(((Item_field*) args[0])->field,
+                             args[1], args[2], negated, cmp_type);
+}
+
+
 bool Item_func_between::count_sargable_conds(void *arg)
 {
   SELECT_LEX *sel= (SELECT_LEX *) arg;
@@ -3647,12 +3707,71 @@ static int cmp_decimal(void *cmp_arg, my_decimal *a, my_decimal *b)
 }
 
 
+/*
+  The number of values from which find() looks them up in a hash index.
+  A binary search over fewer values takes only a few comparisons.
+*/
+static constexpr uint IN_VECTOR_HASH_MIN_VALUES= 64;
+
+
+/* Spread the bits of a 64-bit value over a 32-bit hash value */
+static inline uint32 hash_int8(ulonglong nr)
+{
+  nr^= nr >> 33;
+  nr*= 0xff51afd7ed558ccdULL;
+  nr^= nr >> 33;
+  nr*= 0xc4ceb9fe1a85ec53ULL;
+  nr^= nr >> 33;
+  return (uint32) nr;
+}
+
+
+void in_vector::create_hash_index(THD *thd)
+{
+  hash_index= NULL;
+  if (used_count < IN_VECTOR_HASH_MIN_VALUES || !is_hashable())
+    return;
+
+  /* Keep the load factor at most 1/2, so that probe sequences stay short */
+  uint32 n_slots= 1;
+  while (n_slots < 2 * used_count)
+    n_slots*= 2;
+  Hash_slot *slots= (Hash_slot*) thd->calloc(n_slots * sizeof(Hash_slot));
+  if (!slots)
+    return;                                     // Use the binary search
+
+  hash_mask= n_slots - 1;
+  for (uint pos= 0; pos < used_count; pos++)
+  {
+    uint32 nr= hash((const uchar*) base + pos * size);
+    uint32 i= nr & hash_mask;
+    while (slots[i].pos)
+      i= (i + 1) & hash_mask;
+    slots[i].hash= nr;
+    slots[i].pos= pos + 1;
+  }
+  hash_index= slots;
+}
+
+
 bool in_vector::find(Item *item)
 {
   uchar *result=get_value(item);
   if (!result || !used_count)
     return false;				// Null value
 
+  if (hash_index)
+  {
+    uint32 nr= hash(result);
+    for (uint32 i= nr & hash_mask; hash_index[i].pos; i= (i + 1) & hash_mask)
+    {
+      if (hash_index[i].hash == nr &&
+          !(*compare)(collation, base + (hash_index[i].pos - 1) * size, result))
+        return true;
+    }
+    return false;
+  }
+
   uint start,end;
   start=0; end=used_count-1;
   while (start != end)
@@ -3713,6 +3832,15 @@ uchar *in_string::get_value(Item *item)
   return (uchar*) item->val_str(&tmp);
 }
 
+uint32 in_string::hash(const uchar *value) const
+{
+  /* hash_sort() is consistent with strnncollsp() used by the comparison */
+  const String *str= (const String*) value;
+  Hasher hasher;
+  hasher.add(collation, str->ptr(), str->length());
+  return hash_int8(hasher.finalize());
+}
+
 Item *in_string::create_item(THD *thd)
 {
   return new (thd->mem_root) Item_string_for_in_vector(thd, collation);
@@ -3776,6 +3904,15 @@ uchar *in_longlong::get_value(Item *item)
   return (uchar*) &tmp;
 }
 
+uint32 in_longlong::hash(const uchar *value) const
+{
+  /*
+    cmp_longlong() finds a signed and an unsigned value equal only if they
+    have the same bits, so the signedness is not hashed.
+  */
+  return hash_int8((ulonglong) ((const packed_longlong*) value)->val);
+}
+
 Item *in_longlong::create_item(THD *thd)
 { 
   /* 
@@ -3890,6 +4027,16 @@ uchar *in_double::get_value(Item *item)
   return (uchar*) &tmp;
 }
 
+uint32 in_double::hash(const uchar *value) const
+{
+  double nr= *(const double*) value;
+  ulonglong bits;
+  if (nr == 0.0)
+    nr= 0.0;                                    // -0.0 is equal to 0.0
+  memcpy(&bits, &nr, sizeof(bits));
+  return hash_int8(bits);
+}
+
 Item *in_double::create_item(THD *thd)
 { 
   return new (thd->mem_root) Item_float(thd, 0.0, 0);
@@ -4422,6 +4569,22 @@ Item_func_in::find_not_null_fields(table_map allowed)
 }
 
 
+bool Item_func_in::add_to_record_filter(Record_filter *filter)
+{
+  Item_result cmp_type= m_comparator.cmp_type();
+  if ((cmp_type != INT_RESULT && cmp_type != REAL_RESULT) ||
+      args[0]->type() != FIELD_ITEM)
+    return true;
+  for (uint i= 1; i < arg_count; i++)
+  {
+    if (!is_record_filter_constant(args[i], cmp_type))
+      return true;
+  }
+  return filter->add_in(((Item_field*) args[0])->field, args + 1,
+                        arg_count - 1, negated, cmp_type);
+}
+
+
 void Item_func_in::fix_after_pullout(st_select_lex *new_parent, Item **ref,
                                      bool merge)
 {
@@ -4489,14 +4652,15 @@ bool Item_func_in::fix_length_and_dec(THD *thd)
 
 
 /**
-  Populate Item_func_in::array with constant not-NULL arguments and sort them.
+  Populate Item_func_in::array with constant not-NULL arguments, sort them
+  and create their hash index.
 
   Sets "have_null" to true if some of the values appeared to be NULL.
   Note, explicit NULLs were found during prepare_predicant_and_values().
   So "have_null" can already be true before the fix_in_vector() call.
   Here we additionally catch implicit NULLs.
 */
-void Item_func_in::fix_in_vector()
+void Item_func_in::fix_in_vector(THD *thd)
 {
   DBUG_ASSERT(array);
   uint j=0;
@@ -4515,7 +4679,10 @@ void Item_func_in::fix_in_vector()
     }
   }
   if ((array->used_count= j))
+  {
     array->sort();
+    array->create_hash_index(thd);
+  }
 }
 
 
@@ -4655,7 +4822,7 @@ bool Item_func_in::fix_for_row_comparison_using_bisection(THD *thd)
   cmp_item_row *cmp= &((in_row*)array)->tmp;
   if (cmp->prepare_comparators(thd, func_name_cstring(), this, 0))
     return true;
-  fix_in_vector();
+  fix_in_vector(thd);
   return false;
 }
 
@@ -5527,6 +5694,23 @@ longlong Item_cond_and::val_int()
 }
 
 
+/*
+  Evaluate the conjuncts one after another on the records that are still
+  selected, so that a conjunct is not evaluated for a record after one
+  that is not true, like in val_int().
+*/
+
+void Item_cond_and::val_bool_batch(TABLE *table, const uchar *const *records,
+                                   uint *sel, uint *n_sel)
+{
+  DBUG_ASSERT(fixed());
+  List_iterator_fast<Item> li(list);
+  Item *item;
+  while (*n_sel && (item= li++))
+    item->val_bool_batch(table, records, sel, n_sel);
+}
+
+
 longlong Item_cond_or::val_int()
 {
   DBUG_ASSERT(fixed());
@@ -573,6 +573,7 @@ class Item_bool_rowready_func2 :public Item_bool_func2_with_rev
     return cmp.compare_type_handler();
   }
   Arg_comparator *get_comparator() { return &cmp; }
+  bool add_to_record_filter(Record_filter *filter) override;
   void cleanup() override
   {
     Item_bool_func2::cleanup();
@@ -1002,6 +1003,7 @@ class Item_func_between :public Item_func_opt_neg
   void print(String *str, enum_query_type query_type) override;
   bool eval_not_null_tables(void *opt_arg) override;
   bool find_not_null_fields(table_map allowed) override;
+  bool add_to_record_filter(Record_filter *filter) override;
   void fix_after_pullout(st_select_lex *new_parent, Item **ref, bool merge)
     override;
   bool count_sargable_conds(void *arg) override;
@@ -1455,6 +1457,19 @@ class in_vector :public Sql_alloc
     :base((char*) thd_calloc(thd, elements * element_length)),
      size(element_length), compare(cmp_func), collation(cmp_coll),
      count(elements), used_count(elements) {}
+  /*
+    Hash index of the values, used by find() instead of the binary search
+    for long lists of values of a type that implements hash(). The values
+    stay sorted in base, as the range optimizer enumerates them in order.
+  */
+  struct Hash_slot
+  {
+    uint32 hash;
+    uint32 pos;                 // 1 + the position of the value, 0 if empty
+  };
+  Hash_slot *hash_index= NULL;
+  uint32 hash_mask= 0;          // number of slots - 1
+
   virtual ~in_vector() = default;
   virtual void set(uint pos,Item *item)=0;
   virtual uchar *get_value(Item *item)=0;
@@ -1463,6 +1478,22 @@ class in_vector :public Sql_alloc
     my_qsort2(base,used_count,size,compare,(void*)collation);
   }
   bool find(Item *item);
+  /*
+    Create the hash index of the values, if there are enough of them for
+    the hash lookup to be faster than the binary search.
+  */
+  void create_hash_index(THD *thd);
+
+  /*
+    Return true if hash() is implemented. Values that compare as equal
+    must have the same hash value.
+  */
+  virtual bool is_hashable() const { return false; }
+  virtual uint32 hash(const uchar *value) const
+  {
+    DBUG_ASSERT(0);
+    return 0;
+  }
   
   /* 
     Create an instance of Item_{type} (e.g. Item_decimal) constant object
@@ -1522,6 +1553,8 @@ class in_string :public in_vector
   }
   const Type_handler *type_handler() const override
   { return &type_handler_varchar; }
+  bool is_hashable() const override { return true; }
+  uint32 hash(const uchar *value) const override;
 };
 
 class in_longlong :public in_vector
@@ -1550,6 +1583,8 @@ class in_longlong :public in_vector
   }
   const Type_handler *type_handler() const override
   { return &type_handler_slonglong; }
+  bool is_hashable() const override { return true; }
+  uint32 hash(const uchar *value) const override;
 
   friend int cmp_longlong(void *cmp_arg, packed_longlong *a,packed_longlong *b);
 };
@@ -1630,6 +1665,8 @@ class in_double :public in_vector
   }
   const Type_handler *type_handler() const override
   { return &type_handler_double; }
+  bool is_hashable() const override { return true; }
+  uint32 hash(const uchar *value) const override;
 };
 
 
@@ -2537,14 +2574,14 @@ class Item_func_in :public Item_func_opt_neg,
   {
     return agg_arg_charsets_for_comparison(cmp_collation, args, arg_count);
   }
-  void fix_in_vector();
+  void fix_in_vector(THD *thd);
   bool value_list_convert_const_to_int(THD *thd);
   bool fix_for_scalar_comparison_using_bisection(THD *thd)
   {
     array= m_comparator.type_handler()->make_in_vector(thd, this, arg_count - 1);
     if (!array)      // OOM
       return true;
-    fix_in_vector();
+    fix_in_vector(thd);
     return false;
   }
   bool fix_for_scalar_comparison_using_cmp_items(THD *thd, uint found_types);
@@ -2601,6 +2638,7 @@ class Item_func_in :public Item_func_opt_neg,
   enum precedence precedence() const override { return IN_PRECEDENCE; }
   bool eval_not_null_tables(void *opt_arg) override;
   bool find_not_null_fields(table_map allowed) override;
+  bool add_to_record_filter(Record_filter *filter) override;
   void fix_after_pullout(st_select_lex *new_parent, Item **ref, bool merge)
     override;
   bool count_sargable_conds(void *arg) override;
@@ -3549,6 +3587,8 @@ class Item_cond_and final :public Item_cond
   Item_cond_and(THD *thd, List<Item> &list_arg): Item_cond(thd, list_arg) {}
   enum Functype functype() const override { return COND_AND_FUNC; }
   longlong val_int() override;
+  void val_bool_batch(TABLE *table, const uchar *const *records,
+                      uint *sel, uint *n_sel) override;
   LEX_CSTRING func_name_cstring() const override
   {
     static LEX_CSTRING name= {STRING_WITH_LEN("and") };
@@ -52,6 +52,7 @@
 #include "sql_expression_cache.h" // subquery_cache_miss, subquery_cache_hit
 #include "sys_vars_shared.h"
 #include "ddl_log.h"
+#include "filesort_utils.h" // sort_thread_pool_end
 
 #include <m_ctype.h>
 #include <my_dir.h>
@@ -2008,6 +2009,7 @@ static void clean_up(bool print_message)
   wt_end();
   multi_keycache_free();
   sp_cache_end();
+  sort_thread_pool_end();
   free_status_vars();
   end_thr_alarm(1);			/* Free allocated memory */
   end_thr_timer();
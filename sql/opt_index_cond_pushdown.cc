@@ -348,6 +348,34 @@ void push_index_cond(JOIN_TAB *tab, uint keyno)
     idx_cond= make_cond_for_index(tab->join->thd, tab->select_cond, tab->table,
                                   keyno, tab->icp_other_tables_ok);
 
+    /*
+      Check the Bloom filter of the BNLH join cache first in the index
+      condition if the join key is covered by the index
+    */
+    if (tab->join_filter &&
+        uses_index_fields_only(tab->join_filter, tab->table, keyno, FALSE))
+    {
+      if (idx_cond)
+      {
+        Item_cond_and *new_cond= new (tab->join->thd->mem_root)
+          Item_cond_and(tab->join->thd, tab->join_filter, idx_cond);
+        if (new_cond)
+        {
+          new_cond->quick_fix_field();
+          new_cond->used_tables_cache= tab->join_filter->used_tables() |
+                                       idx_cond->used_tables();
+          new_cond->top_level_item();
+          idx_cond= new_cond;
+          tab->join_filter= 0;
+        }
+      }
+      else
+      {
+        idx_cond= tab->join_filter;
+        tab->join_filter= 0;
+      }
+    }
+
     DBUG_EXECUTE("where",
                  print_where(idx_cond, "idx cond", QT_ORDINARY););
 
@@ -399,7 +427,8 @@ void push_index_cond(JOIN_TAB *tab, uint keyno)
       if (idx_remainder_cond != idx_cond)
         tab->ref.disable_cache= TRUE;
 
-      Item *row_cond= tab->idx_cond_fact_out ? 
+      /* There may be no condition if only the join filter was pushed */
+      Item *row_cond= tab->idx_cond_fact_out && tab->select_cond ? 
                         make_cond_remainder(tab->join->thd, tab->select_cond,
                                             tab->table, keyno,
 			                    tab->icp_other_tables_ok, TRUE) :
@@ -346,7 +346,13 @@ int opt_sum_query(THD *thd,
             !outer_tables && maybe_exact_count &&
             ((item->used_tables() & OUTER_REF_TABLE_BIT) == 0))
         {
-          if (!is_exact_count)
+          /*
+            EXPLAIN only shows that COUNT(*) is replaced with a constant:
+            do not let the engines count the rows, which can be as
+            expensive as a table scan.
+          */
+          if (!is_exact_count && !(thd->lex->describe &&
+                                   !thd->lex->analyze_stmt))
           {
             if ((count= get_exact_record_count(tables)) == ULONGLONG_MAX)
             {
@@ -0,0 +1,555 @@
+/*
+   Copyright (c) 2023, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "sql_class.h"
+#include "item_cmpfunc.h"                       // Item_cond
+#include "record_filter.h"
+#include <algorithm>
+
+namespace {
+
+/**
+  The values that a column can be compared with: BIGINT, BIGINT UNSIGNED
+  or DOUBLE. The values of all integer columns except BIGINT UNSIGNED are
+  in the BIGINT domain.
+*/
+template <typename T> struct Filter_domain;
+
+template <> struct Filter_domain<longlong>
+{
+  static longlong min() { return LONGLONG_MIN; }
+  static longlong max() { return LONGLONG_MAX; }
+  static longlong next(longlong value) { return value + 1; }
+  static longlong prev(longlong value) { return value - 1; }
+  /**
+    Get the value of a constant.
+    @param[out] pos  -1 if the value is below the domain, 1 if above it
+    @return true if the value is NULL
+  */
+  static bool get(Item *item, longlong *value, int *pos)
+  {
+    *value= item->val_int();
+    *pos= item->unsigned_flag && *value < 0 ? 1 : 0;
+    return item->null_value;
+  }
+};
+
+template <> struct Filter_domain<ulonglong>
+{
+  static ulonglong min() { return 0; }
+  static ulonglong max() { return ULONGLONG_MAX; }
+  static ulonglong next(ulonglong value) { return value + 1; }
+  static ulonglong prev(ulonglong value) { return value - 1; }
+  static bool get(Item *item, ulonglong *value, int *pos)
+  {
+    longlong v= item->val_int();
+    *value= (ulonglong) v;
+    *pos= !item->unsigned_flag && v < 0 ? -1 : 0;
+    return item->null_value;
+  }
+};
+
+template <> struct Filter_domain<double>
+{
+  static double min() { return -HUGE_VAL; }
+  static double max() { return HUGE_VAL; }
+  static double next(double value) { return std::nextafter(value, HUGE_VAL); }
+  static double prev(double value) { return std::nextafter(value, -HUGE_VAL); }
+  static bool get(Item *item, double *value, int *pos)
+  {
+    *value= item->val_real();
+    *pos= 0;
+    return item->null_value;
+  }
+};
+
+
+template <typename T> void set_empty_range(T *range)
+{
+  range[0]= Filter_domain<T>::max();
+  range[1]= Filter_domain<T>::min();
+}
+
+
+/**
+  Compute the range of the values of the domain that are within the bounds.
+
+  @param min  the lower bound, or NULL if there is none
+  @param max  the upper bound, or NULL if there is none
+  @param[out] range  the range [range[0], range[1]]
+
+  @return true if a bound is NULL; the range is empty then
+*/
+
+template <typename T>
+bool domain_range(Item *min, bool min_open, Item *max, bool max_open,
+                  T *range)
+{
+  typedef Filter_domain<T> D;
+  T value;
+  int pos;
+  bool null= false, empty= false;
+
+  range[0]= D::min();
+  range[1]= D::max();
+  if (min)
+  {
+    if (D::get(min, &value, &pos))
+      null= true;
+    else if (pos > 0 || (!pos && min_open && value == D::max()))
+      empty= true;
+    else if (!pos)
+      range[0]= min_open ? D::next(value) : value;
+  }
+  if (max && !null)
+  {
+    if (D::get(max, &value, &pos))
+      null= true;
+    else if (pos < 0 || (!pos && max_open && value == D::min()))
+      empty= true;
+    else if (!pos)
+      range[1]= max_open ? D::prev(value) : value;
+  }
+  if (null || empty)
+    set_empty_range(range);
+  return null;
+}
+
+
+/**
+  Collect the distinct values of the domain from a list of constants.
+
+  @return -1 if out of memory, 1 if one of the constants is NULL, else 0
+*/
+
+template <typename T>
+int domain_set(MEM_ROOT *mem_root, Item **args, uint n_args,
+               T **values, uint *n_values)
+{
+  T *set= (T*) alloc_root(mem_root, n_args * sizeof(T));
+  if (!set)
+    return -1;
+  uint n= 0;
+  int null= 0;
+  for (uint i= 0; i < n_args; i++)
+  {
+    T value;
+    int pos;
+    if (Filter_domain<T>::get(args[i], &value, &pos))
+      null= 1;
+    else if (!pos)                              // never equal otherwise
+      set[n++]= value;
+  }
+  std::sort(set, set + n);
+  *n_values= (uint) (std::unique(set, set + n) - set);
+  *values= set;
+  return null;
+}
+
+} // namespace
+
+
+template <typename T>
+inline bool Record_filter::Predicate::match(T value, const T *min_max,
+                                            const T *set) const
+{
+  bool found= n_values ? std::binary_search(set, set + n_values, value)
+                       : min_max[0] <= value && value <= min_max[1];
+  return found != negated;
+}
+
+
+inline bool Record_filter::Predicate::check() const
+{
+  if (field->is_null())
+    return false;
+  const uchar *ptr= field->ptr;
+  switch (storage) {
+  case TINY:
+    return match<longlong>(((const signed char*) ptr)[0], range.i, values.i);
+  case UTINY:
+    return match<longlong>(ptr[0], range.i, values.i);
+  case SHORT:
+    return match<longlong>(sint2korr(ptr), range.i, values.i);
+  case USHORT:
+    return match<longlong>(uint2korr(ptr), range.i, values.i);
+  case MEDIUM:
+    return match<longlong>(sint3korr(ptr), range.i, values.i);
+  case UMEDIUM:
+    return match<longlong>(uint3korr(ptr), range.i, values.i);
+  case LONG:
+    return match<longlong>(sint4korr(ptr), range.i, values.i);
+  case ULONG:
+    return match<longlong>(uint4korr(ptr), range.i, values.i);
+  case LONGLONG:
+    return match<longlong>(sint8korr(ptr), range.i, values.i);
+  case ULONGLONG:
+    return match<ulonglong>(uint8korr(ptr), range.u, values.u);
+  case FLOAT:
+  {
+    float value;
+    float4get(value, ptr);
+    return match<double>(value, range.d, values.d);
+  }
+  case DOUBLE:
+  {
+    double value;
+    float8get(value, ptr);
+    return match<double>(value, range.d, values.d);
+  }
+  }
+  DBUG_ASSERT(0);
+  return false;
+}
+
+
+bool Record_filter::check() const
+{
+  for (const Predicate *p= predicates, *end= p + n_predicates; p < end; p++)
+    if (!p->check())
+      return false;
+  for (uint i= 0; i < n_rest; i++)
+    if (!rest[i]->val_bool())
+      return false;
+  return true;
+}
+
+
+/**
+  Remove from sel[] the records for which the predicate is not true.
+  The loop reads the column of one record after another at the same
+  offset from the record, without branching on the result.
+
+  @param read  reads the value of the column from a pointer into a record
+  @return the number of records that are still selected
+*/
+
+template <typename T, typename Read>
+inline uint Record_filter::Predicate::select(Read read, const T *min_max,
+                                             const T *set,
+                                             const uchar *record0,
+                                             const uchar *const *records,
+                                             uint *sel, uint n_sel) const
+{
+  uint n= 0;
+  for (uint i= 0; i < n_sel; i++)
+  {
+    const my_ptrdiff_t diff= records[sel[i]] - record0;
+    const bool value= !field->is_null(diff) &&
+                      match<T>(read(field->ptr + diff), min_max, set);
+    sel[n]= sel[i];
+    n+= value;
+  }
+  return n;
+}
+
+
+uint Record_filter::Predicate::check_batch(const uchar *record0,
+                                           const uchar *const *records,
+                                           uint *sel, uint n_sel) const
+{
+  switch (storage) {
+  case TINY:
+    return select<longlong>([](const uchar *ptr) -> longlong
+                            { return ((const signed char*) ptr)[0]; },
+                            range.i, values.i, record0, records, sel, n_sel);
+  case UTINY:
+    return select<longlong>([](const uchar *ptr) -> longlong
+                            { return ptr[0]; },
+                            range.i, values.i, record0, records, sel, n_sel);
+  case SHORT:
+    return select<longlong>([](const uchar *ptr) -> longlong
+                            { return sint2korr(ptr); },
+                            range.i, values.i, record0, records, sel, n_sel);
+  case USHORT:
+    return select<longlong>([](const uchar *ptr) -> longlong
+                            { return uint2korr(ptr); },
+                            range.i, values.i, record0, records, sel, n_sel);
+  case MEDIUM:
+    return select<longlong>([](const uchar *ptr) -> longlong
+                            { return sint3korr(ptr); },
+                            range.i, values.i, record0, records, sel, n_sel);
+  case UMEDIUM:
+    return select<longlong>([](const uchar *ptr) -> longlong
+                            { return uint3korr(ptr); },
+                            range.i, values.i, record0, records, sel, n_sel);
+  case LONG:
+    return select<longlong>([](const uchar *ptr) -> longlong
+                            { return sint4korr(ptr); },
+                            range.i, values.i, record0, records, sel, n_sel);
+  case ULONG:
+    return select<longlong>([](const uchar *ptr) -> longlong
+                            { return uint4korr(ptr); },
+                            range.i, values.i, record0, records, sel, n_sel);
+  case LONGLONG:
+    return select<longlong>([](const uchar *ptr) -> longlong
+                            { return sint8korr(ptr); },
+                            range.i, values.i, record0, records, sel, n_sel);
+  case ULONGLONG:
+    return select<ulonglong>([](const uchar *ptr) -> ulonglong
+                             { return uint8korr(ptr); },
+                             range.u, values.u, record0, records, sel, n_sel);
+  case FLOAT:
+    return select<double>([](const uchar *ptr) -> double
+                          {
+                            float value;
+                            float4get(value, ptr);
+                            return value;
+                          },
+                          range.d, values.d, record0, records, sel, n_sel);
+  case DOUBLE:
+    return select<double>([](const uchar *ptr) -> double
+                          {
+                            double value;
+                            float8get(value, ptr);
+                            return value;
+                          },
+                          range.d, values.d, record0, records, sel, n_sel);
+  }
+  DBUG_ASSERT(0);
+  return 0;
+}
+
+
+void Record_filter::check_batch(TABLE *table, const uchar *const *records,
+                                uint *sel, uint *n_sel) const
+{
+  for (const Predicate *p= predicates, *end= p + n_predicates;
+       *n_sel && p < end; p++)
+    *n_sel= p->check_batch(table->record[0], records, sel, *n_sel);
+  for (uint i= 0; *n_sel && i < n_rest; i++)
+    rest[i]->val_bool_batch(table, records, sel, n_sel);
+}
+
+
+#ifndef DBUG_OFF
+void Record_filter::debug_check_batch(TABLE *table, bool value)
+{
+  const size_t reclength= table->s->reclength;
+  if (!debug_records &&
+      !(debug_records= (uchar*) alloc_root(mem_root,
+                                            DEBUG_BATCH * reclength)))
+    return;
+  memcpy(debug_records + debug_n * reclength, table->record[0], reclength);
+  debug_values[debug_n]= value;
+  if (++debug_n < DEBUG_BATCH)
+    return;
+  debug_n= 0;
+
+  const uchar *records[DEBUG_BATCH];
+  uint sel[DEBUG_BATCH], n_sel= DEBUG_BATCH, expected= 0;
+  for (uint i= 0; i < DEBUG_BATCH; i++)
+  {
+    records[i]= debug_records + i * reclength;
+    sel[i]= i;
+    expected+= debug_values[i];
+  }
+  check_batch(table, records, sel, &n_sel);
+  bool mismatch= n_sel != expected;
+  for (uint i= 0; i < n_sel; i++)
+    mismatch|= !debug_values[sel[i]];
+  push_warning_printf(current_thd, Sql_condition::WARN_LEVEL_NOTE,
+                      ER_UNKNOWN_ERROR, "DBUG: Record_filter batch %s: "
+                      "%u of %u records%s", table->alias.c_ptr(), n_sel,
+                      DEBUG_BATCH, mismatch ? " mismatch" : "");
+  DBUG_ASSERT(!mismatch);
+}
+#endif
+
+
+Record_filter *Record_filter::create(THD *thd, Item *cond)
+{
+  List<Item> *conjuncts= NULL;
+  uint n= 1;
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond*) cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    conjuncts= ((Item_cond*) cond)->argument_list();
+    n= conjuncts->elements;
+  }
+
+  Predicate *predicates= (Predicate*) thd->alloc(n * sizeof(Predicate));
+  Record_filter *filter;
+  if (!predicates ||
+      !(filter= new (thd->mem_root) Record_filter(thd->mem_root, predicates)))
+    return NULL;
+
+  if (!conjuncts)
+    return cond->add_to_record_filter(filter) ? NULL : filter;
+
+  List_iterator_fast<Item> li(*conjuncts);
+  Item *item;
+  while ((item= li++) && !item->add_to_record_filter(filter))
+  {}
+  if (!filter->n_predicates)
+    return NULL;
+  if (item)
+  {
+    /*
+      Unless the condition is at the top level, Item_cond_and::val_int()
+      evaluates the conjuncts that follow a NULL one.
+    */
+    if (!cond->is_top_level_item())
+      return NULL;
+    filter->n_rest= n - filter->n_predicates;
+    if (!(filter->rest= (Item**) thd->alloc(filter->n_rest * sizeof(Item*))))
+      return NULL;
+    filter->rest[0]= item;
+    for (uint i= 1; i < filter->n_rest; i++)
+      filter->rest[i]= li++;
+  }
+  return filter;
+}
+
+
+bool Record_filter::storage_of(Field *field, Item_result cmp_type,
+                               Storage *storage)
+{
+  if (field->cmp_type() != cmp_type)
+    return true;
+  const bool is_unsigned= field->flags & UNSIGNED_FLAG;
+  switch (field->real_type()) {
+  case MYSQL_TYPE_TINY:
+    *storage= is_unsigned ? UTINY : TINY;
+    break;
+  case MYSQL_TYPE_SHORT:
+    *storage= is_unsigned ? USHORT : SHORT;
+    break;
+  case MYSQL_TYPE_INT24:
+    *storage= is_unsigned ? UMEDIUM : MEDIUM;
+    break;
+  case MYSQL_TYPE_LONG:
+    *storage= is_unsigned ? ULONG : LONG;
+    break;
+  case MYSQL_TYPE_LONGLONG:
+    *storage= is_unsigned ? ULONGLONG : LONGLONG;
+    break;
+  case MYSQL_TYPE_FLOAT:
+    *storage= FLOAT;
+    break;
+  case MYSQL_TYPE_DOUBLE:
+    *storage= DOUBLE;
+    break;
+  default:
+    return true;
+  }
+  return false;
+}
+
+
+bool Record_filter::add_range(Field *field, Storage storage,
+                              Item *min, bool min_open,
+                              Item *max, bool max_open, bool negated)
+{
+  Predicate *p= &predicates[n_predicates];
+  bool null;
+  if (storage == ULONGLONG)
+    null= domain_range(min, min_open, max, max_open, p->range.u);
+  else if (storage == FLOAT || storage == DOUBLE)
+    null= domain_range(min, min_open, max, max_open, p->range.d);
+  else
+    null= domain_range(min, min_open, max, max_open, p->range.i);
+  p->field= field;
+  p->storage= storage;
+  /* A comparison with NULL is never true */
+  p->negated= negated && !null;
+  p->n_values= 0;
+  n_predicates++;
+  return false;
+}
+
+
+bool Record_filter::add_comparison(Field *field, Item_func::Functype op,
+                                   Item *value, Item_result cmp_type)
+{
+  Storage storage;
+  if (storage_of(field, cmp_type, &storage))
+    return true;
+  switch (op) {
+  case Item_func::EQ_FUNC:
+    return add_range(field, storage, value, false, value, false, false);
+  case Item_func::NE_FUNC:
+    return add_range(field, storage, value, false, value, false, true);
+  case Item_func::LT_FUNC:
+    return add_range(field, storage, NULL, false, value, true, false);
+  case Item_func::LE_FUNC:
+    return add_range(field, storage, NULL, false, value, false, false);
+  case Item_func::GT_FUNC:
+    return add_range(field, storage, value, true, NULL, false, false);
+  case Item_func::GE_FUNC:
+    return add_range(field, storage, value, false, NULL, false, false);
+  default:
+    return true;
+  }
+}
+
+
+bool Record_filter::add_between(Field *field, Item *min, Item *max,
+                                bool negated, Item_result cmp_type)
+{
+  Storage storage;
+  /*
+    NOT BETWEEN with a NULL bound is true when the value is on the other
+    side of the bound that is not NULL
+  */
+  if (storage_of(field, cmp_type, &storage) ||
+      (negated && (min->is_null() || max->is_null())))
+    return true;
+  return add_range(field, storage, min, false, max, false, negated);
+}
+
+
+bool Record_filter::add_in(Field *field, Item **args, uint n_args,
+                           bool negated, Item_result cmp_type)
+{
+  Storage storage;
+  if (storage_of(field, cmp_type, &storage))
+    return true;
+
+  Predicate *p= &predicates[n_predicates];
+  int null;
+  if (storage == ULONGLONG)
+  {
+    null= domain_set(mem_root, args, n_args, &p->values.u, &p->n_values);
+    set_empty_range(p->range.u);
+  }
+  else if (storage == FLOAT || storage == DOUBLE)
+  {
+    null= domain_set(mem_root, args, n_args, &p->values.d, &p->n_values);
+    set_empty_range(p->range.d);
+  }
+  else
+  {
+    null= domain_set(mem_root, args, n_args, &p->values.i, &p->n_values);
+    set_empty_range(p->range.i);
+  }
+  if (null < 0)
+    return true;
+
+  p->field= field;
+  p->storage= storage;
+  p->negated= negated;
+  /* NOT IN is never true if the list contains NULL */
+  if (negated && null)
+  {
+    p->negated= false;
+    p->n_values= 0;
+  }
+  n_predicates++;
+  return false;
+}
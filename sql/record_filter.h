@@ -0,0 +1,163 @@
+/*
+   Copyright (c) 2023, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+#ifndef RECORD_FILTER_INCLUDED
+#define RECORD_FILTER_INCLUDED
+
+#include "sql_alloc.h"
+#include "item_func.h"                          // Item_func::Functype
+
+/**
+  A condition attached to a join table, partially compiled into checks
+  that read the values of integer and floating point columns directly from
+  the record buffer.
+
+  The conjuncts of the condition that compare a column with constants
+  (=, <>, <, <=, >, >=, BETWEEN and IN) are compiled by
+  Item::add_to_record_filter() into predicates that test whether the column
+  value is in a range or in a sorted set of values, in the domain of the
+  column. The values of the constants are computed once, when the filter is
+  created. check() evaluates the predicates without calling val_int() on
+  the Item tree, and evaluates the remaining conjuncts of the condition in
+  the normal way only for the records that pass the predicates.
+
+  Only a prefix of the conjuncts is compiled, so the conjuncts are still
+  evaluated in the order of the condition and the evaluation stops at the
+  first one that is not true, like in Item_cond_and::val_int().
+
+  check_batch() evaluates the condition on a batch of records: every
+  predicate is applied to the column of all the records that are still
+  selected before the next one, and the remaining conjuncts are evaluated
+  with Item::val_bool_batch().
+*/
+
+class Record_filter : public Sql_alloc
+{
+public:
+  /**
+    Create a filter for a condition.
+    @return the filter, or NULL if no part of the condition can be compiled
+  */
+  static Record_filter *create(THD *thd, Item *cond);
+
+  /**
+    Add the predicate "field op value".
+    @param cmp_type  the type of comparison of the predicate
+    @return true if the predicate cannot be compiled
+  */
+  bool add_comparison(Field *field, Item_func::Functype op, Item *value,
+                      Item_result cmp_type);
+  /** Add the predicate "field [NOT] BETWEEN min AND max" */
+  bool add_between(Field *field, Item *min, Item *max, bool negated,
+                   Item_result cmp_type);
+  /** Add the predicate "field [NOT] IN (values)" */
+  bool add_in(Field *field, Item **values, uint n_values, bool negated,
+              Item_result cmp_type);
+
+  /** @return the value of the condition for the current record */
+  bool check() const;
+  /**
+    Evaluate the condition on a batch of records.
+    @see Item::val_bool_batch()
+  */
+  void check_batch(TABLE *table, const uchar *const *records,
+                   uint *sel, uint *n_sel) const;
+#ifndef DBUG_OFF
+  /**
+    Collect a copy of the current record and the value of the condition
+    for it, and compare check_batch() with the collected values when a
+    batch is complete.
+  */
+  void debug_check_batch(TABLE *table, bool value);
+#endif
+
+  /** @return the number of compiled conjuncts */
+  uint predicate_count() const { return n_predicates; }
+  /** @return the number of conjuncts that are evaluated with val_int() */
+  uint rest_count() const { return n_rest; }
+
+private:
+  /** How the value of a column is stored in the record */
+  enum Storage
+  {
+    TINY, UTINY, SHORT, USHORT, MEDIUM, UMEDIUM, LONG, ULONG, LONGLONG,
+    ULONGLONG, FLOAT, DOUBLE
+  };
+
+  union Values
+  {
+    longlong *i;
+    ulonglong *u;
+    double *d;
+  };
+
+  struct Predicate
+  {
+    Field *field;
+    Storage storage;
+    /** true if the predicate matches the values not in the range or set */
+    bool negated;
+    /** The number of values of a set, or 0 for a range */
+    uint n_values;
+    /** The range [min, max] in the domain of the column */
+    union
+    {
+      longlong i[2];
+      ulonglong u[2];
+      double d[2];
+    } range;
+    /** The sorted set of values */
+    Values values;
+
+    inline bool check() const;
+    uint check_batch(const uchar *record0, const uchar *const *records,
+                     uint *sel, uint n_sel) const;
+    template <typename T> inline bool match(T value, const T *min_max,
+                                            const T *set) const;
+    template <typename T, typename Read>
+    inline uint select(Read read, const T *min_max, const T *set,
+                       const uchar *record0, const uchar *const *records,
+                       uint *sel, uint n_sel) const;
+  };
+
+  Record_filter(MEM_ROOT *mem_root, Predicate *predicates) :
+    mem_root(mem_root), predicates(predicates), n_predicates(0), rest(NULL),
+    n_rest(0)
+#ifndef DBUG_OFF
+    , debug_records(NULL), debug_n(0)
+#endif
+  {}
+
+  static bool storage_of(Field *field, Item_result cmp_type, Storage *storage);
+  bool add_range(Field *field, Storage storage, Item *min, bool min_open,
+                 Item *max, bool max_open, bool negated);
+
+  MEM_ROOT *mem_root;
+  Predicate *predicates;
+  uint n_predicates;
+  /** The conjuncts of the condition that follow the compiled ones */
+  Item **rest;
+  uint n_rest;
+#ifndef DBUG_OFF
+  static const uint DEBUG_BATCH= 4;
+  /** The records collected by debug_check_batch() */
+  uchar *debug_records;
+  bool debug_values[DEBUG_BATCH];
+  uint debug_n;
+#endif
+};
+
+#endif /* RECORD_FILTER_INCLUDED */
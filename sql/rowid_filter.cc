@@ -30,6 +30,8 @@ double Range_rowid_filter_cost_info::lookup_cost(
   switch (cont_type) {
   case SORTED_ARRAY_CONTAINER:
     return log(est_elements)*0.01;
+  case BLOOM_FILTER_CONTAINER:
+    return BLOOM_FILTER_ACCESS_COST;
   default:
     DBUG_ASSERT(0);
     return 0;
@@ -118,6 +120,9 @@ void Range_rowid_filter_cost_info::init(Rowid_filter_container_type cont_type,
   est_elements= (ulonglong) table->opt_range[key_no].rows;
   b= build_cost(container_type);
   selectivity= est_elements/((double) table->stat_records());
+  /* A Bloom filter also lets through a share of the rows not in the range */
+  if (container_type == BLOOM_FILTER_CONTAINER)
+    selectivity+= (1 - selectivity) * BLOOM_FILTER_FALSE_POSITIVE_RATE;
   a= avg_access_and_eval_gain_per_row(container_type);
   if (a > 0)
     cross_x= b/a;
@@ -146,6 +151,9 @@ Range_rowid_filter_cost_info::build_cost(Rowid_filter_container_type cont_type)
     cost+= ARRAY_WRITE_COST * est_elements; /* cost filling the container */
     cost+= ARRAY_SORT_C * est_elements * log(est_elements); /* sorting cost */
     break;
+  case BLOOM_FILTER_CONTAINER:
+    cost+= BLOOM_FILTER_ACCESS_COST * est_elements; /* cost filling the filter */
+    break;
   default:
     DBUG_ASSERT(0);
   }
@@ -165,6 +173,10 @@ Rowid_filter_container *Range_rowid_filter_cost_info::create_container()
     res= new (thd->mem_root) Rowid_filter_sorted_array((uint) est_elements,
                                                        elem_sz);
     break;
+  case BLOOM_FILTER_CONTAINER:
+    res= new (thd->mem_root) Rowid_filter_bloom(thd->mem_root, est_elements,
+                                                elem_sz);
+    break;
   default:
     DBUG_ASSERT(0);
   }
@@ -315,6 +327,9 @@ get_max_range_rowid_filter_elems_for_table(
   switch (cont_type) {
   case SORTED_ARRAY_CONTAINER :
     return thd->variables.max_rowid_filter_size/tab->file->ref_length;
+  case BLOOM_FILTER_CONTAINER :
+    return thd->variables.max_rowid_filter_size * 8 /
+           BLOOM_FILTER_BITS_PER_ELEMENT;
   default :
     DBUG_ASSERT(0);
     return 0;
@@ -347,7 +362,9 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
 {
   uint key_no;
   key_map usable_range_filter_keys;
+  key_map bloom_filter_keys;
   usable_range_filter_keys.clear_all();
+  bloom_filter_keys.clear_all();
   key_map::Iterator it(opt_range_keys);
 
   if (file->ha_table_flags() & HA_NON_COMPARABLE_ROWID)
@@ -358,6 +375,8 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
     - range filter pushdown is supported by the engine for them     (1)
     - they are not clustered primary                                (2)
     - the range filter containers for them are not too large        (3)
+    A Bloom filter is used as the container when a sorted array would be
+    too large and optimizer_bloom_filters is set.
   */
   while ((key_no= it++) != key_map::Iterator::BITMAP_END)
   {
@@ -365,10 +384,17 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
       continue;
     if (file->is_clustering_key(key_no))                              // !2
       continue;
-   if (opt_range[key_no].rows >
-       get_max_range_rowid_filter_elems_for_table(thd, this,
-                                                  SORTED_ARRAY_CONTAINER)) // !3
-      continue;
+    if (opt_range[key_no].rows >
+        get_max_range_rowid_filter_elems_for_table(thd, this,
+                                                   SORTED_ARRAY_CONTAINER))
+    {
+      if (!thd->variables.optimizer_bloom_filters ||
+          opt_range[key_no].rows >
+          get_max_range_rowid_filter_elems_for_table(thd, this,
+                                                     BLOOM_FILTER_CONTAINER))
+        continue;                                                     // !3
+      bloom_filter_keys.set_bit(key_no);
+    }
     usable_range_filter_keys.set_bit(key_no);
   }
 
@@ -404,7 +430,10 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
   while ((key_no= li++) != key_map::Iterator::BITMAP_END)
   {
     *curr_ptr= curr_filter_cost_info;
-    curr_filter_cost_info->init(SORTED_ARRAY_CONTAINER, this, key_no);
+    curr_filter_cost_info->init(bloom_filter_keys.is_set(key_no) ?
+                                BLOOM_FILTER_CONTAINER :
+                                SORTED_ARRAY_CONTAINER,
+                                this, key_no);
     curr_ptr++;
     curr_filter_cost_info++;
   }
@@ -600,7 +629,10 @@ bool Range_rowid_filter::fill()
   file->pushed_idx_cond= pushed_idx_cond_save;
   file->pushed_idx_cond_keyno= pushed_idx_cond_keyno_save;
   file->in_range_check_pushed_down= in_range_check_pushed_down_save;
-  tracker->report_container_buff_size(table->file->ref_length);
+  tracker->report_container_buff_size(container->get_type() ==
+                                      BLOOM_FILTER_CONTAINER ?
+                                      BLOOM_FILTER_BITS_PER_ELEMENT :
+                                      table->file->ref_length);
 
   if (rc != HA_ERR_END_OF_FILE)
     return 1;
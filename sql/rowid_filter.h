@@ -20,6 +20,7 @@
 
 #include "mariadb.h"
 #include "sql_array.h"
+#include "bloom_filter.h"
 
 /*
 
@@ -149,11 +150,13 @@ class Range_rowid_filter_cost_info;
 #define ARRAY_SORT_C          0.01
 /* Cost to evaluate condition */
 #define COST_COND_EVAL  0.2
+/* Cost to add a rowid to a Bloom filter or to look it up there */
+#define BLOOM_FILTER_ACCESS_COST  0.002
 
 typedef enum
 {
   SORTED_ARRAY_CONTAINER,
-  BLOOM_FILTER_CONTAINER      // Not used yet
+  BLOOM_FILTER_CONTAINER
 } Rowid_filter_container_type;
 
 /**
@@ -162,7 +165,7 @@ typedef enum
   The interface for different types of containers to store info on the set
   of rowids / primary keys that defines a pk-filter.
 
-  There will be two implementations of this abstract class.
+  There are two implementations of this abstract class.
   - sorted array
   - bloom filter
 */
@@ -382,6 +385,61 @@ class Rowid_filter_sorted_array: public Rowid_filter_container
   bool is_empty() { return refpos_container.is_empty(); }
 };
 
+
+/**
+  @class Rowid_filter_bloom
+
+  The implementation of the Rowid_filter_container interface as
+  a Bloom filter over the hash values of rowids / primary keys.
+
+  The container takes BLOOM_FILTER_BITS_PER_ELEMENT bits per element
+  whatever the length of the rowids is, so it can be used for the range
+  filters whose sorted arrays would be too large. check() may return
+  true for a rowid that was not added, which only costs the read of
+  a record that the condition of the table then discards.
+
+  The rowids are hashed as byte strings: the rowid of a record that is
+  checked is computed by handler::position() in the same way as the one
+  that was added.
+*/
+
+class Rowid_filter_bloom: public Rowid_filter_container
+{
+  /* The memory root the filter is allocated on */
+  MEM_ROOT *mem_root;
+  /* The number of elements the filter is sized for */
+  ulonglong est_elements;
+  /* The length of a rowid / primary key */
+  uint elem_size;
+  /* The number of elements added to the filter */
+  ulonglong n_elements;
+  Bloom_filter filter;
+
+public:
+  Rowid_filter_bloom(MEM_ROOT *root, ulonglong elems, uint elem_sz)
+    : mem_root(root), est_elements(elems), elem_size(elem_sz),
+      n_elements(0) {}
+
+  Rowid_filter_container_type get_type()
+  { return BLOOM_FILTER_CONTAINER; }
+
+  bool alloc() { return filter.init(mem_root, est_elements); }
+
+  bool add(void *ctxt, char *elem)
+  {
+    filter.add(Bloom_filter::hash((uchar *) elem, elem_size));
+    n_elements++;
+    return false;
+  }
+
+  bool check(void *ctxt, char *elem)
+  {
+    return filter.check(Bloom_filter::hash((uchar *) elem, elem_size));
+  }
+
+  bool is_empty() { return n_elements == 0; }
+};
+
 /**
   @class Range_rowid_filter_cost_info
 
@@ -23,6 +23,12 @@
 #include "sql_select.h"
 #include "my_json_writer.h"
 
+static double cycles_to_ms(ulonglong cycles)
+{
+  return 1000.0 * static_cast<double>(cycles) /
+    static_cast<double>(sys_timer_info.cycles.frequency);
+}
+
 void Filesort_tracker::print_json_members(Json_writer *writer)
 {
   const char *varied_str= "(varied across executions)";
@@ -82,6 +88,22 @@ void Filesort_tracker::print_json_members(Json_writer *writer)
 
   get_data_format(&str);
   writer->add_member("r_sort_mode").add_str(str.ptr(), str.length());
+
+  if (r_parallel_sorts)
+  {
+    writer->add_member("r_parallel_sort").start_object();
+    writer->add_member("r_threads").add_ll(r_sort_threads);
+    if (time_tracker.has_timed_statistics())
+    {
+      writer->add_member("r_read_time_ms").add_double(
+                          cycles_to_ms(r_read_cycles));
+      writer->add_member("r_sort_time_ms").add_double(
+                          cycles_to_ms(r_sort_cycles));
+      writer->add_member("r_merge_time_ms").add_double(
+                          cycles_to_ms(r_merge_cycles));
+    }
+    writer->end_object();
+  }
 }
 
 void Filesort_tracker::get_data_format(String *str)
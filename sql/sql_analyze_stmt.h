@@ -227,7 +227,9 @@ class Filesort_tracker : public Sql_alloc
     sort_buffer_size(0),
     r_using_addons(false),
     r_packed_addon_fields(false),
-    r_sort_keys_packed(false)
+    r_sort_keys_packed(false),
+    r_parallel_sorts(0), r_sort_threads(0),
+    r_read_cycles(0), r_sort_cycles(0), r_merge_cycles(0)
   {}
   
   /* Functions that filesort uses to report various things about its execution */
@@ -279,6 +281,17 @@ class Filesort_tracker : public Sql_alloc
   {
     r_sort_keys_packed= sort_keys_packed;
   }
+  /* Called when filesort() sorted its buffer with several threads */
+  inline void report_parallel_sort(uint threads, ulonglong read_cycles,
+                                   ulonglong sort_cycles,
+                                   ulonglong merge_cycles)
+  {
+    r_parallel_sorts++;
+    set_if_bigger(r_sort_threads, threads);
+    r_read_cycles+= read_cycles;
+    r_sort_cycles+= sort_cycles;
+    r_merge_cycles+= merge_cycles;
+  }
 
   void get_data_format(String *str);
 
@@ -345,6 +358,17 @@ class Filesort_tracker : public Sql_alloc
   bool r_using_addons;
   bool r_packed_addon_fields;
   bool r_sort_keys_packed;
+
+  /* How many sorts used several threads, and at most how many */
+  ulonglong r_parallel_sorts;
+  uint r_sort_threads;
+  /*
+    Time spent in the parallel sorts reading rows and making sort keys,
+    sorting the sort buffers, and merging sorted chunks from tempfile.
+  */
+  ulonglong r_read_cycles;
+  ulonglong r_sort_cycles;
+  ulonglong r_merge_cycles;
 };
 
 
@@ -428,3 +452,36 @@ class Rowid_filter_tracker : public Sql_alloc
 
   size_t get_container_buff_size() const { return container_buff_size; }
 };
+
+
+/*
+  A class to collect data about how the Bloom filter of a BNLH join cache
+  is used: the join keys of the records of the joined table are checked
+  against it, and the records whose keys are not found there are discarded
+  before the hash table of the cache is searched.
+*/
+
+class Join_filter_tracker : public Sql_alloc
+{
+  /* Count of the join keys checked against the filter */
+  ulonglong n_checks;
+  /* Count of the checked join keys that the filter let through */
+  ulonglong n_positive_checks;
+public:
+  Join_filter_tracker() : n_checks(0), n_positive_checks(0) {}
+
+  void increment_checked_elements_count(bool was_checked)
+  {
+    n_checks++;
+    if (was_checked)
+     n_positive_checks++;
+  }
+
+  ulonglong get_lookups() const { return n_checks; }
+
+  double get_r_selectivity_pct() const
+  {
+    return n_checks ? static_cast<double>(n_positive_checks) /
+                      static_cast<double>(n_checks) : 0;
+  }
+};
@@ -689,6 +689,7 @@ typedef struct system_variables
   ulonglong max_heap_table_size;
   ulonglong tmp_memory_table_size;
   ulonglong tmp_disk_table_size;
+  ulonglong group_by_hash_buffer_size;
   ulonglong long_query_time;
   ulonglong max_statement_time;
   ulonglong optimizer_switch;
@@ -740,6 +741,7 @@ typedef struct system_variables
   ulong max_length_for_sort_data;
   ulong max_recursive_iterations;
   ulong max_sort_length;
+  ulong sort_parallel_threads;
   ulong max_tmp_tables;
   ulong max_insert_delayed_threads;
   ulong min_examined_row_limit;
@@ -818,6 +820,8 @@ typedef struct system_variables
   my_bool binlog_annotate_row_events;
   my_bool binlog_direct_non_trans_update;
   my_bool column_compression_zlib_wrap;
+  my_bool where_record_filter;
+  my_bool optimizer_bloom_filters;
 
   plugin_ref table_plugin;
   plugin_ref tmp_table_plugin;
@@ -1755,6 +1755,8 @@ void Explain_rowid_filter::print_explain_json(Explain_query *query,
   quick->print_json(writer);
   writer->add_member("rows").add_ll(rows);
   writer->add_member("selectivity_pct").add_double(selectivity * 100.0);
+  if (container)
+    writer->add_member("container").add_str(container);
   if (is_analyze)
   {
     writer->add_member("r_rows").add_double(tracker->get_container_elements());
@@ -1958,6 +1960,19 @@ void Explain_table_access::print_explain_json(Explain_query *query,
     writer->add_member("join_type").add_str(bka_type.join_alg);
     if (bka_type.mrr_type.length())
       writer->add_member("mrr_type").add_str(bka_type.mrr_type);
+    if (bka_type.join_filter)
+    {
+      writer->add_member("join_filter").start_object();
+      writer->add_member("type").add_str("bloom_filter");
+      if (is_analyze)
+      {
+        writer->add_member("r_lookups").
+          add_ull(bka_type.join_filter->get_lookups());
+        writer->add_member("r_selectivity_pct").
+          add_double(bka_type.join_filter->get_r_selectivity_pct() * 100.0);
+      }
+      writer->end_object(); // join_filter
+    }
     if (where_cond)
     {
       writer->add_member("attached_condition");
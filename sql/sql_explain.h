@@ -590,7 +590,7 @@ enum explain_extra_tag
 class EXPLAIN_BKA_TYPE
 {
 public:
-  EXPLAIN_BKA_TYPE() : join_alg(NULL) {}
+  EXPLAIN_BKA_TYPE() : join_alg(NULL), join_filter(NULL) {}
 
   size_t join_buffer_size;
 
@@ -604,6 +604,9 @@ class EXPLAIN_BKA_TYPE
 
   /* Information about MRR usage.  */
   StringBuffer<64> mrr_type;
+
+  /* The tracker of the Bloom filter of a BNLH join cache, if it has one */
+  Join_filter_tracker *join_filter;
   
   bool is_using_jbuf() { return (join_alg != NULL); }
 };
@@ -657,6 +660,9 @@ class Explain_rowid_filter : public Sql_alloc
   /* Expected selectivity for the filter */
   double selectivity;
 
+  /* The type of the container if it is not a sorted array, or NULL */
+  const char *container;
+
   /* Tracker with the information about how rowid filter is executed */
   Rowid_filter_tracker *tracker;
 
@@ -32,6 +32,7 @@
 #include "sql_base.h"
 #include "sql_select.h"
 #include "opt_subselect.h"
+#include "bloom_filter.h"
 
 #define NO_MORE_RECORDS_IN_BUFFER  (uint)(-1)
 
@@ -2972,6 +2973,8 @@ void JOIN_CACHE_HASHED::reset(bool for_writing)
   this->JOIN_CACHE::reset(for_writing);
   if (for_writing && hash_table)
     cleanup_hash_table();
+  if (for_writing && join_filter)
+    join_filter->clear();
   curr_key_entry= hash_table;
 }
 
@@ -2997,6 +3000,7 @@ void JOIN_CACHE_HASHED::reset(bool for_writing)
     the record from the partial join.
     If the match flag field of a record contains MATCH_IMPOSSIBLE the key is
     not created for this record. 
+    A new key is also added to the Bloom filter join_filter if there is one.
     
   RETURN VALUE
     TRUE    if it has been decided that it should be the last record
@@ -3079,6 +3083,8 @@ bool JOIN_CACHE_HASHED::put_record()
     DBUG_ASSERT(last_key_entry >= end_pos);
     /* Increment the counter of key_entries in the hash table */ 
     key_entries++;
+    if (join_filter)
+      join_filter->add(get_join_filter_hash(key));
   }  
   return is_full;
 }
@@ -3278,6 +3284,32 @@ uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
 }
 
 
+/* 
+  Hash function for the Bloom filter over the keys of the hash table
+
+  SYNOPSIS
+    get_join_filter_hash()
+      key             pointer to the key value
+
+  DESCRIPTION
+    The function calculates the 64-bit hash value of the given key used
+    to add the key to the Bloom filter join_filter or to look for it there.
+    Like the hash function of the hash table, it considers the key as
+    a sequence of bytes if the keys are compared as such, and it takes
+    into account the collations of the components of the key otherwise.
+
+  RETURN VALUE
+    the calculated hash value for the given key  
+*/
+
+ulonglong JOIN_CACHE_HASHED::get_join_filter_hash(uchar *key)
+{
+  if (hash_func == &JOIN_CACHE_HASHED::get_hash_idx_simple)
+    return Bloom_filter::hash(key, key_length);
+  return Bloom_filter::mix(key_hashnr(ref_key_info, ref_used_key_parts, key));
+}
+
+
 /* 
   Compare two key entries in the hash table as sequence of bytes
 
@@ -3904,12 +3936,117 @@ void JOIN_CACHE_BNLH::read_next_candidate_for_match(uchar *rec_ptr)
 
 int JOIN_CACHE_BNLH::init(bool for_explain)
 {
+  int rc;
   DBUG_ENTER("JOIN_CACHE_BNLH::init");
 
   if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
     DBUG_RETURN(1);
 
-  DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
+  if ((rc= JOIN_CACHE_HASHED::init(for_explain)) || for_explain)
+    DBUG_RETURN(rc);
+
+  /* The filter is sized for as many keys as there are hash entries */
+  if (use_join_filter)
+  {
+    MEM_ROOT *mem_root= join->thd->mem_root;
+    if (!(join_filter= new (mem_root) Bloom_filter) ||
+        join_filter->init(mem_root, get_hash_entries()))
+      DBUG_RETURN(1);
+  }
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Find matches from join_tab for the records in the BNLH join buffer
+
+  SYNOPSIS
+    join_matching_records()
+      skip_last   <-> ignore the last record in the buffer
+
+  DESCRIPTION
+    This implementation of the virtual method join_matching_records
+    activates the Bloom filter over the join keys in the buffer for the
+    time of the scan of join_tab, and then calls the default
+    implementation of the method. Out of this scan the condition checking
+    the filter is always true.
+
+  RETURN VALUE
+    the return value of JOIN_CACHE::join_matching_records
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_matching_records(bool skip_last)
+{
+  join_filter_is_active= join_filter != NULL;
+  enum_nested_loop_state rc= JOIN_CACHE::join_matching_records(skip_last);
+  join_filter_is_active= FALSE;
+  return rc;
+}
+
+
+/*
+  Check whether the join key of the record from join_tab may be in the buffer
+
+  SYNOPSIS
+    check_join_filter()
+
+  DESCRIPTION
+    The function builds the join key out of the record of join_tab in its
+    record buffer, in the same way as get_matching_chain_by_join_key() does,
+    and looks for the key in the Bloom filter over the keys in the hash table.
+    If the key is not found there the record has no matches in the buffer.
+    The function is called when evaluating the condition attached to
+    join_tab by JOIN_TAB::make_join_filter(), which can be pushed to the
+    engine as a part of the index condition. In that case only the fields
+    of the index are read into the record buffer, and the fields of the
+    join key are among them.
+
+  RETURN VALUE
+    FALSE   the record has definitely no matches in the buffer
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::check_join_filter()
+{
+  if (!join_filter_is_active)
+    return TRUE;
+  key_copy(key_buff, join_tab->table->record[0], ref_key_info, key_length,
+           TRUE);
+  bool found= join_filter->check(get_join_filter_hash(key_buff));
+  if (join_filter_tracker)
+    join_filter_tracker->increment_checked_elements_count(found);
+  return found;
+}
+
+
+/*
+  Save the explain data of the BNLH join cache
+
+  SYNOPSIS
+    save_explain_data()
+      explain  the data structure to fill
+
+  DESCRIPTION
+    In addition to the data saved by JOIN_CACHE::save_explain_data(), this
+    implementation creates the tracker of the checks of the Bloom filter
+    when the cache has one.
+
+  RETURN VALUE
+   0 ok
+   1 error
+*/
+
+bool JOIN_CACHE_BNLH::save_explain_data(EXPLAIN_BKA_TYPE *explain)
+{
+  if (JOIN_CACHE::save_explain_data(explain))
+    return 1;
+  if (use_join_filter)
+  {
+    if (!(join_filter_tracker= new (join->thd->mem_root) Join_filter_tracker))
+      return 1;
+    explain->join_filter= join_filter_tracker;
+  }
+  return 0;
 }
 
 
@@ -65,6 +65,8 @@ class JOIN_TAB_SCAN;
 
 class EXPLAIN_BKA_TYPE;
 
+class Bloom_filter;
+
 /*
   JOIN_CACHE is the base class to support the implementations of 
   - Block Nested Loop (BNL) Join Algorithm,
@@ -847,6 +849,12 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* Number of key entries in the hash table (number of distinct keys) */
   uint key_entries;
 
+  /*
+    The Bloom filter over the keys in the hash table, or NULL if the
+    records of join_tab are not filtered by the join keys in the buffer
+  */
+  Bloom_filter *join_filter;
+
   /* The position of the last key entry in the hash table */
   uchar *last_key_entry;
 
@@ -861,6 +869,11 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
 
   uint get_size_of_key_offset() { return size_of_key_ofs; }
 
+  uint get_hash_entries() { return hash_entries; }
+
+  /* Get the hash value of a key value used in the Bloom filter */
+  ulonglong get_join_filter_hash(uchar *key);
+
   /* 
     Get the position of the next_key_ptr field pointed to by 
     a linking reference stored at the position key_ref_ptr. 
@@ -992,7 +1005,8 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_HASHED(JOIN *j, JOIN_TAB *tab) :JOIN_CACHE(j, tab) {}
+  JOIN_CACHE_HASHED(JOIN *j, JOIN_TAB *tab)
+    :JOIN_CACHE(j, tab), join_filter(0) {}
 
   /* 
     This constructor creates a linked hashed join cache. The cache is to be
@@ -1001,7 +1015,7 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_HASHED(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-		    :JOIN_CACHE(j, tab, prev) {}
+		    :JOIN_CACHE(j, tab, prev), join_filter(0) {}
 
 public:
 
@@ -1190,14 +1204,33 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   void read_next_candidate_for_match(uchar *rec_ptr);
 
+  /*
+    TRUE <=> the records of join_tab are being matched against the records
+    in the buffer, so the Bloom filter contains all their join keys
+  */
+  bool join_filter_is_active;
+
+  /* The tracker of the checks of the Bloom filter for ANALYZE, or NULL */
+  Join_filter_tracker *join_filter_tracker;
+
+  enum_nested_loop_state join_matching_records(bool skip_last);
+
 public:
 
+  /*
+    TRUE <=> the cache is to build a Bloom filter over the join keys in
+    the buffer to be checked by a condition attached to join_tab
+  */
+  bool use_join_filter;
+
   /* 
     This constructor creates an unlinked BNLH join cache. The cache is to be
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), join_filter_is_active(FALSE),
+      join_filter_tracker(NULL), use_join_filter(FALSE) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1206,7 +1239,8 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), join_filter_is_active(FALSE),
+      join_filter_tracker(NULL), use_join_filter(FALSE) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain);
@@ -1215,6 +1249,42 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   bool is_key_access() { return TRUE; }
 
+  /*
+    Check whether the join key of the record of join_tab may be in the
+    buffer
+  */
+  bool check_join_filter();
+
+  bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
+};
+
+
+/*
+  The condition "the join key of the current record of a table joined with
+  a BNLH join cache may be found in the join buffer". It is attached to the
+  scan of the table, and pushed into the engine together with the index
+  condition when the join key is in the scanned index, so that the records
+  without matches are discarded before they are read completely.
+  The arguments are the fields of the join key. They are used only to show
+  the table and the index which the condition depends on: the value of the
+  condition is computed by the join cache.
+*/
+
+class Item_func_join_filter: public Item_bool_func
+{
+  JOIN_CACHE_BNLH *cache;
+public:
+  Item_func_join_filter(THD *thd, List<Item> &list, JOIN_CACHE_BNLH *c)
+    : Item_bool_func(thd, list), cache(c) {}
+  longlong val_int() override { return cache->check_join_filter(); }
+  LEX_CSTRING func_name_cstring() const override
+  {
+    static LEX_CSTRING name= {STRING_WITH_LEN("<join_filter>") };
+    return name;
+  }
+  bool const_item() const override { return FALSE; }
+  Item *get_copy(THD *thd) override
+  { return get_item_copy<Item_func_join_filter>(thd, this); }
 };
 
 
@@ -64,6 +64,7 @@
 #include "sp_head.h"
 #include "sp_rcontext.h"
 #include "rowid_filter.h"
+#include "record_filter.h"
 #include "select_handler.h"
 #include "my_json_writer.h"
 #include "opt_trace.h"
@@ -4439,6 +4440,8 @@ JOIN::reinit()
         continue;
       tmp_table->file->extra(HA_EXTRA_RESET_STATE);
       tmp_table->file->ha_delete_all_rows();
+      if (curr_tab->aggr && curr_tab->aggr->group_hash)
+        curr_tab->aggr->group_hash->clear();
     }
   }
   clear_sj_tmp_tables(this);
@@ -10478,6 +10481,88 @@ int JOIN_TAB::make_scan_filter()
 }
 
 
+/**
+  @brief
+  Create the condition checking the Bloom filter of the BNLH join cache
+
+  @details
+  The function creates the condition Item_func_join_filter over the fields
+  of the join key used by the BNLH join cache of this table and lets the
+  cache know that it has to build a Bloom filter over the join keys in its
+  buffer. The condition is saved in join_filter to be pushed to the engine
+  by push_index_cond() or attached to the scan of the table by
+  attach_join_filter(). If the condition cannot be created the table is
+  joined without it.
+*/
+
+void JOIN_TAB::make_join_filter()
+{
+  THD *thd= join->thd;
+  KEY *keyinfo= get_keyinfo_by_key_no(ref.key);
+  List<Item> args;
+  Item *filter;
+
+  join_filter= 0;
+  for (uint i= 0; i < ref.key_parts; i++)
+  {
+    Item *arg= new (thd->mem_root) Item_field(thd, keyinfo->key_part[i].field);
+    if (!arg || args.push_back(arg, thd->mem_root))
+      return;
+  }
+  if (!(filter= new (thd->mem_root)
+          Item_func_join_filter(thd, args, (JOIN_CACHE_BNLH *) cache)) ||
+      filter->fix_fields(thd, 0))
+    return;
+  join_filter= filter;
+  ((JOIN_CACHE_BNLH *) cache)->use_join_filter= TRUE;
+}
+
+
+/**
+  @brief
+  Attach the condition checking the Bloom filter to the scan of the table
+
+  @details
+  If the condition join_filter has not been pushed to the engine the
+  function puts it in front of the condition checked in
+  JOIN_TAB_SCAN::next() for each record read by the scan of the table
+  joined with the BNLH join cache.
+
+  @retval  0   on success
+           1   otherwise
+*/
+
+bool JOIN_TAB::attach_join_filter()
+{
+  THD *thd= join->thd;
+  Item *filter= join_filter;
+
+  if (!filter)
+    return 0;
+  join_filter= 0;
+  if (!cache_select)
+  {
+    if (!(cache_select= new (thd->mem_root) SQL_SELECT))
+      return 1;
+    cache_select->read_tables= join->const_table_map;
+  }
+  if (cache_select->cond)
+  {
+    Item_cond_and *cond= new (thd->mem_root)
+      Item_cond_and(thd, filter, cache_select->cond);
+    if (!cond)
+      return 1;
+    cond->quick_fix_field();
+    cond->used_tables_cache= filter->used_tables() |
+                             cache_select->cond->used_tables();
+    cond->top_level_item();
+    filter= cond;
+  }
+  cache_select->cond= filter;
+  return 0;
+}
+
+
 /**
   @brief
   Check whether hash join algorithm can be used to join this table   
@@ -13007,6 +13092,7 @@ void set_join_cache_denial(JOIN_TAB *join_tab)
     join_tab->cache->free();
     join_tab->cache= 0;
   }
+  join_tab->join_filter= 0;
   if (join_tab->use_join_cache)
   {
     join_tab->use_join_cache= FALSE;
@@ -13514,6 +13600,8 @@ uint check_join_cache_usage(JOIN_TAB *tab,
       if ((tab->cache= new (root) JOIN_CACHE_BNLH(join, tab, prev_cache)))
       {
         tab->icp_other_tables_ok= FALSE;        
+        if (join->thd->variables.optimizer_bloom_filters)
+          tab->make_join_filter();
         return (4 - MY_TEST(!prev_cache));
       }
       goto no_join_cache;
@@ -13976,6 +14064,8 @@ make_join_readinfo(JOIN *join, ulonglong options, uint no_jbuf_after)
             !tab->table->covering_keys.is_set(tab->select->quick->index))
           push_index_cond(tab, tab->select->quick->index);
       }
+      if (tab->attach_join_filter())
+        return TRUE;
       break;
     case JT_FT:
       break;
@@ -14121,6 +14211,30 @@ void JOIN_TAB::build_range_rowid_filter_if_needed()
 }
 
 
+/**
+  Build the filter that evaluates select_cond in evaluate_join_record()
+
+  @note
+    The constants of the condition are evaluated here, at the first
+    evaluation of the condition, when all of them have their values.
+*/
+
+void JOIN_TAB::build_record_filter()
+{
+  THD *thd= join->thd;
+  record_filter_cond= select_cond;
+  record_filter= thd->variables.where_record_filter ?
+                 Record_filter::create(thd, select_cond) : NULL;
+  DBUG_EXECUTE_IF("Record_filter",
+                  if (record_filter)
+                    push_warning_printf(thd, Sql_condition::WARN_LEVEL_NOTE,
+                    ER_UNKNOWN_ERROR, "DBUG: Record_filter %s: "
+                    "predicates=%u rest=%u", table->alias.c_ptr(),
+                    record_filter->predicate_count(),
+                    record_filter->rest_count()););
+}
+
+
 /**
   cleanup JOIN_TAB.
 
@@ -14156,6 +14270,11 @@ void JOIN_TAB::cleanup()
     delete filesort->select;
   delete filesort;
   filesort= NULL;
+  if (aggr)
+    aggr->free_group_hash();
+  record_filter= 0;
+  record_filter_cond= 0;
+  join_filter= 0;
   /* Skip non-existing derived tables/views result tables */
   if (table &&
       (table->s->tmp_table != INTERNAL_TMP_TABLE || table->is_created()))
@@ -21568,7 +21687,25 @@ evaluate_join_record(JOIN *join, JOIN_TAB *join_tab,
 
   if (select_cond)
   {
-    select_cond_result= MY_TEST(select_cond->val_int());
+    if (join_tab->record_filter_cond != select_cond)
+      join_tab->build_record_filter();
+    if (join_tab->record_filter)
+    {
+      select_cond_result= join_tab->record_filter->check();
+      /*
+        The collected records must stay valid and the condition must depend
+        only on them
+      */
+      DBUG_EXECUTE_IF("Record_filter_batch",
+                      if (!join_tab->table->s->blob_fields &&
+                          !(select_cond->used_tables() &
+                            ~join_tab->table->map))
+                        join_tab->record_filter->
+                          debug_check_batch(join_tab->table,
+                                            select_cond_result););
+    }
+    else
+      select_cond_result= MY_TEST(select_cond->val_int());
 
     /* check for errors evaluating the condition */
     if (unlikely(join->thd->is_error()))
@@ -23003,6 +23140,45 @@ end_write(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 }
 
 
+/**
+  Write the groups collected in the hash table of end_update() into the
+  temporary table, and stop using the hash table.
+
+  @return true on error
+*/
+
+static bool flush_group_hash(JOIN_TAB *join_tab)
+{
+  TABLE *const table= join_tab->table;
+  TMP_TABLE_PARAM *tmp_table_param= join_tab->tmp_table_param;
+  Group_by_hash *group_hash= join_tab->aggr->group_hash;
+  int error;
+  DBUG_ENTER("flush_group_hash");
+
+  for (uint32 i= 0; i < group_hash->elements(); i++)
+  {
+    memcpy(table->record[0], group_hash->record(i), table->s->reclength);
+    if (unlikely((error= table->file->ha_write_tmp_row(table->record[0]))))
+    {
+      if (create_internal_tmp_table_from_heap(join_tab->join->thd, table,
+                                              tmp_table_param->start_recinfo,
+                                              &tmp_table_param->recinfo,
+                                              error, 0, NULL))
+        DBUG_RETURN(true);
+      /* Change method to update rows */
+      if (unlikely((error= table->file->ha_index_init(0, 0))))
+      {
+        table->file->print_error(error, MYF(0));
+        DBUG_RETURN(true);
+      }
+      join_tab->aggr->set_write_func(end_unique_update);
+    }
+  }
+  join_tab->aggr->free_group_hash();
+  DBUG_RETURN(false);
+}
+
+
 /*
   @brief
     Perform GROUP BY operation over rows coming in arbitrary order: use
@@ -23032,12 +23208,20 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 	   bool end_of_records)
 {
   TABLE *const table= join_tab->table;
+  const uchar *group_buff= join_tab->tmp_table_param->group_buff;
+  Group_by_hash *group_hash= join_tab->aggr->group_hash;
+  uchar *group_rec= NULL;
+  uint32 hash= 0;
   ORDER   *group;
   int	  error;
   DBUG_ENTER("end_update");
 
   if (end_of_records)
+  {
+    if (group_hash && flush_group_hash(join_tab))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
     DBUG_RETURN(NESTED_LOOP_OK);
+  }
 
   join->found_records++;
   copy_fields(join_tab->tmp_table_param);	// Groups are copied twice.
@@ -23059,10 +23243,26 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
     if (item->maybe_null())
       group->buff[-1]= (char) group->field->is_null();
   }
-  if (!table->file->ha_index_read_map(table->record[1],
-                                      join_tab->tmp_table_param->group_buff,
-                                      HA_WHOLE_KEY,
-                                      HA_READ_KEY_EXACT))
+  if (group_hash)
+  {
+    hash= group_hash->hash_key(group_buff);
+    if ((group_rec= group_hash->find(group_buff, hash)))
+    {						/* Update old group */
+      memcpy(table->record[0], group_rec, table->s->reclength);
+      update_tmptable_sum_func(join->sum_funcs, table);
+      memcpy(group_rec, table->record[0], table->s->reclength);
+      goto end;
+    }
+    if (!(group_rec= group_hash->insert(group_buff, hash)))
+    {
+      /* Out of hash table memory: continue in the temporary table */
+      if (flush_group_hash(join_tab))
+        DBUG_RETURN(NESTED_LOOP_ERROR);
+      copy_fields(join_tab->tmp_table_param);   // Overwritten by the flush
+    }
+  }
+  else if (!table->file->ha_index_read_map(table->record[1], group_buff,
+                                           HA_WHOLE_KEY, HA_READ_KEY_EXACT))
   {						/* Update old record */
     restore_record(table,record[1]);
     update_tmptable_sum_func(join->sum_funcs,table);
@@ -23079,7 +23279,9 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
   if (unlikely(copy_funcs(join_tab->tmp_table_param->items_to_copy,
                           join->thd)))
     DBUG_RETURN(NESTED_LOOP_ERROR);           /* purecov: inspected */
-  if (unlikely((error= table->file->ha_write_tmp_row(table->record[0]))))
+  if (group_rec)
+    memcpy(group_rec, table->record[0], table->s->reclength);
+  else if (unlikely((error= table->file->ha_write_tmp_row(table->record[0]))))
   {
     if (create_internal_tmp_table_from_heap(join->thd, table,
                                        join_tab->tmp_table_param->start_recinfo,
@@ -27533,6 +27735,9 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
     erf->quick= quick->get_explain(thd->mem_root);
     erf->selectivity= range_rowid_filter_info->selectivity;
     erf->rows= quick->records;
+    erf->container=
+      rowid_filter->get_container()->get_type() == BLOOM_FILTER_CONTAINER ?
+      "bloom_filter" : NULL;
     if (!(erf->tracker= new Rowid_filter_tracker(thd->lex->analyze_stmt)))
       return 1;
     rowid_filter->set_tracker(erf->tracker);
@@ -29843,7 +30048,11 @@ AGGR_OP::prepare_tmp_table()
   /* If it wasn't already, start index scan for grouping using table index. */
   if (!table->file->inited && table->group &&
       join_tab->tmp_table_param->sum_func_count && table->s->keys)
+  {
+    if (write_func == end_update)
+      init_group_hash();
     rc= table->file->ha_index_init(0, 0);
+  }
   else
   {
     /* Start index scan in scanning mode */
@@ -29858,6 +30067,33 @@ AGGR_OP::prepare_tmp_table()
 }
 
 
+/**
+  @brief Create or empty the hash table of groups used by end_update()
+
+  @details
+  The hash table is used when group_by_hash_buffer_size is nonzero and the
+  rows of the temporary table can be copied as they are, that is, they
+  have no blobs. If it cannot be allocated, the groups are looked up in
+  the temporary table as usual.
+*/
+
+void AGGR_OP::init_group_hash()
+{
+  TABLE *table= join_tab->table;
+  THD *thd= join_tab->join->thd;
+
+  if (group_hash)
+    group_hash->clear();
+  else if (thd->variables.group_by_hash_buffer_size &&
+           !table->s->uniques && !table->s->blob_fields)
+    group_hash= new (std::nothrow)
+      Group_by_hash(table->key_info, join_tab->tmp_table_param->group_length,
+                    table->s->reclength,
+                    (size_t) MY_MIN(thd->variables.group_by_hash_buffer_size,
+                                    SIZE_T_MAX));
+}
+
+
 /**
   @brief Prepare table if necessary and call write_func to save record
 
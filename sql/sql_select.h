@@ -33,6 +33,7 @@
 #include "records.h"                          /* READ_RECORD */
 #include "opt_range.h"                /* SQL_SELECT, QUICK_SELECT_I */
 #include "filesort.h"
+#include "group_by_hash.h"
 
 typedef struct st_join_table JOIN_TAB;
 /* Values in optimize */
@@ -249,6 +250,7 @@ class AGGR_OP;
 class Filesort;
 struct SplM_plan_info;
 class SplM_opt_info;
+class Record_filter;
 
 typedef struct st_join_table {
   TABLE		*table;
@@ -404,6 +406,11 @@ typedef struct st_join_table {
   */
   Item          *cache_idx_cond;
   SQL_SELECT    *cache_select;
+  /*
+    The condition checking the join key of a record against the Bloom filter
+    of the BNLH join cache, until it is attached to the scan of the table
+  */
+  Item          *join_filter;
   AGGR_OP       *aggr;
   JOIN		*join;
   /*
@@ -534,6 +541,17 @@ typedef struct st_join_table {
 
   void build_range_rowid_filter_if_needed();
 
+  /*
+    The filter that evaluates select_cond on the records of the table, or
+    NULL if select_cond is evaluated with val_int(). The filter is built at
+    the first evaluation of record_filter_cond, so it is rebuilt if
+    select_cond is changed.
+  */
+  Record_filter *record_filter;
+  Item *record_filter_cond;
+
+  void build_record_filter();
+
   void cleanup();
   inline bool is_using_loose_index_scan()
   {
@@ -634,6 +652,8 @@ typedef struct st_join_table {
   double get_partial_join_cardinality() { return partial_join_cardinality; }
   bool hash_join_is_possible();
   int make_scan_filter();
+  void make_join_filter();
+  bool attach_join_filter();
   bool is_ref_for_hash_join() { return is_hash_join_key_no(ref.key); }
   KEY *get_keyinfo_by_key_no(uint key) 
   {
@@ -1043,7 +1063,8 @@ class Pushdown_query;
                          records are expected to be sorted.
       end_update         Perform grouping using the key generated on tmp
                          table. Input records aren't expected to be sorted.
-                         Tmp table uses the heap engine
+                         Tmp table uses the heap engine. The groups may
+                         be accumulated in group_hash first.
       end_update_unique  Same as above, but the engine is myisam.
 
     Lazy table initialization is used - the table will be instantiated and
@@ -1056,7 +1077,10 @@ class AGGR_OP :public Sql_alloc
 public:
   JOIN_TAB *join_tab;
 
-  AGGR_OP(JOIN_TAB *tab) : join_tab(tab), write_func(NULL)
+  /** Hash table of the groups for end_update(), NULL if not used */
+  Group_by_hash *group_hash;
+
+  AGGR_OP(JOIN_TAB *tab) : join_tab(tab), group_hash(NULL), write_func(NULL)
   {};
 
   enum_nested_loop_state put_record() { return put_record(false); };
@@ -1072,12 +1096,18 @@ class AGGR_OP :public Sql_alloc
   {
     write_func= new_write_func;
   }
+  void free_group_hash()
+  {
+    delete group_hash;
+    group_hash= NULL;
+  }
 
 private:
   /** Write function that would be used for saving records in tmp table. */
   Next_select_func write_func;
   enum_nested_loop_state put_record(bool end_of_records);
   bool prepare_tmp_table();
+  void init_group_hash();
 };
 
 
@@ -565,6 +565,9 @@ class Sort_param {
   uchar *unique_buff;
   bool not_killable;
   String tmp_buffer;
+  uint sort_threads;          // Max threads for sorting one buffer
+  uint sort_threads_used;     // Max threads that were used, 0 if none
+  ulonglong sort_cycles;      // Timer cycles spent in sort_buffer()
   // The fields below are used only by Unique class.
   qsort2_cmp compare;
   BUFFPEK_COMPARE_CONTEXT cmp_context;
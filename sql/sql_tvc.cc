@@ -23,6 +23,7 @@
 #include "sql_parse.h"
 #include "sql_cte.h"
 #include "my_json_writer.h"
+#include <algorithm>
 
 
 /**
@@ -535,6 +536,73 @@ void table_value_constr::print(THD *thd, String *str,
 }
 
 
+/**
+  @brief
+    Find the values of an IN list of integer constants equal to a previous one
+
+  @param thd       The context of the statement
+  @param values    The values of the IN list
+  @param n_values  The number of the values
+
+  @details
+    The long IN lists generated by applications often contain duplicates,
+    and every one of them would become a row of the TVC that is
+    materialized and joined with. The values are sorted by value and by
+    position, and all the values of a run of equal ones but the first are
+    marked as duplicates.
+
+  @retval
+    an array of n_values flags, true for the duplicates
+  @retval
+    NULL if some value is not an integer constant, or out of memory
+*/
+
+static bool *find_duplicate_int_values(THD *thd, Item **values, uint n_values)
+{
+  struct Int_value
+  {
+    longlong value;
+    bool unsigned_flag;
+    uint pos;
+  };
+  Int_value *sorted= (Int_value*) thd->alloc(n_values * sizeof(Int_value));
+  bool *is_duplicate= (bool*) thd->calloc(n_values * sizeof(bool));
+  if (!sorted || !is_duplicate)
+    return NULL;
+
+  for (uint i= 0; i < n_values; i++)
+  {
+    Item *item= values[i];
+    if (!item->basic_const_item() || item->type() == Item::PARAM_ITEM ||
+        item->cmp_type() != INT_RESULT)
+      return NULL;
+    sorted[i].value= item->val_int();
+    if (item->null_value)
+      return NULL;
+    sorted[i].unsigned_flag= item->unsigned_flag;
+    sorted[i].pos= i;
+  }
+
+  auto cmp= [](const Int_value &a, const Int_value &b)
+  {
+    return Longlong_hybrid(a.value, a.unsigned_flag).
+             cmp(Longlong_hybrid(b.value, b.unsigned_flag));
+  };
+  std::sort(sorted, sorted + n_values,
+            [&cmp](const Int_value &a, const Int_value &b)
+            {
+              int res= cmp(a, b);
+              return res < 0 || (res == 0 && a.pos < b.pos);
+            });
+  for (uint i= 1; i < n_values; i++)
+  {
+    if (!cmp(sorted[i - 1], sorted[i]))
+      is_duplicate[sorted[i].pos]= true;
+  }
+  return is_duplicate;
+}
+
+
 /**
   @brief
     Create list of lists for TVC from the list of this IN predicate
@@ -554,6 +622,11 @@ void table_value_constr::print(THD *thd, String *str,
     <value_list> = (5,2),(7,1)
     <transformed_value_list> = (5,2),(7,1)
 
+    The duplicates of a list of integer constants are skipped:
+
+    <value_list> = 5,2,5
+    <transformed_value_list> = (5),(2)
+
   @retval
     false     if the method succeeds
     true      otherwise
@@ -563,11 +636,17 @@ bool Item_func_in::create_value_list_for_tvc(THD *thd,
 				             List< List<Item> > *values)
 {
   bool is_list_of_rows= args[1]->type() == Item::ROW_ITEM;
+  bool *is_duplicate= NULL;
+
+  if (!is_list_of_rows && m_comparator.cmp_type() == INT_RESULT)
+    is_duplicate= find_duplicate_int_values(thd, args + 1, arg_count - 1);
 
   for (uint i=1; i < arg_count; i++)
   {
     char col_name[8];
     List<Item> *tvc_value;
+    if (is_duplicate && is_duplicate[i - 1])
+      continue;
     if (!(tvc_value= new (thd->mem_root) List<Item>()))
       return true;
 
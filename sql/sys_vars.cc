@@ -61,6 +61,7 @@
 #include "threadpool.h"
 #include "sql_repl.h"
 #include "opt_range.h"
+#include "filesort_utils.h"                     // MAX_SORT_THREADS
 #include "rpl_parallel.h"
 #include "semisync_master.h"
 #include "semisync_slave.h"
@@ -3666,6 +3667,16 @@ static Sys_var_ulonglong Sys_sort_buffer(
        VALID_RANGE(MIN_SORT_MEMORY, SIZE_T_MAX), DEFAULT(MAX_SORT_MEMORY),
        BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_sort_parallel_threads(
+       "sort_parallel_threads",
+       "Maximum number of threads that may be used for sorting one "
+       "sort_buffer_size buffer in ORDER BY or GROUP BY. 1 means that "
+       "sorting is done by the connection thread only. With more than 1, "
+       "each row reserves one more pointer in the sort buffer for merging "
+       "the sorted parts, so fewer rows fit in sort_buffer_size",
+       SESSION_VAR(sort_parallel_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_SORT_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
 export sql_mode_t expand_sql_mode(sql_mode_t sql_mode)
 {
   if (sql_mode & MODE_ANSI)
@@ -4900,6 +4911,23 @@ static Sys_var_uint Sys_group_concat_max_len(
        SESSION_VAR(group_concat_max_len), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(4, UINT_MAX32), DEFAULT(1024*1024), BLOCK_SIZE(1));
 
+static Sys_var_ulonglong Sys_group_by_hash_buffer_size(
+       "group_by_hash_buffer_size",
+       "Size of the in-memory hash table that GROUP BY uses to accumulate "
+       "groups before writing them to an internal temporary table. When the "
+       "groups no longer fit, they are written to the temporary table and "
+       "the aggregation continues there. 0 disables the hash table",
+       SESSION_VAR(group_by_hash_buffer_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, SIZE_T_MAX), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_mybool Sys_where_record_filter(
+       "where_record_filter",
+       "Evaluate the comparisons of integer and floating point columns with "
+       "constants in the conditions attached to the tables of a join "
+       "directly on the records read, before the rest of the condition",
+       SESSION_VAR(where_record_filter), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static char *glob_hostname_ptr;
 static Sys_var_charptr Sys_hostname(
        "hostname", "Server host name",
@@ -6853,3 +6881,12 @@ static Sys_var_ulonglong Sys_max_rowid_filter_size(
        SESSION_VAR(max_rowid_filter_size), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(1024, (ulonglong)~(intptr)0), DEFAULT(128*1024),
        BLOCK_SIZE(1));
+
+static Sys_var_mybool Sys_optimizer_bloom_filters(
+       "optimizer_bloom_filters",
+       "Use Bloom filters as the containers of the range rowid filters that "
+       "are too large for max_rowid_filter_size, and to filter the records "
+       "of a table joined with a hashed join buffer by the join keys in "
+       "the buffer",
+       SESSION_VAR(optimizer_bloom_filters), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
@@ -560,6 +560,14 @@ btr_pcur_move_to_next_page(
 
 	const auto s = mtr->get_savepoint();
 	mtr->rollback_to_savepoint(s - 2, s - 1);
+
+	if (srv_read_ahead_leaf_pages && page_is_leaf(next_page)
+	    && cursor->index()->is_btree()) {
+		buf_read_ahead_leaf(cursor->index(), next_block->page.id(),
+				    btr_page_get_next(next_page),
+				    next_block->zip_size());
+	}
+
 	return DB_SUCCESS;
 }
 
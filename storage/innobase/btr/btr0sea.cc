@@ -258,6 +258,10 @@ void btr_search_disable()
 
 	dict_sys.unfreeze();
 
+	/* Wait for btr_search_guess_optimistic() to stop accessing
+	the hash tables and the blocks. */
+	btr_search_sys.wait_for_readers();
+
 	/* Set all block->index = NULL. */
 	buf_pool.clear_hash_index();
 
@@ -936,6 +940,7 @@ void
 btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
 {
 	cursor->flag = BTR_CUR_HASH_FAIL;
+	info->n_hash.get().misses.fetch_add(1);
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	++info->n_hash_fail;
@@ -1022,14 +1027,158 @@ inline buf_block_t* buf_pool_t::block_from_ahi(const byte *ptr) const
   /* buf_pool_t::chunk_t::init() invokes buf_block_init() so that
   block[n].frame == block->page.frame + n * srv_page_size.  Check it. */
   ut_ad(block->page.frame == page_align(ptr));
-  /* Read the state of the block without holding hash_lock.
-  A state transition to REMOVE_HASH is possible during
-  this execution. */
-  ut_ad(block->page.state() >= buf_page_t::REMOVE_HASH);
-
+  /* The state of the block is not checked here, because
+  btr_search_guess_optimistic() may invoke this on a pointer
+  that was removed from the adaptive hash index concurrently. */
   return block;
 }
 
+/** Try to latch the page that contains a record that was found in the
+adaptive hash index.
+@param rec         record
+@param latch_mode  BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@return the latched block
+@retval nullptr if the page could not be latched without waiting */
+TRANSACTIONAL_TARGET
+static buf_block_t *btr_search_latch_block(const rec_t *rec, ulint latch_mode)
+{
+  buf_block_t *block= buf_pool.block_from_ahi(rec);
+  buf_pool_t::hash_chain &chain=
+    buf_pool.page_hash.cell_get(block->page.id().fold());
+  bool got_latch;
+  {
+    transactional_shared_lock_guard<page_hash_latch> g
+      {buf_pool.page_hash.lock_get(chain)};
+    got_latch= latch_mode == BTR_SEARCH_LEAF
+      ? block->page.lock.s_lock_try()
+      : block->page.lock.x_lock_try();
+  }
+  return got_latch ? block : nullptr;
+}
+
+/** Release a latch that was acquired by btr_search_latch_block().
+@param block       the latched block
+@param latch_mode  BTR_SEARCH_LEAF or BTR_MODIFY_LEAF */
+static void btr_search_unlatch_block(buf_block_t *block, ulint latch_mode)
+{
+  if (latch_mode == BTR_SEARCH_LEAF)
+    block->page.lock.s_unlock();
+  else
+    block->page.lock.x_unlock();
+}
+
+/** Buffer-fix a block that was latched by btr_search_latch_block(),
+while the adaptive hash index still points to it.
+@param block       the latched block
+@param index       the index that is being searched
+@param latch_mode  BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@return whether the block was buffer-fixed; if not, it was unlatched */
+static bool btr_search_fix_block(buf_block_t *block, const dict_index_t *index,
+                                 ulint latch_mode)
+{
+  const auto state= block->page.state();
+  if (UNIV_UNLIKELY(state < buf_page_t::UNFIXED))
+  {
+    ut_ad(state == buf_page_t::REMOVE_HASH);
+  fail:
+    btr_search_unlatch_block(block, latch_mode);
+    return false;
+  }
+
+  ut_ad(state < buf_page_t::READ_FIX || state >= buf_page_t::WRITE_FIX);
+  ut_ad(state < buf_page_t::READ_FIX || latch_mode == BTR_SEARCH_LEAF);
+
+  if (index != block->index && index->id == block->index->id)
+  {
+    ut_a(block->index->freed());
+    goto fail;
+  }
+
+  block->page.fix();
+  block->page.set_accessed();
+  buf_page_make_young_if_needed(&block->page);
+  return true;
+}
+
+/** Outcome of btr_search_guess_optimistic() */
+enum btr_search_optimistic_t
+{
+  /** a record was found and its page was latched and buffer-fixed */
+  BTR_SEARCH_OPTIMISTIC_HIT,
+  /** no record was found, or its page could not be latched */
+  BTR_SEARCH_OPTIMISTIC_MISS,
+  /** the partition was being modified; the partition latch is needed */
+  BTR_SEARCH_OPTIMISTIC_RETRY
+};
+
+/** Search an adaptive hash index partition without acquiring its latch.
+Every pointer that was read from the partition is validated against the
+version of the partition before it is dereferenced. The memory stays
+valid, because the hash table and its heap are only freed by
+btr_search_disable() after btr_search_sys_t::wait_for_readers(), and
+blocks of the heap are returned to the buffer pool, which only shrinks
+after btr_search_disable().
+@param part        adaptive hash index partition
+@param fold        folded value of the search tuple
+@param index       the index that is being searched
+@param latch_mode  BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@param rec         the found record
+@param block       the latched and buffer-fixed block that contains rec
+@return the outcome of the search */
+static btr_search_optimistic_t
+btr_search_guess_optimistic(btr_search_sys_t::partition *part, ulint fold,
+                            const dict_index_t *index, ulint latch_mode,
+                            const rec_t *&rec, buf_block_t *&block)
+{
+  size_t slot;
+  const uint32_t version= btr_search_sys.reader_enter(*part, slot);
+  btr_search_optimistic_t result= BTR_SEARCH_OPTIMISTIC_RETRY;
+
+  if (version & 1);
+  else if (!btr_search_enabled)
+    result= BTR_SEARCH_OPTIMISTIC_MISS;
+  else
+  {
+    const ulint n_cells= part->table.n_cells;
+    const hash_cell_t *array= part->table.array;
+    if (!part->latch.validate(version))
+      goto func_exit;
+    const ha_node_t *node= static_cast<const ha_node_t*>
+      (array[ut_hash_ulint(fold, n_cells)].node);
+    for (;;)
+    {
+      if (!part->latch.validate(version))
+        goto func_exit;
+      if (!node)
+      {
+        result= BTR_SEARCH_OPTIMISTIC_MISS;
+        goto func_exit;
+      }
+      if (node->fold == fold)
+        break;
+      node= node->next;
+    }
+
+    rec= node->data;
+    if (!part->latch.validate(version))
+      goto func_exit;
+
+    block= btr_search_latch_block(rec, latch_mode);
+    if (!block)
+      result= BTR_SEARCH_OPTIMISTIC_MISS;
+    else if (!part->latch.validate(version))
+      /* The block may no longer contain rec. */
+      btr_search_unlatch_block(block, latch_mode);
+    else
+      result= btr_search_fix_block(block, index, latch_mode)
+        ? BTR_SEARCH_OPTIMISTIC_HIT : BTR_SEARCH_OPTIMISTIC_MISS;
+  }
+
+func_exit:
+  btr_search_sys.reader_exit(slot);
+  return result;
+}
+
 /** Tries to guess the right search position based on the hash search info
 of the index. Note that if mode is PAGE_CUR_LE, which is used in inserts,
 and the function returns TRUE, then cursor->up_match and cursor->low_match
@@ -1094,71 +1243,46 @@ btr_search_guess_on_hash(
 
 	auto part = btr_search_sys.get_part(*index);
 	const rec_t* rec;
+	buf_block_t* block;
 
-	part->latch.rd_lock(SRW_LOCK_CALL);
-
-	if (!btr_search_enabled) {
-		goto ahi_release_and_fail;
-	}
+	switch (btr_search_guess_optimistic(part, fold, index, latch_mode,
+					    rec, block)) {
+	case BTR_SEARCH_OPTIMISTIC_HIT:
+		break;
+	case BTR_SEARCH_OPTIMISTIC_MISS:
+		goto fail;
+	case BTR_SEARCH_OPTIMISTIC_RETRY:
+		info->n_hash.get().retries.fetch_add(1);
 
-	rec = static_cast<const rec_t*>(
-		ha_search_and_get_data(&part->table, fold));
+		part->latch.rd_lock(SRW_LOCK_CALL);
 
-	if (!rec) {
-ahi_release_and_fail:
-		part->latch.rd_unlock();
-fail:
-		btr_search_failure(info, cursor);
-		return false;
-	}
+		if (!btr_search_enabled) {
+			goto ahi_release_and_fail;
+		}
 
-	buf_block_t* block = buf_pool.block_from_ahi(rec);
+		rec = static_cast<const rec_t*>(
+			ha_search_and_get_data(&part->table, fold));
 
-	buf_pool_t::hash_chain& chain = buf_pool.page_hash.cell_get(
-		block->page.id().fold());
-	bool got_latch;
-	{
-		transactional_shared_lock_guard<page_hash_latch> g{
-			buf_pool.page_hash.lock_get(chain)};
-		got_latch = (latch_mode == BTR_SEARCH_LEAF)
-			? block->page.lock.s_lock_try()
-			: block->page.lock.x_lock_try();
-	}
+		if (!rec) {
+ahi_release_and_fail:
+			part->latch.rd_unlock();
+			goto fail;
+		}
 
-	if (!got_latch) {
-		goto ahi_release_and_fail;
-	}
+		block = btr_search_latch_block(rec, latch_mode);
 
-	const auto state = block->page.state();
-	if (UNIV_UNLIKELY(state < buf_page_t::UNFIXED)) {
-		ut_ad(state == buf_page_t::REMOVE_HASH);
-block_and_ahi_release_and_fail:
-		if (latch_mode == BTR_SEARCH_LEAF) {
-			block->page.lock.s_unlock();
-		} else {
-			block->page.lock.x_unlock();
+		if (!block || !btr_search_fix_block(block, index, latch_mode)) {
+			goto ahi_release_and_fail;
 		}
-		goto ahi_release_and_fail;
-	}
 
-	ut_ad(state < buf_page_t::READ_FIX || state >= buf_page_t::WRITE_FIX);
-	ut_ad(state < buf_page_t::READ_FIX || latch_mode == BTR_SEARCH_LEAF);
-
-	if (index != block->index && index_id == block->index->id) {
-		ut_a(block->index->freed());
-		goto block_and_ahi_release_and_fail;
+		part->latch.rd_unlock();
 	}
 
-	block->page.fix();
-	block->page.set_accessed();
-	buf_page_make_young_if_needed(&block->page);
 	static_assert(ulint{MTR_MEMO_PAGE_S_FIX} == ulint{BTR_SEARCH_LEAF},
 		      "");
 	static_assert(ulint{MTR_MEMO_PAGE_X_FIX} == ulint{BTR_MODIFY_LEAF},
 		      "");
 
-	part->latch.rd_unlock();
-
 	++buf_pool.stat.n_page_gets;
 
 	mtr->memo_push(block, mtr_memo_type_t(latch_mode));
@@ -1177,7 +1301,9 @@ btr_search_guess_on_hash(
 	if (index_id != btr_page_get_index_id(block->page.frame)
 	    || !btr_search_check_guess(cursor, false, tuple, mode)) {
 		mtr->release_last_page();
-		goto fail;
+fail:
+		btr_search_failure(info, cursor);
+		return false;
 	}
 
 	if (info->n_hash_potential < BTR_SEARCH_BUILD_LIMIT + 5) {
@@ -1186,6 +1312,7 @@ btr_search_guess_on_hash(
 	}
 
 	info->last_hash_succ = TRUE;
+	info->n_hash.get().hits.fetch_add(1);
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
@@ -1444,7 +1571,7 @@ void
 btr_search_build_page_hash_index(
 	dict_index_t*	index,
 	buf_block_t*	block,
-	srw_spin_lock*	ahi_latch,
+	btr_search_latch_t*	ahi_latch,
 	uint16_t	n_fields,
 	uint16_t	n_bytes,
 	bool		left_side)
@@ -1642,7 +1769,7 @@ btr_search_build_page_hash_index(
 @param[in,out]	cursor	cursor which was just positioned */
 void btr_search_info_update_slow(btr_search_t *info, btr_cur_t *cursor)
 {
-	srw_spin_lock*	ahi_latch = &btr_search_sys.get_part(*cursor->index())
+	btr_search_latch_t*	ahi_latch = &btr_search_sys.get_part(*cursor->index())
 		->latch;
 	buf_block_t*	block = btr_cur_get_block(cursor);
 
@@ -1709,7 +1836,7 @@ btr_search_move_or_delete_hash_entries(
 	assert_block_ahi_valid(block);
 	assert_block_ahi_valid(new_block);
 
-	srw_spin_lock* ahi_latch = index
+	btr_search_latch_t* ahi_latch = index
 		? &btr_search_sys.get_part(*index)->latch
 		: nullptr;
 
@@ -1835,7 +1962,7 @@ void btr_search_update_hash_on_delete(btr_cur_t *cursor)
 			inserted next to the cursor.
 @param[in]	ahi_latch	the adaptive hash index latch */
 void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
-                                           srw_spin_lock *ahi_latch)
+                                           btr_search_latch_t *ahi_latch)
 {
 	buf_block_t*	block;
 	dict_index_t*	index;
@@ -1911,7 +2038,7 @@ void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
 				to the cursor
 @param[in]	ahi_latch	the adaptive hash index latch */
 void btr_search_update_hash_on_insert(btr_cur_t *cursor,
-                                      srw_spin_lock *ahi_latch)
+                                      btr_search_latch_t *ahi_latch)
 {
 	buf_block_t*	block;
 	dict_index_t*	index;
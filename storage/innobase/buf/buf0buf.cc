@@ -1155,6 +1155,8 @@ void buf_pool_t::close()
 
   ut_free(chunks);
   chunks= nullptr;
+  ut_free(LRU_ghosts);
+  LRU_ghosts= nullptr;
   page_hash.free();
   zip_hash.free();
 
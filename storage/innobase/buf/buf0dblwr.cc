@@ -39,6 +39,26 @@ using st_::span;
 /** The doublewrite buffer */
 buf_dblwr_t buf_dblwr;
 
+/** @name Header of a batch that was written with innodb_doublewrite_compact=ON.
+It is located in the first page of the doublewrite buffer and followed by
+the payload of each page, in the order of the directory entries. The
+FIL_PAGE_LSN of the header is 0, so that it will never be mistaken
+for a page. @{ */
+/** identifier of the format */
+static const byte DBLWR_COMPACT_MAGIC[8]= {'I','b','D','b','l','w','r','C'};
+/** number of pages in the batch (4 bytes) */
+static constexpr size_t DBLWR_COMPACT_N= 8;
+/** total length of the payload (4 bytes) */
+static constexpr size_t DBLWR_COMPACT_LEN= 12;
+/** CRC-32C of the directory and the payload (4 bytes) */
+static constexpr size_t DBLWR_COMPACT_CRC= FIL_PAGE_LSN + 8;
+/** the directory: tablespace identifier, page number and payload size
+(4 bytes each) of each page */
+static constexpr size_t DBLWR_COMPACT_DIR= DBLWR_COMPACT_CRC + 4;
+/** size of a directory entry */
+static constexpr size_t DBLWR_COMPACT_ENTRY= 12;
+/* @} */
+
 /** @return the TRX_SYS page */
 inline buf_block_t *buf_dblwr_trx_sys_get(mtr_t *mtr)
 {
@@ -336,15 +356,68 @@ dberr_t buf_dblwr_t::init_or_load_pages(pfs_os_file_t file, const char *path)
     os_file_flush(file);
   }
   else
-    for (ulint i= 0; i < size * 2; i++, page += srv_page_size)
+  {
+    ulint n_pages= size * 2;
+    if (!memcmp(page, DBLWR_COMPACT_MAGIC, sizeof DBLWR_COMPACT_MAGIC))
+      n_pages= expand_compact(write_buf, n_pages);
+    for (ulint i= 0; i < n_pages; i++, page += srv_page_size)
       if (mach_read_from_8(my_assume_aligned<8>(page + FIL_PAGE_LSN)))
         /* Each valid page header must contain a nonzero FIL_PAGE_LSN field. */
         recv_sys.dblwr.add(page);
+  }
 
   err= DB_SUCCESS;
   goto func_exit;
 }
 
+/** Convert a batch that was written with innodb_doublewrite_compact=ON
+to one page per slot.
+@param buf      contents of the doublewrite buffer
+@param n_slots  size of buf in pages
+@return number of pages in buf
+@retval 0 if the batch is incomplete or corrupted */
+ulint buf_dblwr_t::expand_compact(byte *buf, ulint n_slots)
+{
+  const ulint n_pages= mach_read_from_4(buf + DBLWR_COMPACT_N);
+  const size_t len= mach_read_from_4(buf + DBLWR_COMPACT_LEN);
+  const size_t dir_len= n_pages * DBLWR_COMPACT_ENTRY;
+
+  if (n_pages >= n_slots || DBLWR_COMPACT_DIR + dir_len > srv_page_size ||
+      len > (n_slots - 1) << srv_page_size_shift ||
+      mach_read_from_4(buf + DBLWR_COMPACT_CRC) !=
+      my_crc32c(my_crc32c(0, buf + DBLWR_COMPACT_DIR, dir_len),
+                buf + srv_page_size, len))
+  {
+    /* The batch was not completely written. Because the data pages
+    are only written after the doublewrite buffer has been made durable,
+    they cannot be torn. */
+    ib::info() << "Ignoring an incomplete compact doublewrite batch";
+    return 0;
+  }
+
+  byte *pages= static_cast<byte*>(aligned_malloc(n_pages << srv_page_size_shift,
+                                                 srv_page_size));
+  memset_aligned<4096>(pages, 0, n_pages << srv_page_size_shift);
+
+  const byte *entry= buf + DBLWR_COMPACT_DIR;
+  const byte *payload= buf + srv_page_size;
+  for (ulint i= 0; i < n_pages; i++, entry+= DBLWR_COMPACT_ENTRY)
+  {
+    const size_t psize= mach_read_from_4(entry + 8);
+    if (psize > srv_page_size || payload + psize > buf + srv_page_size + len)
+      break;
+    byte *page= pages + (i << srv_page_size_shift);
+    if (page_get_space_id(payload) == mach_read_from_4(entry) &&
+        page_get_page_no(payload) == mach_read_from_4(entry + 4))
+      memcpy(page, payload, psize);
+    payload+= psize;
+  }
+
+  memcpy_aligned<4096>(buf, pages, n_pages << srv_page_size_shift);
+  aligned_free(pages);
+  return n_pages;
+}
+
 /** Process and remove the double write buffer pages for all tablespaces. */
 void buf_dblwr_t::recover()
 {
@@ -506,6 +579,7 @@ void buf_dblwr_t::write_completed(bool with_doublewrite)
 
       /* We can now reuse the doublewrite memory buffer: */
       flush_slot->first_free= 0;
+      flush_slot->used= 0;
       batch_running= false;
       pthread_cond_broadcast(&cond);
     }
@@ -575,6 +649,67 @@ static void buf_dblwr_check_block(const buf_page_t *bpage)
 }
 #endif /* UNIV_DEBUG */
 
+size_t buf_dblwr_t::prepare_batch(slot *s, byte *&buf)
+{
+  buf= s->write_buf;
+  if (!srv_doublewrite_compact)
+    return s->first_free << srv_page_size_shift;
+
+  /* Round up to a multiple of the page size, so that the request
+  will be compatible with O_DIRECT. */
+  const size_t length= (srv_page_size + s->used + srv_page_size - 1) &
+    ~(srv_page_size - 1);
+
+  if (length > s->first_free << srv_page_size_shift)
+  {
+    /* Only page_compressed and ROW_FORMAT=COMPRESSED pages are shorter
+    than srv_page_size. A batch that does not contain enough of them
+    would become longer due to the header page. Write it in the format
+    of innodb_doublewrite_compact=OFF, starting after the header page.
+    No payload needs to move towards a lower address, so we can move
+    them in place, starting from the last page. */
+    buf+= srv_page_size;
+    size_t offset= s->used;
+    for (ulint i= s->first_free; i--; )
+    {
+      const size_t size= s->buf_block_arr[i].size;
+      offset-= size;
+      byte *page= buf + (i << srv_page_size_shift);
+      ut_ad(page >= buf + offset);
+      if (page != buf + offset)
+        memmove(page, buf + offset, size);
+      memset(page + size, 0, srv_page_size - size);
+      if (page == buf + offset)
+        /* All preceding pages are of full size and in place. */
+        break;
+    }
+    return s->first_free << srv_page_size_shift;
+  }
+
+  batches_compact++;
+  byte *header= s->write_buf;
+  memset_aligned<4096>(header, 0, srv_page_size);
+  memcpy(header, DBLWR_COMPACT_MAGIC, sizeof DBLWR_COMPACT_MAGIC);
+  mach_write_to_4(header + DBLWR_COMPACT_N, s->first_free);
+  mach_write_to_4(header + DBLWR_COMPACT_LEN, s->used);
+
+  byte *entry= header + DBLWR_COMPACT_DIR;
+  for (ulint i= 0; i < s->first_free; i++, entry+= DBLWR_COMPACT_ENTRY)
+  {
+    const element &e= s->buf_block_arr[i];
+    mach_write_to_4(entry, e.request.bpage->id().space());
+    mach_write_to_4(entry + 4, e.request.bpage->id().page_no());
+    mach_write_to_4(entry + 8, e.size);
+  }
+
+  mach_write_to_4(header + DBLWR_COMPACT_CRC,
+                  my_crc32c(my_crc32c(0, header + DBLWR_COMPACT_DIR,
+                                      size_t(entry - header) -
+                                      DBLWR_COMPACT_DIR),
+                            header + srv_page_size, s->used));
+  return length;
+}
+
 bool buf_dblwr_t::flush_buffered_writes(const ulint size)
 {
   mysql_mutex_assert_owner(&mutex);
@@ -599,9 +734,10 @@ bool buf_dblwr_t::flush_buffered_writes(const ulint size)
   ut_a(active_slot->first_free == 0);
   batch_running= true;
   const ulint old_first_free= flush_slot->first_free;
-  auto write_buf= flush_slot->write_buf;
+  byte *write_buf;
+  const size_t length= prepare_batch(flush_slot, write_buf);
   const bool multi_batch= block1 + static_cast<uint32_t>(size) != block2 &&
-    old_first_free > size;
+    length > size << srv_page_size_shift;
   flushing_buffered_writes= 1 + multi_batch;
   pages_submitted+= old_first_free;
   /* Now safe to release the mutex. */
@@ -618,7 +754,8 @@ bool buf_dblwr_t::flush_buffered_writes(const ulint size)
     /* Check that the actual page in the buffer pool is not corrupt
     and the LSN values are sane. */
     buf_dblwr_check_block(bpage);
-    ut_d(buf_dblwr_check_page_lsn(*bpage, write_buf + len2));
+    if (write_buf != flush_slot->write_buf || !srv_doublewrite_compact)
+      buf_dblwr_check_page_lsn(*bpage, write_buf + len2);
   }
 #endif /* UNIV_DEBUG */
   const IORequest request{nullptr, nullptr, fil_system.sys_space->chain.start,
@@ -632,12 +769,11 @@ bool buf_dblwr_t::flush_buffered_writes(const ulint size)
            size << srv_page_size_shift);
     os_aio(request, write_buf + (size << srv_page_size_shift),
            os_offset_t{block2.page_no()} << srv_page_size_shift,
-           (old_first_free - size) << srv_page_size_shift);
+           length - (size << srv_page_size_shift));
   }
   else
     os_aio(request, write_buf,
-           os_offset_t{block1.page_no()} << srv_page_size_shift,
-           old_first_free << srv_page_size_shift);
+           os_offset_t{block1.page_no()} << srv_page_size_shift, length);
   return true;
 }
 
@@ -733,6 +869,17 @@ void buf_dblwr_t::flush_buffered_writes()
     mysql_mutex_unlock(&mutex);
 }
 
+inline bool buf_dblwr_t::is_full(size_t size) const
+{
+  const ulint buf_size= 2 * block_size();
+  ut_ad(active_slot->first_free <= buf_size);
+  if (!srv_doublewrite_compact)
+    return active_slot->first_free == buf_size;
+  /* The first page is reserved for the batch header. */
+  return active_slot->first_free == buf_size - 1 ||
+    active_slot->used + size > (buf_size - 1) << srv_page_size_shift;
+}
+
 /** Schedule a page write. If the doublewrite memory buffer is full,
 flush_buffered_writes() will be invoked to make space.
 @param request    asynchronous write request
@@ -754,27 +901,33 @@ void buf_dblwr_t::add_to_batch(const IORequest &request, size_t size)
   mysql_mutex_lock(&mutex);
   writes_pending++;
 
-  for (;;)
-  {
-    ut_ad(active_slot->first_free <= buf_size);
-    if (active_slot->first_free != buf_size)
-      break;
-
+  while (is_full(size))
     if (flush_buffered_writes(buf_size / 2))
       mysql_mutex_lock(&mutex);
-  }
 
-  byte *p= active_slot->write_buf + srv_page_size * active_slot->first_free;
-
-  /* "frame" is at least 1024-byte aligned for ROW_FORMAT=COMPRESSED pages,
-  and at least srv_page_size (4096-byte) for everything else. */
-  memcpy_aligned<UNIV_ZIP_SIZE_MIN>(p, get_frame(request), size);
-  /* fil_page_compress() for page_compressed guarantees 256-byte alignment */
-  memset_aligned<256>(p + size, 0, srv_page_size - size);
-  /* FIXME: Inform the compiler that "size" and "srv_page_size - size"
-  are integer multiples of 256, so the above can translate into simple
-  SIMD instructions. Currently, we make no such assumptions about the
-  non-pointer parameters that are passed to the _aligned templates. */
+  if (srv_doublewrite_compact)
+  {
+    /* Pack the payload after the batch header page. fil_page_compress()
+    for page_compressed guarantees 256-byte alignment of the size. */
+    ut_ad(!(size & 255));
+    byte *p= active_slot->write_buf + srv_page_size + active_slot->used;
+    memcpy_aligned<256>(p, get_frame(request), size);
+    active_slot->used+= size;
+  }
+  else
+  {
+    byte *p= active_slot->write_buf + srv_page_size * active_slot->first_free;
+
+    /* "frame" is at least 1024-byte aligned for ROW_FORMAT=COMPRESSED pages,
+    and at least srv_page_size (4096-byte) for everything else. */
+    memcpy_aligned<UNIV_ZIP_SIZE_MIN>(p, get_frame(request), size);
+    /* fil_page_compress() for page_compressed guarantees 256-byte alignment */
+    memset_aligned<256>(p + size, 0, srv_page_size - size);
+    /* FIXME: Inform the compiler that "size" and "srv_page_size - size"
+    are integer multiples of 256, so the above can translate into simple
+    SIMD instructions. Currently, we make no such assumptions about the
+    non-pointer parameters that are passed to the _aligned templates. */
+  }
   ut_ad(!request.bpage->zip_size() || request.bpage->zip_size() == size);
   ut_ad(active_slot->reserved == active_slot->first_free);
   ut_ad(active_slot->reserved < buf_size);
@@ -782,7 +935,6 @@ void buf_dblwr_t::add_to_batch(const IORequest &request, size_t size)
     element{request, size};
   active_slot->reserved= active_slot->first_free;
 
-  if (active_slot->first_free != buf_size ||
-      !flush_buffered_writes(buf_size / 2))
+  if (!is_full(0) || !flush_buffered_writes(buf_size / 2))
     mysql_mutex_unlock(&mutex);
 }
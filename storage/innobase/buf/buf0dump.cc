@@ -33,6 +33,7 @@ Created April 08, 2011 Vasil Dimov
 
 #include "buf0buf.h"
 #include "buf0dump.h"
+#include "buf0rea.h"
 #include "dict0dict.h"
 #include "os0file.h"
 #include "srv0srv.h"
@@ -40,6 +41,9 @@ Created April 08, 2011 Vasil Dimov
 #include "ut0byte.h"
 
 #include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
 
 #include "mysql/service_wsrep.h" /* wsrep_recovery */
 #include <my_service_manager.h>
@@ -223,44 +227,152 @@ static void buf_dump_generate_path(char *path, size_t path_size)
 }
 
 
-/*****************************************************************//**
-Perform a buffer pool dump into the file specified by
-innodb_buffer_pool_filename. If any errors occur then the value of
-innodb_buffer_pool_dump_status will be set accordingly, see buf_dump_status().
-The dump filename can be specified by (relative to srv_data_home):
-SET GLOBAL innodb_buffer_pool_filename='filename'; */
-static
-void
-buf_dump(
-/*=====*/
-	ibool	obey_shutdown)	/*!< in: quit if we are in a shutting down
-				state */
+/** Magic bytes at the start of a binary buffer pool dump file.
+A text dump file starts with a decimal digit. */
+static const byte BUF_DUMP_MAGIC[8]= {'I','B','_','D','U','M','P','\1'};
+
+/** Types of the sections of a binary buffer pool dump file. A section
+consists of the type byte, the 4-byte length of the payload, the payload,
+and the 4-byte CRC-32C of the payload. */
+enum buf_dump_section_t : byte
 {
-#define SHOULD_QUIT()	(SHUTTING_DOWN() && obey_shutdown)
+  /** the full list of pages */
+  BUF_DUMP_FULL= 1,
+  /** the pages added to and removed from the preceding list */
+  BUF_DUMP_DELTA= 2
+};
 
-	char	full_filename[OS_FILE_MAX_PATH];
-	char	tmp_filename[OS_FILE_MAX_PATH + sizeof "incomplete"];
-	char	now[32];
-	FILE*	f;
-	int	ret;
+/** Size of the fields around the payload of a section */
+static constexpr size_t BUF_DUMP_SECTION_OVERHEAD= 9;
 
-	buf_dump_generate_path(full_filename, sizeof(full_filename));
+/** Maximum number of BUF_DUMP_DELTA sections after BUF_DUMP_FULL */
+static constexpr ulint BUF_DUMP_MAX_DELTAS= 16;
 
-	snprintf(tmp_filename, sizeof(tmp_filename),
-		 "%s.incomplete", full_filename);
+/** The file that the previous binary dump was written to. Only accessed
+by buf_dump_load_task, which does not run concurrently with itself. */
+static struct
+{
+  /** name of the file, or empty if it is not a binary dump */
+  std::string path;
+  /** the pages that the file lists, in ascending order */
+  std::vector<page_id_t> pages;
+  /** size of the file after the previous write */
+  os_offset_t size;
+  /** number of BUF_DUMP_DELTA sections in the file */
+  ulint n_deltas;
+} buf_dump_last;
+
+/** Append a variable-length integer to a buffer.
+@param buf  buffer
+@param n    integer */
+static void buf_dump_put(std::vector<byte> &buf, uint32_t n)
+{
+  byte b[5];
+  buf.insert(buf.end(), b, b + mach_write_compressed(b, n));
+}
 
-	buf_dump_status(STATUS_INFO, "Dumping buffer pool(s) to %s",
-			full_filename);
+/** Read a variable-length integer that was written by buf_dump_put().
+@param ptr  current position; advanced past the integer
+@param end  end of the buffer
+@param n    the integer
+@return whether the integer was complete */
+static bool buf_dump_get(const byte *&ptr, const byte *end, uint32_t &n)
+{
+  if (ptr >= end)
+    return false;
+  const byte b= *ptr;
+  const size_t len= b < 0x80 ? 1 : b < 0xC0 ? 2 : b < 0xE0 ? 3 : b < 0xF0 ? 4 : 5;
+  if (size_t(end - ptr) < len)
+    return false;
+  n= mach_read_next_compressed(&ptr);
+  return true;
+}
 
+/** Encode a list of pages. For each tablespace, the tablespace identifier,
+the number of pages, the first page number and the gaps to the subsequent
+page numbers are written by buf_dump_put(), so that a dump of a large
+buffer pool takes about two bytes per page.
+@param pages  pages in ascending order
+@param buf    output buffer */
+static void buf_dump_encode(const std::vector<page_id_t> &pages,
+                            std::vector<byte> &buf)
+{
+  for (size_t i= 0; i < pages.size(); )
+  {
+    const uint32_t space_id= pages[i].space();
+    size_t end= i + 1;
+    while (end < pages.size() && pages[end].space() == space_id)
+      end++;
+    buf_dump_put(buf, space_id);
+    buf_dump_put(buf, uint32_t(end - i));
+    buf_dump_put(buf, pages[i].page_no());
+    for (i++; i < end; i++)
+      buf_dump_put(buf, pages[i].page_no() - pages[i - 1].page_no() - 1);
+  }
+}
+
+/** Decode a list of pages that was written by buf_dump_encode().
+@param ptr    start of the encoded list
+@param end    end of the encoded list
+@param pages  the decoded pages are appended here
+@return whether the list was well-formed */
+static bool buf_dump_decode(const byte *ptr, const byte *end,
+                            std::vector<page_id_t> &pages)
+{
+  while (ptr < end)
+  {
+    uint32_t space_id, n, page_no;
+    if (!buf_dump_get(ptr, end, space_id) || !buf_dump_get(ptr, end, n) ||
+        !n || !buf_dump_get(ptr, end, page_no))
+      return false;
+    for (;;)
+    {
+      pages.emplace_back(space_id, page_no);
+      if (!--n)
+        break;
+      uint32_t gap;
+      if (!buf_dump_get(ptr, end, gap) || gap >= ~page_no)
+        return false;
+      page_no+= gap + 1;
+    }
+  }
+  return true;
+}
+
+/** Write a section of a binary dump file.
+@param f        the file
+@param type     type of the section
+@param payload  contents of the section
+@return whether the write succeeded */
+static bool buf_dump_write_section(FILE *f, buf_dump_section_t type,
+                                   const std::vector<byte> &payload)
+{
+  ut_ad(payload.size() <= UINT32_MAX);
+  byte header[5], crc[4];
+  header[0]= type;
+  mach_write_to_4(header + 1, uint32_t(payload.size()));
+  mach_write_to_4(crc, my_crc32c(0, payload.data(), payload.size()));
+  return fwrite(header, sizeof header, 1, f) == 1 &&
+    (payload.empty() || fwrite(payload.data(), payload.size(), 1, f) == 1) &&
+    fwrite(crc, sizeof crc, 1, f) == 1;
+}
+
+/** Create a file for writing a buffer pool dump.
+@param path  name of the file
+@return the file
+@retval nullptr on error */
+static FILE *buf_dump_create(const char *path)
+{
+	FILE*	f;
 #ifdef _WIN32
 	/* use my_fopen() for correct permissions during bootstrap*/
-	f = my_fopen(tmp_filename, O_RDWR|O_TRUNC|O_CREAT, 0);
+	f = my_fopen(path, O_RDWR|O_TRUNC|O_CREAT, 0);
 #elif defined(__GLIBC__) || O_CLOEXEC == 0
-	f = fopen(tmp_filename, "w" STR_O_CLOEXEC);
+	f = fopen(path, "w" STR_O_CLOEXEC);
 #else
 	{
 		int	fd;
-		fd = open(tmp_filename, O_CREAT | O_TRUNC | O_CLOEXEC | O_WRONLY, 0640);
+		fd = open(path, O_CREAT | O_TRUNC | O_CLOEXEC | O_WRONLY, 0640);
 		if (fd >= 0) {
 			f = fdopen(fd, "w");
 		}
@@ -272,11 +384,217 @@ buf_dump(
 	if (f == NULL) {
 		buf_dump_status(STATUS_ERR,
 				"Cannot open '%s' for writing: %s",
+				path, strerror(errno));
+	}
+	return f;
+}
+
+/** Replace the buffer pool dump file with a completely written file.
+@param tmp_filename   the completely written file
+@param full_filename  the buffer pool dump file
+@return whether the file was replaced */
+static bool buf_dump_replace(const char *tmp_filename,
+			     const char *full_filename)
+{
+	int	ret = unlink(full_filename);
+	if (ret != 0 && errno != ENOENT) {
+		buf_dump_status(STATUS_ERR,
+				"Cannot delete '%s': %s",
+				full_filename, strerror(errno));
+		/* leave tmp_filename to exist */
+		return false;
+	}
+	/* else */
+
+	ret = rename(tmp_filename, full_filename);
+	if (ret != 0) {
+		buf_dump_status(STATUS_ERR,
+				"Cannot rename '%s' to '%s': %s",
+				tmp_filename, full_filename,
+				strerror(errno));
+		/* leave tmp_filename to exist */
+		return false;
+	}
+
+	return true;
+}
+
+/** Write a text buffer pool dump.
+@param full_filename  the buffer pool dump file
+@param tmp_filename   file to write the dump to before renaming it
+@param dump           the pages, in LRU order
+@param n_pages        number of pages
+@param obey_shutdown  whether to quit if we are in a shutting down state
+@return whether the dump was written */
+static bool buf_dump_text(const char *full_filename, const char *tmp_filename,
+			  const page_id_t *dump, ulint n_pages,
+			  bool obey_shutdown)
+{
+#define SHOULD_QUIT()	(SHUTTING_DOWN() && obey_shutdown)
+
+	FILE*	f = buf_dump_create(tmp_filename);
+	if (f == NULL) {
+		return false;
+	}
+
+	/* The file will no longer be the binary dump that
+	buf_dump_last refers to. */
+	buf_dump_last.path.clear();
+
+	for (ulint j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
+		int ret = fprintf(f, "%u,%u\n",
+				  dump[j].space(), dump[j].page_no());
+		if (ret < 0) {
+			fclose(f);
+			buf_dump_status(STATUS_ERR,
+					"Cannot write to '%s': %s",
+					tmp_filename, strerror(errno));
+			/* leave tmp_filename to exist */
+			return false;
+		}
+		if (SHUTTING_DOWN() && !(j & 1023)) {
+			service_manager_extend_timeout(
+				INNODB_EXTEND_TIMEOUT_INTERVAL,
+				"Dumping buffer pool page "
+				ULINTPF "/" ULINTPF, j + 1, n_pages);
+		}
+	}
+
+	if (IF_WIN(my_fclose(f,0),fclose(f)) != 0) {
+		buf_dump_status(STATUS_ERR,
+				"Cannot close '%s': %s",
 				tmp_filename, strerror(errno));
-		return;
+		return false;
 	}
+
+	return buf_dump_replace(tmp_filename, full_filename);
+}
+
+/** Write a binary buffer pool dump. If the file was written by the previous
+binary dump and only a few pages were added to or removed from the buffer
+pool since then, append a BUF_DUMP_DELTA section to the file. Otherwise,
+replace the file with one that contains a BUF_DUMP_FULL section.
+@param full_filename  the buffer pool dump file
+@param tmp_filename   file to write a full dump to before renaming it
+@param dump           the pages, in LRU order
+@param n_pages        number of pages
+@return whether the dump was written */
+static bool buf_dump_binary(const char *full_filename,
+                            const char *tmp_filename,
+                            const page_id_t *dump, ulint n_pages)
+{
+  std::vector<page_id_t> pages(dump, dump + n_pages);
+  std::sort(pages.begin(), pages.end());
+  std::vector<byte> payload;
+
+  if (buf_dump_last.path == full_filename &&
+      buf_dump_last.n_deltas < BUF_DUMP_MAX_DELTAS &&
+      os_file_get_size(full_filename).m_total_size == buf_dump_last.size)
+  {
+    std::vector<page_id_t> added, removed;
+    std::set_difference(pages.begin(), pages.end(),
+                        buf_dump_last.pages.begin(), buf_dump_last.pages.end(),
+                        std::back_inserter(added));
+    std::set_difference(buf_dump_last.pages.begin(), buf_dump_last.pages.end(),
+                        pages.begin(), pages.end(),
+                        std::back_inserter(removed));
+    if (added.empty() && removed.empty())
+      return true;
+    if (added.size() + removed.size() <= pages.size() / 2)
+    {
+      std::vector<byte> list;
+      buf_dump_encode(added, list);
+      buf_dump_put(payload, uint32_t(list.size()));
+      payload.insert(payload.end(), list.begin(), list.end());
+      buf_dump_encode(removed, payload);
+
+      FILE *f= fopen(full_filename, "ab" STR_O_CLOEXEC);
+      if (!f)
+      {
+        buf_dump_status(STATUS_ERR, "Cannot open '%s' for appending: %s",
+                        full_filename, strerror(errno));
+        return false;
+      }
+      bool ok= buf_dump_write_section(f, BUF_DUMP_DELTA, payload);
+      if (IF_WIN(my_fclose(f, 0), fclose(f)) != 0)
+        ok= false;
+      if (!ok)
+      {
+        /* A partially written section will be ignored by buf_load(),
+        but the next dump must rewrite the file. */
+        buf_dump_last.path.clear();
+        buf_dump_status(STATUS_ERR, "Cannot write to '%s': %s",
+                        full_filename, strerror(errno));
+        return false;
+      }
+
+      buf_dump_last.pages.swap(pages);
+      buf_dump_last.size+= BUF_DUMP_SECTION_OVERHEAD + payload.size();
+      buf_dump_last.n_deltas++;
+      buf_dump_status(STATUS_INFO, "Appended " ULINTPF " added and " ULINTPF
+                      " removed pages to %s", ulint(added.size()),
+                      ulint(removed.size()), full_filename);
+      return true;
+    }
+  }
+
+  buf_dump_last.path.clear();
+
+  FILE *f= buf_dump_create(tmp_filename);
+  if (!f)
+    return false;
+
+  buf_dump_encode(pages, payload);
+  bool ok= fwrite(BUF_DUMP_MAGIC, sizeof BUF_DUMP_MAGIC, 1, f) == 1 &&
+    buf_dump_write_section(f, BUF_DUMP_FULL, payload);
+  if (IF_WIN(my_fclose(f, 0), fclose(f)) != 0)
+    ok= false;
+  if (!ok)
+  {
+    buf_dump_status(STATUS_ERR, "Cannot write to '%s': %s",
+                    tmp_filename, strerror(errno));
+    /* leave tmp_filename to exist */
+    return false;
+  }
+
+  if (!buf_dump_replace(tmp_filename, full_filename))
+    return false;
+
+  buf_dump_last.path= full_filename;
+  buf_dump_last.pages.swap(pages);
+  buf_dump_last.size= sizeof BUF_DUMP_MAGIC + BUF_DUMP_SECTION_OVERHEAD +
+    payload.size();
+  buf_dump_last.n_deltas= 0;
+  return true;
+}
+
+/*****************************************************************//**
+Perform a buffer pool dump into the file specified by
+innodb_buffer_pool_filename. If any errors occur then the value of
+innodb_buffer_pool_dump_status will be set accordingly, see buf_dump_status().
+The dump filename can be specified by (relative to srv_data_home):
+SET GLOBAL innodb_buffer_pool_filename='filename'; */
+static
+void
+buf_dump(
+/*=====*/
+	ibool	obey_shutdown)	/*!< in: quit if we are in a shutting down
+				state */
+{
+	char	full_filename[OS_FILE_MAX_PATH];
+	char	tmp_filename[OS_FILE_MAX_PATH + sizeof "incomplete"];
+	char	now[32];
+
+	buf_dump_generate_path(full_filename, sizeof(full_filename));
+
+	snprintf(tmp_filename, sizeof(tmp_filename),
+		 "%s.incomplete", full_filename);
+
+	buf_dump_status(STATUS_INFO, "Dumping buffer pool(s) to %s",
+			full_filename);
+
 	const buf_page_t*	bpage;
-	page_id_t*		dump;
+	page_id_t*		dump = NULL;
 	ulint			n_pages;
 	ulint			j;
 
@@ -316,13 +634,11 @@ buf_dump(
 	if (dump == NULL) {
 		std::ostringstream str_bytes;
 		mysql_mutex_unlock(&buf_pool.mutex);
-		fclose(f);
 		str_bytes << ib::bytes_iec{n_pages * sizeof(*dump)};
 		buf_dump_status(STATUS_ERR,
 				"Cannot allocate %s: %s",
 				str_bytes.str().c_str(),
 				strerror(errno));
-		/* leave tmp_filename to exist */
 		return;
 	}
 
@@ -349,58 +665,16 @@ buf_dump(
 	ut_a(j <= n_pages);
 	n_pages = j;
 
-	for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
-		ret = fprintf(f, "%u,%u\n",
-			      dump[j].space(), dump[j].page_no());
-		if (ret < 0) {
-			ut_free(dump);
-			fclose(f);
-			buf_dump_status(STATUS_ERR,
-					"Cannot write to '%s': %s",
-					tmp_filename, strerror(errno));
-			/* leave tmp_filename to exist */
-			return;
-		}
-		if (SHUTTING_DOWN() && !(j & 1023)) {
-			service_manager_extend_timeout(
-				INNODB_EXTEND_TIMEOUT_INTERVAL,
-				"Dumping buffer pool page "
-				ULINTPF "/" ULINTPF, j + 1, n_pages);
-		}
-	}
-
-	ut_free(dump);
-
 done:
-	ret = IF_WIN(my_fclose(f,0),fclose(f));
-	if (ret != 0) {
-		buf_dump_status(STATUS_ERR,
-				"Cannot close '%s': %s",
-				tmp_filename, strerror(errno));
-		return;
-	}
-	/* else */
+	const bool ok = srv_buf_pool_dump_format == SRV_BUF_DUMP_BINARY
+		? buf_dump_binary(full_filename, tmp_filename, dump, n_pages)
+		: buf_dump_text(full_filename, tmp_filename, dump, n_pages,
+				obey_shutdown);
+	ut_free(dump);
 
-	ret = unlink(full_filename);
-	if (ret != 0 && errno != ENOENT) {
-		buf_dump_status(STATUS_ERR,
-				"Cannot delete '%s': %s",
-				full_filename, strerror(errno));
-		/* leave tmp_filename to exist */
+	if (!ok) {
 		return;
 	}
-	/* else */
-
-	ret = rename(tmp_filename, full_filename);
-	if (ret != 0) {
-		buf_dump_status(STATUS_ERR,
-				"Cannot rename '%s' to '%s': %s",
-				tmp_filename, full_filename,
-				strerror(errno));
-		/* leave tmp_filename to exist */
-		return;
-	}
-	/* else */
 
 	/* success */
 
@@ -415,6 +689,195 @@ buf_dump(
 	export_vars.innodb_buffer_pool_load_incomplete = 0;
 }
 
+/** Read a binary buffer pool dump file, after BUF_DUMP_MAGIC.
+A damaged or incomplete section at the end of the file, such as one
+that was being appended when the server was killed, is ignored.
+@param f              the file
+@param full_filename  name of the file
+@param pages          the pages to load, in ascending order
+@return whether the file could be read */
+static bool buf_load_binary(FILE *f, const char *full_filename,
+                            std::vector<page_id_t> &pages)
+{
+  std::vector<byte> buf;
+  for (;;)
+  {
+    byte chunk[16384];
+    const size_t n= fread(chunk, 1, sizeof chunk, f);
+    buf.insert(buf.end(), chunk, chunk + n);
+    if (n < sizeof chunk)
+      break;
+  }
+
+  if (ferror(f))
+  {
+    buf_load_status(STATUS_ERR, "Error reading '%s',"
+                    " unable to load buffer pool", full_filename);
+    return false;
+  }
+
+  const byte *ptr= buf.data(), *const end= ptr + buf.size();
+
+  while (size_t(end - ptr) >= BUF_DUMP_SECTION_OVERHEAD && !SHUTTING_DOWN())
+  {
+    const size_t len= mach_read_from_4(ptr + 1);
+    if (size_t(end - ptr) - BUF_DUMP_SECTION_OVERHEAD < len)
+      break;
+    const byte *payload= ptr + 5, *const payload_end= payload + len;
+    if (mach_read_from_4(payload_end) != my_crc32c(0, payload, len))
+      break;
+
+    std::vector<page_id_t> list;
+
+    switch (*ptr) {
+    case BUF_DUMP_FULL:
+      if (!buf_dump_decode(payload, payload_end, list))
+        goto func_exit;
+      pages.swap(list);
+      break;
+    case BUF_DUMP_DELTA:
+      {
+        uint32_t added_len;
+        std::vector<page_id_t> removed, kept;
+        if (!buf_dump_get(payload, payload_end, added_len) ||
+            added_len > size_t(payload_end - payload) ||
+            !buf_dump_decode(payload, payload + added_len, list) ||
+            !buf_dump_decode(payload + added_len, payload_end, removed))
+          goto func_exit;
+        std::set_difference(pages.begin(), pages.end(),
+                            removed.begin(), removed.end(),
+                            std::back_inserter(kept));
+        pages.clear();
+        std::set_union(kept.begin(), kept.end(), list.begin(), list.end(),
+                       std::back_inserter(pages));
+      }
+      break;
+    default:
+      goto func_exit;
+    }
+
+    ptr= payload_end + 4;
+  }
+
+func_exit:
+  if (ptr != end && !SHUTTING_DOWN())
+    ib::warn() << "Ignoring the last " << (end - ptr) << " bytes of "
+               << full_filename;
+  return true;
+}
+
+/** Submission of the page reads of a buffer pool load by multiple threads.
+The pages are divided into ranges that each belong to a single tablespace,
+so that every thread submits reads for one file at a time. */
+struct buf_load_t
+{
+  /** the pages to read, in ascending order */
+  const std::vector<page_id_t> &pages;
+  /** [first, second) ranges of pages */
+  std::vector<std::pair<size_t, size_t>> ranges;
+  /** index of the next range to process */
+  Atomic_relaxed<size_t> next{0};
+  /** number of pages that were processed */
+  Atomic_relaxed<size_t> n_done{0};
+  /** whether the load was interrupted by shutdown or abort */
+  Atomic_relaxed<bool> stop{false};
+
+  /** Divide the pages into ranges.
+  @param pages      the pages to read, in ascending order
+  @param max_pages  maximum number of pages in a range */
+  buf_load_t(const std::vector<page_id_t> &pages, size_t max_pages) :
+    pages(pages)
+  {
+    for (size_t i= 0; i < pages.size(); )
+    {
+      size_t end= i + 1;
+      while (end < pages.size() && end - i < max_pages &&
+             pages[end].space() == pages[i].space())
+        end++;
+      ranges.emplace_back(i, end);
+      i= end;
+    }
+  }
+
+  /** Process ranges until all have been processed or the load is stopped.
+  @param progress  stage progress of the calling thread, or nullptr */
+  void run(PSI_stage_progress *progress)
+  {
+    while (!stop)
+    {
+      const size_t i= next.fetch_add(1);
+      if (i >= ranges.size())
+        break;
+      load(ranges[i].first, ranges[i].second);
+      mysql_stage_set_work_completed(progress, n_done);
+    }
+  }
+
+  /** Task callback for srv_thread_pool */
+  static void task(void *arg) { static_cast<buf_load_t*>(arg)->run(nullptr); }
+
+private:
+  /** Submit the reads of a range of pages.
+  @param first  index of the first page
+  @param end    index after the last page */
+  void load(size_t first, size_t end)
+  {
+    const uint32_t space_id= pages[first].space();
+    fil_space_t *space= space_id < SRV_SPACE_ID_UPPER_BOUND
+      ? fil_space_t::get(space_id) : nullptr;
+
+    /* JAN: TODO: As we use background page read below,
+    if tablespace is encrypted we cant use it. */
+    if (space && space->crypt_data &&
+        space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
+        space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)
+    {
+      space->release();
+      space= nullptr;
+    }
+
+    if (!space)
+    {
+      n_done.fetch_add(end - first);
+      return;
+    }
+
+    const ulint zip_size= space->zip_size();
+
+    for (size_t i= first; i < end; i++)
+    {
+      if (SHUTTING_DOWN() || buf_load_abort_flag)
+      {
+        stop= true;
+        break;
+      }
+
+      const size_t n= n_done.fetch_add(1) + 1;
+
+      if (pages[i].page_no() >= space->get_size())
+        continue;
+
+      if (space->is_stopping())
+      {
+        n_done.fetch_add(end - i - 1);
+        break;
+      }
+
+      space->reacquire();
+      buf_read_page_background(space, pages[i], zip_size);
+
+#ifdef UNIV_DEBUG
+      if (n >= srv_buf_pool_load_pages_abort)
+        buf_load_abort_flag= true;
+#else
+      (void) n;
+#endif
+    }
+
+    space->release();
+  }
+};
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -429,12 +892,13 @@ buf_load()
 	char		full_filename[OS_FILE_MAX_PATH];
 	char		now[32];
 	FILE*		f;
-	page_id_t*	dump;
+	std::vector<page_id_t>	dump;
 	ulint		dump_n;
 	ulint		i;
 	uint32_t	space_id;
 	uint32_t	page_no;
 	int		fscanf_ret;
+	byte		magic[sizeof BUF_DUMP_MAGIC];
 
 	/* Ignore any leftovers from before */
 	buf_load_abort_flag = false;
@@ -444,7 +908,7 @@ buf_load()
 	buf_load_status(STATUS_INFO,
 			"Loading buffer pool(s) from %s", full_filename);
 
-	f = fopen(full_filename, "r" STR_O_CLOEXEC);
+	f = fopen(full_filename, "rb" STR_O_CLOEXEC);
 	if (f == NULL) {
 		buf_load_status(STATUS_INFO,
 				"Cannot open '%s' for reading: %s",
@@ -453,6 +917,29 @@ buf_load()
 	}
 	/* else */
 
+	if (fread(magic, sizeof magic, 1, f) == 1
+	    && !memcmp(magic, BUF_DUMP_MAGIC, sizeof magic)) {
+		const bool ok = buf_load_binary(f, full_filename, dump);
+		fclose(f);
+		if (!ok) {
+			return;
+		}
+
+		/* If dump is larger than the buffer pool(s), then we
+		ignore the pages of the tablespaces with the largest
+		identifiers, because the binary format does not preserve
+		the LRU order. */
+		if (dump.size() > buf_pool.get_n_pages()) {
+			dump.erase(dump.begin() + buf_pool.get_n_pages(),
+				   dump.end());
+		}
+
+		export_vars.innodb_buffer_pool_load_incomplete = 1;
+		goto parsed;
+	}
+
+	rewind(f);
+
 	/* First scan the file to estimate how many entries are in it.
 	This file is tiny (approx 500KB per 1GB buffer pool), reading it
 	two times is fine. */
@@ -482,10 +969,7 @@ buf_load()
 	pool is shrunk and then load is attempted. */
 	dump_n = std::min(dump_n, buf_pool.get_n_pages());
 
-	if (dump_n != 0) {
-		dump = static_cast<page_id_t*>(ut_malloc_nokey(
-				dump_n * sizeof(*dump)));
-	} else {
+	if (dump_n == 0) {
 		fclose(f);
 		ut_sprintf_timestamp(now);
 		buf_load_status(STATUS_INFO,
@@ -494,17 +978,7 @@ buf_load()
 		return;
 	}
 
-	if (dump == NULL) {
-		std::ostringstream str_bytes;
-		fclose(f);
-		str_bytes << ib::bytes_iec{dump_n * sizeof(*dump)};
-		buf_dump_status(STATUS_ERR,
-				"Cannot allocate %s: %s",
-				str_bytes.str().c_str(),
-				strerror(errno));
-		/* leave tmp_filename to exist */
-		return;
-	}
+	dump.reserve(dump_n);
 
 	rewind(f);
 
@@ -519,7 +993,6 @@ buf_load()
 			}
 			/* else */
 
-			ut_free(dump);
 			fclose(f);
 			buf_load_status(STATUS_ERR,
 					"Error parsing '%s', unable"
@@ -529,7 +1002,6 @@ buf_load()
 		}
 
 		if (space_id > ULINT32_MASK || page_no > ULINT32_MASK) {
-			ut_free(dump);
 			fclose(f);
 			buf_load_status(STATUS_ERR,
 					"Error parsing '%s': bogus"
@@ -541,18 +1013,16 @@ buf_load()
 			return;
 		}
 
-		dump[i] = page_id_t(space_id, page_no);
+		dump.emplace_back(space_id, page_no);
 	}
 
-	/* Set dump_n to the actual number of initialized elements,
-	i could be smaller than dump_n here if the file got truncated after
-	we read it the first time. */
-	dump_n = i;
+	/* The number of entries could be smaller than dump_n here
+	if the file got truncated after we read it the first time. */
 
 	fclose(f);
 
-	if (dump_n == 0) {
-		ut_free(dump);
+parsed:
+	if (dump.empty()) {
 		ut_sprintf_timestamp(now);
 		buf_load_status(STATUS_INFO,
 				"Buffer pool(s) load completed at %s"
@@ -560,103 +1030,63 @@ buf_load()
 		return;
 	}
 
+	dump_n = dump.size();
+
 	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
+		std::sort(dump.begin(), dump.end());
 	}
 
-	/* Avoid calling the expensive fil_space_t::get() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	uint32_t	cur_space_id = dump[0].space();
-	fil_space_t*	space = fil_space_t::get(cur_space_id);
-	ulint		zip_size = space ? space->zip_size() : 0;
-
 	PSI_stage_progress*	pfs_stage_progress __attribute__((unused))
 		= mysql_set_stage(srv_stage_buffer_pool_load.m_key);
 	mysql_stage_set_work_estimated(pfs_stage_progress, dump_n);
 	mysql_stage_set_work_completed(pfs_stage_progress, 0);
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-
-		/* space_id for this iteration of the loop */
-		const uint32_t this_space_id = dump[i].space();
-
-		if (this_space_id >= SRV_SPACE_ID_UPPER_BOUND) {
-			continue;
-		}
-
-		if (this_space_id != cur_space_id) {
-			if (space) {
-				space->release();
-			}
-
-			cur_space_id = this_space_id;
-			space = fil_space_t::get(cur_space_id);
-
-			if (!space) {
-				continue;
-			}
-
-			zip_size = space->zip_size();
-		}
-
-		/* JAN: TODO: As we use background page read below,
-		if tablespace is encrypted we cant use it. */
-		if (!space || dump[i].page_no() >= space->get_size() ||
-		    (space->crypt_data &&
-		     space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
-		     space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
-			continue;
-		}
+	/* Divide the pages into a few ranges per thread, so that the
+	threads stay busy even if the tablespaces differ in size.
+	dump[] is sorted by (space, page), so that each range invokes
+	the expensive fil_space_t::get() only once. */
+	const ulint	n_threads = srv_buf_pool_load_threads;
+	buf_load_t	load(dump, std::max<size_t>(dump_n / (n_threads * 4),
+						   1024));
+	std::vector<tpool::waitable_task*> tasks;
+
+	for (i = std::min<size_t>(n_threads, load.ranges.size()); --i; ) {
+		auto task = new tpool::waitable_task(buf_load_t::task, &load);
+		tasks.push_back(task);
+		srv_thread_pool->submit_task(task);
+	}
 
-		if (space->is_stopping()) {
-			space->release();
-			space = nullptr;
-			continue;
-		}
+	load.run(pfs_stage_progress);
 
-		space->reacquire();
-		buf_read_page_background(space, dump[i], zip_size);
+	for (auto task : tasks) {
+		task->wait();
+		delete task;
+	}
 
-		if (buf_load_abort_flag) {
-			if (space) {
-				space->release();
-			}
-			buf_load_abort_flag = false;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_INFO,
-				"Buffer pool(s) load aborted on request");
-			/* Premature end, set estimated = completed = i and
-			end the current stage event. */
-
-			mysql_stage_set_work_estimated(pfs_stage_progress, i);
-			mysql_stage_set_work_completed(pfs_stage_progress, i);
-
-			mysql_end_stage();
-			return;
-		}
+	if (buf_load_abort_flag) {
+		buf_load_abort_flag = false;
+		buf_load_status(
+			STATUS_INFO,
+			"Buffer pool(s) load aborted on request");
+		/* Premature end, set estimated = completed = n_done and
+		end the current stage event. */
 
-#ifdef UNIV_DEBUG
-		if ((i+1) >= srv_buf_pool_load_pages_abort) {
-			buf_load_abort_flag = true;
-		}
-#endif
-	}
+		mysql_stage_set_work_estimated(pfs_stage_progress,
+					       load.n_done);
+		mysql_stage_set_work_completed(pfs_stage_progress,
+					       load.n_done);
 
-	if (space) {
-		space->release();
+		mysql_end_stage();
+		return;
 	}
 
-	ut_free(dump);
-
-	if (i == dump_n) {
+	if (!load.stop) {
 		os_aio_wait_until_no_pending_reads();
 	}
 
 	ut_sprintf_timestamp(now);
 
-	if (i == dump_n) {
+	if (!load.stop) {
 		buf_load_status(STATUS_INFO,
 			"Buffer pool(s) load completed at %s", now);
 		export_vars.innodb_buffer_pool_load_incomplete = 0;
@@ -761,3 +1191,29 @@ void buf_load_dump_end()
   ut_ad(SHUTTING_DOWN());
   buf_dump_load_task.wait();
 }
+
+/** Start a buffer pool dump if innodb_buffer_pool_dump_interval seconds
+have passed since the previous periodic dump. Invoked by srv_master_callback(). */
+void buf_dump_periodic()
+{
+  static time_t last_dump;
+  const ulong interval= srv_buf_pool_dump_interval;
+
+  if (!interval || !load_dump_enabled)
+  {
+    last_dump= 0;
+    return;
+  }
+
+  const time_t now= time(nullptr);
+  if (!last_dump)
+    last_dump= now;
+  else if (now - last_dump >= time_t(interval))
+  {
+    last_dump= now;
+    /* Do not replace the dump with the contents of a partially
+    loaded buffer pool, like buf_dump_load_func() at shutdown. */
+    if (!export_vars.innodb_buffer_pool_load_incomplete)
+      buf_dump_start();
+  }
+}
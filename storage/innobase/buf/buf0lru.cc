@@ -38,6 +38,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "srv0srv.h"
 #include "srv0mon.h"
 #include "my_cpu.h"
+#include <my_bit.h>
 
 /** Flush this many pages in buf_LRU_get_free_block() */
 size_t innodb_lru_flush_size;
@@ -106,6 +107,26 @@ least this many milliseconds ago.  Not protected by any mutex or latch. */
 uint	buf_LRU_old_threshold_ms;
 /* @} */
 
+/** The value of innodb_lru_policy */
+ulong buf_LRU_policy;
+
+/** Hit statistics of each replacement policy, excluding the period
+since the latest buf_LRU_policy_update(). Protected by buf_pool.mutex. */
+static buf_LRU_policy_stat_t buf_LRU_policy_stats[BUF_LRU_ADAPTIVE + 1];
+/** buf_pool.stat at the latest buf_LRU_policy_update().
+Protected by buf_pool.mutex. */
+static buf_LRU_policy_stat_t buf_LRU_policy_start;
+
+/** With innodb_lru_policy=adaptive, the number of ghost hits in one
+sublist in excess of the other sublist after which
+buf_pool.LRU_old_ratio is adjusted by 1/BUF_LRU_OLD_RATIO_DIV */
+static constexpr int BUF_LRU_GHOST_HITS_PER_STEP= 64;
+
+/** Maximum value of buf_pool.LRU_old_ratio with innodb_lru_policy=adaptive;
+the same as the maximum innodb_old_blocks_pct=95 */
+static constexpr ulint BUF_LRU_ADAPTIVE_RATIO_MAX=
+  95 * BUF_LRU_OLD_RATIO_DIV / 100;
+
 /** Remove bpage from buf_pool.LRU and buf_pool.page_hash.
 
 If !bpage->frame && bpage->oldest_modification() <= 1,
@@ -573,6 +594,136 @@ static void buf_LRU_old_adjust_len()
 	}
 }
 
+/** Compute the position of a page in buf_pool.LRU_ghosts.
+@param id    page identifier
+@param slot  index of buf_pool.LRU_ghosts
+@return the hash of id, with the least significant bit clear */
+static uint32_t buf_LRU_ghost_hash(const page_id_t id, size_t &slot)
+{
+  uint64_t h= id.raw();
+  h^= h >> 33;
+  h*= 0xff51afd7ed558ccdULL;
+  h^= h >> 33;
+  h*= 0xc4ceb9fe1a85ec53ULL;
+  h^= h >> 33;
+  slot= size_t(h) & buf_pool.LRU_ghosts_mask;
+  /* The value 0 denotes an empty slot. */
+  return (uint32_t(h >> 32) | 2) & ~1U;
+}
+
+/** Remember a page that is being evicted, for innodb_lru_policy=adaptive.
+@param bpage  page that is being evicted from buf_pool.LRU */
+static void buf_LRU_ghost_insert(const buf_page_t &bpage)
+{
+  mysql_mutex_assert_owner(&buf_pool.mutex);
+  ut_ad(buf_pool.LRU_ghosts);
+  size_t slot;
+  const uint32_t hash= buf_LRU_ghost_hash(bpage.id(), slot);
+  /* A block that was added to the "new" sublist will have
+  bpage.freed_page_clock assigned (to nonzero, once any page
+  has been evicted). An older ghost in the same slot is forgotten. */
+  buf_pool.LRU_ghosts[slot]= hash | (bpage.freed_page_clock != 0);
+}
+
+/** Check whether a page that is about to be read on demand was recently
+evicted.
+The caller must hold buf_pool.mutex.
+@param id  page identifier
+@return whether the page should be added to the "old" sublist */
+bool buf_LRU_read_to_old(const page_id_t id)
+{
+  mysql_mutex_assert_owner(&buf_pool.mutex);
+  if (!buf_pool.LRU_ghosts)
+    return true;
+
+  size_t slot;
+  const uint32_t hash= buf_LRU_ghost_hash(id, slot);
+  uint32_t &ghost= buf_pool.LRU_ghosts[slot];
+  if ((ghost & ~1U) != hash)
+    return true;
+
+  /* Like in ARC, a hit in the history of one sublist means that that
+  sublist should have been longer. */
+  if (ghost & 1)
+  {
+    buf_pool.stat.n_ghost_hits_new++;
+    if (--buf_pool.LRU_ghost_balance <= -BUF_LRU_GHOST_HITS_PER_STEP)
+    {
+      buf_pool.LRU_ghost_balance= 0;
+      if (buf_pool.LRU_old_ratio > BUF_LRU_OLD_RATIO_MIN)
+      {
+        buf_pool.LRU_old_ratio--;
+        if (UT_LIST_GET_LEN(buf_pool.LRU) >= BUF_LRU_OLD_MIN_LEN)
+          buf_LRU_old_adjust_len();
+      }
+    }
+  }
+  else
+  {
+    buf_pool.stat.n_ghost_hits_old++;
+    if (++buf_pool.LRU_ghost_balance >= BUF_LRU_GHOST_HITS_PER_STEP)
+    {
+      buf_pool.LRU_ghost_balance= 0;
+      if (buf_pool.LRU_old_ratio < BUF_LRU_ADAPTIVE_RATIO_MAX)
+      {
+        buf_pool.LRU_old_ratio++;
+        if (UT_LIST_GET_LEN(buf_pool.LRU) >= BUF_LRU_OLD_MIN_LEN)
+          buf_LRU_old_adjust_len();
+      }
+    }
+  }
+
+  ghost= 0;
+  /* The page was accessed again soon after its eviction. Do not let a
+  scan evict it again before it can be made young. */
+  return false;
+}
+
+/** Switch the buffer pool replacement policy.
+@param policy  the new value of innodb_lru_policy */
+void buf_LRU_policy_update(ulong policy)
+{
+  uint32_t *ghosts= nullptr;
+  size_t n= 0;
+
+  if (policy == BUF_LRU_ADAPTIVE)
+  {
+    /* Remember about as many evicted pages as fit in the buffer pool. */
+    n= my_round_up_to_next_power(static_cast<uint32_t>
+                                 (std::max<ulint>(buf_pool.curr_size, 1)));
+    ghosts= static_cast<uint32_t*>(ut_zalloc_nokey(n * sizeof *ghosts));
+  }
+
+  mysql_mutex_lock(&buf_pool.mutex);
+  const ulint n_page_gets= buf_pool.stat.n_page_gets;
+  const ulint n_pages_read= buf_pool.stat.n_pages_read;
+  buf_LRU_policy_stat_t &stat= buf_LRU_policy_stats[buf_LRU_policy];
+  stat.n_page_gets+= n_page_gets - buf_LRU_policy_start.n_page_gets;
+  stat.n_pages_read+= n_pages_read - buf_LRU_policy_start.n_pages_read;
+  buf_LRU_policy_start.n_page_gets= n_page_gets;
+  buf_LRU_policy_start.n_pages_read= n_pages_read;
+  buf_LRU_policy= policy;
+  std::swap(ghosts, buf_pool.LRU_ghosts);
+  buf_pool.LRU_ghosts_mask= n - 1;
+  buf_pool.LRU_ghost_balance= 0;
+  mysql_mutex_unlock(&buf_pool.mutex);
+
+  ut_free(ghosts);
+}
+
+/** Get the buffer pool hit statistics of each replacement policy.
+@param stat  statistics, indexed by buf_LRU_policy_t */
+void buf_LRU_policy_stat(buf_LRU_policy_stat_t stat[BUF_LRU_ADAPTIVE + 1])
+{
+  mysql_mutex_lock(&buf_pool.mutex);
+  memcpy(stat, buf_LRU_policy_stats, sizeof buf_LRU_policy_stats);
+  stat[buf_LRU_policy].n_page_gets+=
+    buf_pool.stat.n_page_gets - buf_LRU_policy_start.n_page_gets;
+  stat[buf_LRU_policy].n_pages_read+=
+    buf_pool.stat.n_pages_read - buf_LRU_policy_start.n_pages_read;
+  mysql_mutex_unlock(&buf_pool.mutex);
+}
+
 /** Initialize the old blocks pointer in the LRU list. This function should be
 called when the LRU list grows to BUF_LRU_OLD_MIN_LEN length. */
 static void buf_LRU_old_init()
@@ -868,6 +1019,10 @@ bool buf_LRU_free_page(buf_page_t *bpage, bool zip)
 
 	ut_ad(bpage->can_relocate());
 
+	if (buf_pool.LRU_ghosts && !b && !bpage->is_freed()) {
+		buf_LRU_ghost_insert(*bpage);
+	}
+
 	if (!buf_LRU_block_remove_hashed(bpage, id, chain, zip)) {
 		ut_ad(!b);
 		mysql_mutex_assert_not_owner(&buf_pool.flush_list_mutex);
@@ -90,11 +90,15 @@ and the lock released later.
 @param[in]	zip_size		ROW_FORMAT=COMPRESSED page size, or 0
 @param[in]	unzip			whether the uncompressed page is
 					requested (for ROW_FORMAT=COMPRESSED)
+@param[in]	demand			whether this is a synchronous read
+					on behalf of buf_page_get_gen(), not
+					read-ahead
 @return pointer to the block
 @retval	NULL	in case of an error */
 TRANSACTIONAL_TARGET
 static buf_page_t* buf_page_init_for_read(ulint mode, const page_id_t page_id,
-                                          ulint zip_size, bool unzip)
+                                          ulint zip_size, bool unzip,
+                                          bool demand)
 {
   mtr_t mtr;
 
@@ -157,8 +161,10 @@ static buf_page_t* buf_page_init_for_read(ulint mode, const page_id_t page_id,
       buf_pool.page_hash.append(chain, &block->page);
     }
 
-    /* The block must be put to the LRU list, to the old blocks */
-    buf_LRU_add_block(&block->page, true/* to old blocks */);
+    /* The block must be put to the LRU list, to the old blocks,
+    unless it was recently evicted and is now being read on demand */
+    buf_LRU_add_block(&block->page,
+                      !demand || buf_LRU_read_to_old(page_id));
 
     if (UNIV_UNLIKELY(zip_size))
     {
@@ -221,9 +227,10 @@ static buf_page_t* buf_page_init_for_read(ulint mode, const page_id_t page_id,
       buf_pool.page_hash.append(chain, bpage);
     }
 
-    /* The block must be put to the LRU list, to the old blocks.
+    /* The block must be put to the LRU list, to the old blocks
+    unless it was recently evicted and is now being read on demand.
     The zip size is already set into the page zip */
-    buf_LRU_add_block(bpage, true/* to old blocks */);
+    buf_LRU_add_block(bpage, !demand || buf_LRU_read_to_old(page_id));
   }
 
   buf_pool.stat.n_pages_read++;
@@ -266,6 +273,11 @@ buf_read_page_low(
 	bool			unzip)
 {
 	buf_page_t*	bpage;
+	/* Only a page that a thread is waiting for counts as a hit
+	of the innodb_lru_policy=adaptive ghost history. Promoting
+	pages that read-ahead brings in would let a scan flood the
+	"new" sublist. */
+	const bool	demand = sync;
 
 	if (buf_dblwr.is_inside(page_id)) {
 		ib::error() << "Trying to read doublewrite buffer page "
@@ -293,7 +305,8 @@ buf_read_page_low(
 	or is being dropped; if we succeed in initing the page in the buffer
 	pool for read, then DISCARD cannot proceed until the read has
 	completed */
-	bpage = buf_page_init_for_read(mode, page_id, zip_size, unzip);
+	bpage = buf_page_init_for_read(mode, page_id, zip_size, unzip,
+				       demand);
 
 	if (!bpage) {
 		space->release();
@@ -652,6 +665,224 @@ buf_read_ahead_linear(const page_id_t page_id, ulint zip_size, bool ibuf)
   return count;
 }
 
+/** Number of consecutive moves along the chain of leaf pages after
+which buf_read_ahead_leaf() starts reading ahead */
+static constexpr uint32_t BUF_READ_AHEAD_LEAF_SEQ= 2;
+
+/** Initial read-ahead depth of buf_read_ahead_leaf(), in pages */
+static constexpr uint32_t BUF_READ_AHEAD_LEAF_INIT= 4;
+
+/** Determine the pages to read ahead of a sequential scan of leaf pages
+and submit the read requests.
+@param ra         read-ahead state of the index
+@param page_id    leaf page that the scan moved to
+@param next       FIL_PAGE_NEXT of page_id
+@param zip_size   ROW_FORMAT=COMPRESSED page size, or 0
+@param max_depth  innodb_read_ahead_leaf_pages
+@return number of page read requests issued */
+TRANSACTIONAL_TARGET
+static ulint buf_read_ahead_leaf_low(leaf_read_ahead_t &ra,
+                                     const page_id_t page_id, uint32_t next,
+                                     ulint zip_size, uint32_t max_depth)
+{
+  const uint32_t page_no= page_id.page_no();
+
+  /* Only count the pages that buf_read_ahead_leaf() read, not
+  the ones that were in the buffer pool already. */
+  if (ra.pending && ra.test_and_clear_read(page_no))
+  {
+    buf_pool.stat.n_ra_leaf_hits.inc();
+    if (++ra.hits >= ra.depth)
+    {
+      /* The previous read-ahead paid off; look further ahead. */
+      ra.hits= 0;
+      ra.depth= std::min(ra.depth * 2, max_depth);
+    }
+  }
+
+  if (page_no != ra.next)
+  {
+    /* This is not a continuation of the previous scan. Whatever that
+    scan did not reach was read in vain. */
+    if (ra.pending)
+    {
+      buf_pool.stat.n_ra_leaf_wasted.add(ra.rebase(ra.base +
+                                                   ra.READ_BITS));
+      ra.depth= std::max(ra.depth / 2, 1U);
+      ra.hits= 0;
+    }
+    ra.n_seq= ra.skip= ra.low= ra.high= ra.base= 0;
+  }
+
+  ra.next= next;
+
+  if (next == FIL_NULL ||
+      (ra.n_seq < BUF_READ_AHEAD_LEAF_SEQ &&
+       ++ra.n_seq < BUF_READ_AHEAD_LEAF_SEQ))
+    return 0;
+
+  ra.depth= std::min(ra.depth ? ra.depth : BUF_READ_AHEAD_LEAF_INIT,
+                     max_depth);
+
+  if (ra.skip)
+  {
+    ra.skip--;
+    return 0;
+  }
+
+  if (buf_pool.n_pend_reads > buf_pool.curr_size / BUF_READ_AHEAD_PEND_LIMIT)
+    return 0;
+
+  uint32_t first= next, end= 0;
+
+  if (next == page_no + 1)
+  {
+    /* The leaf pages are allocated in ascending order. Read the
+    following pages without waiting for their predecessors. */
+    if (ra.high && next >= ra.low && next < ra.high)
+    {
+      if (ra.high - next > ra.depth / 2)
+        return 0;
+      first= ra.high;
+    }
+    end= next + ra.depth;
+  }
+  else
+  {
+    /* Follow the chain of leaf pages through the buffer pool. The
+    successor of the first page that is not in the buffer pool is
+    unknown until that page has been read. As in buf_read_ahead_linear(),
+    we read FIL_PAGE_NEXT without latching the pages. */
+    uint32_t steps= 0;
+    for (;;)
+    {
+      const page_id_t id{page_id.space(), first};
+      buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(id.fold());
+      transactional_shared_lock_guard<page_hash_latch> g
+        {buf_pool.page_hash.lock_get(chain)};
+      const buf_page_t *bpage= buf_pool.page_hash.get(id, chain);
+      if (!bpage)
+      {
+        end= first + 1;
+        break;
+      }
+      const byte *f= bpage->frame ? bpage->frame : bpage->zip.data;
+      if (!f || bpage->is_read_fixed() || ++steps >= ra.depth)
+        break;
+      first= mach_read_from_4(my_assume_aligned<4>(f + FIL_PAGE_NEXT));
+      if (first == FIL_NULL)
+        break;
+    }
+
+    if (!end)
+    {
+      /* Nothing to read; avoid walking the same pages again soon. */
+      ra.skip= steps / 2;
+      return 0;
+    }
+  }
+
+  fil_space_t *space= fil_space_t::get(page_id.space());
+  if (!space)
+    return 0;
+
+  end= std::min(end, space->last_page_number() + 1);
+  ulint count= 0;
+
+  if (first < end)
+  {
+    /* Make room in ra.read for the pages to read. The pages that do
+    not fit any more are counted as not reached. */
+    uint32_t wasted= 0;
+    if (!ra.pending)
+      ra.base= first;
+    else if (first < ra.base)
+    {
+      wasted= ra.rebase(ra.base + ra.READ_BITS);
+      ra.base= first;
+    }
+    else if (end - ra.base > ra.READ_BITS)
+      wasted= ra.rebase(end - ra.READ_BITS);
+    if (wasted)
+      buf_pool.stat.n_ra_leaf_wasted.add(wasted);
+
+    if (next == page_no + 1 && ra.high && first == ra.high)
+      ra.high= end;
+    else
+    {
+      ra.low= first;
+      ra.high= end;
+    }
+  }
+
+  for (page_id_t i{page_id.space(), first}; i.page_no() < end; ++i)
+  {
+    if (ibuf_bitmap_page(i, zip_size) || trx_sys_hdr_page(i))
+      continue;
+    if (space->is_stopping())
+      break;
+    space->reacquire();
+    if (buf_read_page_low(space, false, BUF_READ_ANY_PAGE, i, zip_size,
+                          false) == DB_SUCCESS)
+    {
+      ra.set_read(i.page_no());
+      count++;
+    }
+  }
+
+  if (count)
+  {
+    DBUG_PRINT("ib_buf", ("leaf read-ahead %zu pages from %s: %u",
+                          count, space->chain.start->name, first));
+
+    mysql_mutex_lock(&buf_pool.mutex);
+    buf_LRU_stat_inc_io();
+    buf_pool.stat.n_ra_pages_read_leaf+= count;
+    mysql_mutex_unlock(&buf_pool.mutex);
+  }
+
+  space->release();
+  return count;
+}
+
+/** Read ahead of a scan that follows the chain of leaf pages of an index.
+If the scan has been moving to the FIL_PAGE_NEXT of the previous leaf page,
+submit asynchronous reads for the pages that it is expected to visit next.
+The read-ahead depth adapts to the fraction of the pages that the scans
+of the index actually reach.
+NOTE: the calling thread may own latches on pages: to avoid deadlocks this
+function must be written such that it cannot end up waiting for these
+latches!
+@param index     B-tree index
+@param page_id   leaf page that the scan just moved to
+@param next      FIL_PAGE_NEXT of page_id
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0
+@return number of page read requests issued */
+ulint buf_read_ahead_leaf(dict_index_t *index, const page_id_t page_id,
+                          uint32_t next, ulint zip_size)
+{
+  ut_ad(index->is_btree());
+
+  const uint32_t max_depth= uint32_t(srv_read_ahead_leaf_pages);
+  if (!max_depth)
+    return 0;
+
+  if (srv_startup_is_before_trx_rollback_phase)
+    /* No read-ahead to avoid thread deadlocks */
+    return 0;
+
+  leaf_read_ahead_t &ra= index->leaf_read_ahead;
+  if (!ra.try_lock())
+    /* Another thread is scanning the index. The interleaved accesses
+    would not look sequential anyway. */
+    return 0;
+
+  const ulint count= buf_read_ahead_leaf_low(ra, page_id, next, zip_size,
+                                             max_depth);
+  ra.unlock();
+  return count;
+}
+
 /** @return whether a page has been freed */
 inline bool fil_space_t::is_freed(uint32_t page)
 {
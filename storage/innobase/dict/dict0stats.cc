@@ -36,6 +36,7 @@ Created Jan 06, 2010 Vasil Dimov
 #include "que0que.h"
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <vector>
 #include <thread>
@@ -1137,15 +1138,102 @@ btr_cur_t::open_random_leaf(rec_offs *&offsets, mem_heap_t *&heap, mtr_t &mtr)
 
 /** Estimated table level stats from sampled value.
 @param value sampled stats
-@param index index being sampled
+@param n_leaf number of leaf pages in the index
 @param sample number of sampled rows
 @param ext_size external stored data size
 @param not_empty table not empty
 @return estimated table wide stats from sampled value */
-#define BTR_TABLE_STATS_FROM_SAMPLE(value, index, sample, ext_size, not_empty) \
-	(((value) * static_cast<ib_uint64_t>(index->stat_n_leaf_pages) \
+#define BTR_TABLE_STATS_FROM_SAMPLE(value, n_leaf, sample, ext_size, not_empty) \
+	(((value) * static_cast<ib_uint64_t>(n_leaf) \
 	  + (sample) - 1 + (ext_size) + (not_empty)) / ((sample) + (ext_size)))
 
+/** Determine the two-sided standard normal quantile of a confidence level.
+@param confidence  confidence level in percent (1..99)
+@return z such that P(|Z| <= z) = confidence/100 */
+static double dict_stats_z_score(uint confidence)
+{
+  ut_ad(confidence > 0);
+  ut_ad(confidence < 100);
+  const double p= confidence / 100.0;
+  double lo= 0, hi= 8;
+  for (int i= 64; i--; )
+  {
+    const double z= (lo + hi) / 2;
+    if (std::erf(z / M_SQRT2) < p)
+      lo= z;
+    else
+      hi= z;
+  }
+  return (lo + hi) / 2;
+}
+
+/** Determine the number of leaf pages to sample for transient statistics.
+@param index  B-tree index
+@return number of leaf pages to sample */
+static uintmax_t btr_estimate_n_sample_pages(const dict_index_t *index)
+{
+	uintmax_t	n_sample_pages=1; /* number of pages to sample */
+
+	if (srv_stats_sample_traditional) {
+		/* It makes no sense to test more pages than are contained
+		in the index, thus we lower the number if it is too high */
+		if (srv_stats_transient_sample_pages > index->stat_index_size) {
+			if (index->stat_index_size > 0) {
+				n_sample_pages = index->stat_index_size;
+			}
+		} else {
+			n_sample_pages = srv_stats_transient_sample_pages;
+		}
+	} else {
+		/* New logaritmic number of pages that are estimated.
+		Number of pages estimated should be between 1 and
+		index->stat_index_size.
+
+		If we have only 0 or 1 index pages then we can only take 1
+		sample. We have already initialized n_sample_pages to 1.
+
+		So taking index size as I and sample as S and log(I)*S as L
+
+		requirement 1) we want the out limit of the expression to not exceed I;
+		requirement 2) we want the ideal pages to be at least S;
+		so the current expression is min(I, max( min(S,I), L)
+
+		looking for simplifications:
+
+		case 1: assume S < I
+		min(I, max( min(S,I), L) -> min(I , max( S, L))
+
+		but since L=LOG2(I)*S and log2(I) >=1   L>S always so max(S,L) = L.
+
+		so we have: min(I , L)
+
+		case 2: assume I < S
+		    min(I, max( min(S,I), L) -> min(I, max( I, L))
+
+		case 2a: L > I
+		    min(I, max( I, L)) -> min(I, L) -> I
+
+		case 2b: when L < I
+		    min(I, max( I, L))  ->  min(I, I ) -> I
+
+		so taking all case2 paths is I, our expression is:
+		n_pages = S < I? min(I,L) : I
+                */
+		if (index->stat_index_size > 1) {
+			n_sample_pages = (srv_stats_transient_sample_pages < index->stat_index_size)
+				? ut_min(index->stat_index_size,
+					 static_cast<ulint>(
+						 log2(double(index->stat_index_size))
+						 * double(srv_stats_transient_sample_pages)))
+				: index->stat_index_size;
+		}
+	}
+
+	/* Sanity check */
+	ut_ad(n_sample_pages > 0 && n_sample_pages <= (index->stat_index_size <= 1 ? 1 : index->stat_index_size));
+	return n_sample_pages;
+}
+
 /** Estimates the number of different key values in a given index, for
 each n-column prefix of the index where 1 <= n <= dict_index_get_n_unique(index).
 The estimates are stored in the array index->stat_n_diff_key_vals[] (indexed
@@ -1154,14 +1242,24 @@ result.n_sample_sizes[].
 If innodb_stats_method is nulls_ignored, we also record the number of
 non-null values for each prefix and stored the estimates in
 array result.n_non_null_key_vals.
+If confidence is nonzero, at least n_sample_pages random leaf pages are
+sampled, and sampling continues until the confidence interval of the
+number of distinct keys per page is within 10% of the mean, or
+n_leaf_pages or 16*n_sample_pages pages were sampled.
 @param index          B-tree index
 @param bulk_trx_id    the value of index->table->bulk_trx_id at the start
+@param n_leaf_pages   number of leaf pages in the index
+@param n_sample_pages (minimum) number of leaf pages to sample
+@param confidence     confidence level in percent, or 0 for a fixed sample
 @return vector with statistics information
 empty vector if the index is unavailable. */
 static
 std::vector<index_field_stats_t>
 btr_estimate_number_of_different_key_vals(dict_index_t* index,
-					  trx_id_t bulk_trx_id)
+					  trx_id_t bulk_trx_id,
+					  ulint n_leaf_pages,
+					  uintmax_t n_sample_pages,
+					  uint confidence)
 {
 	page_t*		page;
 	rec_t*		rec;
@@ -1169,7 +1267,6 @@ btr_estimate_number_of_different_key_vals(dict_index_t* index,
 	ib_uint64_t*	n_diff;
 	ib_uint64_t*	n_not_null;
 	ibool		stats_null_not_equal;
-	uintmax_t	n_sample_pages=1; /* number of pages to sample */
 	ulint		not_empty_flag	= 0;
 	ulint		total_external_size = 0;
 	uintmax_t	add_on;
@@ -1218,69 +1315,26 @@ btr_estimate_number_of_different_key_vals(dict_index_t* index,
 		ut_error;
 	}
 
-	if (srv_stats_sample_traditional) {
-		/* It makes no sense to test more pages than are contained
-		in the index, thus we lower the number if it is too high */
-		if (srv_stats_transient_sample_pages > index->stat_index_size) {
-			if (index->stat_index_size > 0) {
-				n_sample_pages = index->stat_index_size;
-			}
-		} else {
-			n_sample_pages = srv_stats_transient_sample_pages;
-		}
-	} else {
-		/* New logaritmic number of pages that are estimated.
-		Number of pages estimated should be between 1 and
-		index->stat_index_size.
-
-		If we have only 0 or 1 index pages then we can only take 1
-		sample. We have already initialized n_sample_pages to 1.
-
-		So taking index size as I and sample as S and log(I)*S as L
-
-		requirement 1) we want the out limit of the expression to not exceed I;
-		requirement 2) we want the ideal pages to be at least S;
-		so the current expression is min(I, max( min(S,I), L)
-
-		looking for simplifications:
-
-		case 1: assume S < I
-		min(I, max( min(S,I), L) -> min(I , max( S, L))
-
-		but since L=LOG2(I)*S and log2(I) >=1   L>S always so max(S,L) = L.
-
-		so we have: min(I , L)
-
-		case 2: assume I < S
-		    min(I, max( min(S,I), L) -> min(I, max( I, L))
-
-		case 2a: L > I
-		    min(I, max( I, L)) -> min(I, L) -> I
-
-		case 2b: when L < I
-		    min(I, max( I, L))  ->  min(I, I ) -> I
-
-		so taking all case2 paths is I, our expression is:
-		n_pages = S < I? min(I,L) : I
-                */
-		if (index->stat_index_size > 1) {
-			n_sample_pages = (srv_stats_transient_sample_pages < index->stat_index_size)
-				? ut_min(index->stat_index_size,
-					 static_cast<ulint>(
-						 log2(double(index->stat_index_size))
-						 * double(srv_stats_transient_sample_pages)))
-				: index->stat_index_size;
-		}
-	}
-
-	/* Sanity check */
-	ut_ad(n_sample_pages > 0 && n_sample_pages <= (index->stat_index_size <= 1 ? 1 : index->stat_index_size));
+	ut_ad(n_sample_pages > 0);
+
+	/* Running mean and sum of squared deviations (Welford) of the
+	number of distinct full keys per sampled page */
+	double		mean = 0;
+	double		m2 = 0;
+	const double	z = confidence ? dict_stats_z_score(confidence) : 0;
+	const uintmax_t	max_sample_pages = confidence
+		? std::max<uintmax_t>(std::min<uintmax_t>(n_leaf_pages,
+							  16 * n_sample_pages),
+				      n_sample_pages)
+		: n_sample_pages;
+	ulint		i;
 
 	/* We sample some pages in the index to get an estimate */
 	btr_cur_t cursor;
 	cursor.page_cur.index = index;
 
-	for (ulint i = 0; i < n_sample_pages; i++) {
+	for (i = 0; i < max_sample_pages; i++) {
+		const ib_uint64_t n_diff_before = n_diff[n_cols - 1];
 		mtr.start();
 
 		if (cursor.open_random_leaf(offsets_rec, heap, mtr) !=
@@ -1377,9 +1431,29 @@ btr_estimate_number_of_different_key_vals(dict_index_t* index,
 		}
 
 		mtr.commit();
+
+		if (!confidence) {
+			continue;
+		}
+
+		const double x = double(n_diff[n_cols - 1] - n_diff_before);
+		const double delta = x - mean;
+		mean += delta / double(i + 1);
+		m2 += delta * (x - mean);
+
+		if (i && i + 1 >= n_sample_pages
+		    && z * std::sqrt(m2 / double(i) / double(i + 1))
+		    <= mean / 10) {
+			i++;
+			break;
+		}
 	}
 
 exit_loop:
+	if (confidence) {
+		n_sample_pages = std::max<uintmax_t>(i, 1);
+	}
+
 	/* If we saw k borders between different key values on
 	n_sample_pages leaf pages, we can estimate how many
 	there will be in index->stat_n_leaf_pages */
@@ -1395,7 +1469,7 @@ btr_estimate_number_of_different_key_vals(dict_index_t* index,
 
 		stat.n_diff_key_vals
 			= BTR_TABLE_STATS_FROM_SAMPLE(
-				n_diff[j], index, n_sample_pages,
+				n_diff[j], n_leaf_pages, n_sample_pages,
 				total_external_size, not_empty_flag);
 
 		/* If the tree is small, smaller than
@@ -1406,7 +1480,7 @@ btr_estimate_number_of_different_key_vals(dict_index_t* index,
 		different key values, or even more. Let us try to approximate
 		that: */
 
-		add_on = index->stat_n_leaf_pages
+		add_on = n_leaf_pages
 			/ (10 * (n_sample_pages
 				 + total_external_size));
 
@@ -1421,7 +1495,8 @@ btr_estimate_number_of_different_key_vals(dict_index_t* index,
 		if (n_not_null != NULL) {
 			stat.n_non_null_key_vals =
 				 BTR_TABLE_STATS_FROM_SAMPLE(
-					n_not_null[j], index, n_sample_pages,
+					n_not_null[j], n_leaf_pages,
+					n_sample_pages,
 					total_external_size, not_empty_flag);
 		}
 
@@ -1512,7 +1587,9 @@ dict_stats_update_transient_for_index(
 		if (index->is_readable()) {
 			std::vector<index_field_stats_t> stats
 				= btr_estimate_number_of_different_key_vals(
-					index, bulk_trx_id);
+					index, bulk_trx_id,
+					index->stat_n_leaf_pages,
+					btr_estimate_n_sample_pages(index), 0);
 
 			if (!stats.empty()) {
 				index->table->stats_mutex_lock();
@@ -2713,11 +2790,34 @@ static index_stats_t dict_stats_analyze_index(dict_index_t* index)
 
 	mtr.commit();
 
+	n_uniq = dict_index_get_n_unique(index);
+
+	if (srv_stats_random_dive_confidence && root_level
+	    && N_SAMPLE_PAGES(index) < result.n_leaf_pages) {
+		/* Sample random leaf pages until the estimate is
+		within the requested confidence interval. */
+		std::vector<index_field_stats_t> stats
+			= btr_estimate_number_of_different_key_vals(
+				index, bulk_trx_id, result.n_leaf_pages,
+				N_SAMPLE_PAGES(index),
+				srv_stats_random_dive_confidence);
+		if (stats.size() == n_uniq) {
+			result.stats = std::move(stats);
+			DBUG_RETURN(result);
+		}
+		if (index->table->bulk_trx_id != bulk_trx_id) {
+			/* Do not persist all-zero statistics of an index
+			that a bulk insert is modifying. */
+			result.set_bulk_operation();
+			DBUG_RETURN(result);
+		}
+		/* The random dive failed; fall back to the normal
+		sampling of each n-column prefix. */
+	}
+
 	mtr.start();
 	mtr_sx_lock_index(index, &mtr);
 
-	n_uniq = dict_index_get_n_unique(index);
-
 	/* If the tree has just one level (and one page) or if the user
 	has requested to sample too many pages then do full scan.
 
@@ -2967,6 +3067,35 @@ static index_stats_t dict_stats_analyze_index(dict_index_t* index)
 	DBUG_RETURN(result);
 }
 
+/** Indexes of a table that are being analyzed by
+dict_stats_update_persistent(), possibly by several threads */
+struct dict_stats_analyze_t
+{
+  /** the indexes to analyze; the clustered index first */
+  std::vector<dict_index_t*> indexes;
+  /** the statistics of indexes[] */
+  std::vector<index_stats_t> stats;
+  /** index of the next element of indexes[] to analyze */
+  Atomic_relaxed<size_t> next{0};
+
+  /** Analyze indexes until all have been analyzed. */
+  void run()
+  {
+    for (;;)
+    {
+      const size_t i= next.fetch_add(1);
+      if (i >= indexes.size())
+        break;
+      stats[i]= dict_stats_analyze_index(indexes[i]);
+    }
+  }
+
+  /** Analyze indexes in a tpool task.
+  @param analyze  dict_stats_analyze_t */
+  static void task(void *analyze)
+  { static_cast<dict_stats_analyze_t*>(analyze)->run(); }
+};
+
 /*********************************************************************//**
 Calculates new estimates for table and index statistics. This function
 is relatively slow and is used to calculate persistent statistics that
@@ -3000,74 +3129,86 @@ dict_stats_update_persistent(
 	}
 
 	ut_ad(!dict_index_is_ibuf(index));
-	table->stats_mutex_lock();
-	dict_stats_empty_index(index, false);
-	table->stats_mutex_unlock();
 
-	index_stats_t stats = dict_stats_analyze_index(index);
-
-	if (stats.is_bulk_operation()) {
-		dict_stats_empty_table(table, false);
-		return DB_SUCCESS_LOCKED_REC;
-	}
+	/* The clustered index comes first, followed by the secondary
+	indexes that are not to be ignored */
+	dict_stats_analyze_t	analyze;
 
 	table->stats_mutex_lock();
-	index->stat_index_size = stats.index_size;
-	index->stat_n_leaf_pages = stats.n_leaf_pages;
-	for (size_t i = 0; i < stats.stats.size(); ++i) {
-		index->stat_n_diff_key_vals[i] = stats.stats[i].n_diff_key_vals;
-		index->stat_n_sample_sizes[i] = stats.stats[i].n_sample_sizes;
-		index->stat_n_non_null_key_vals[i] = stats.stats[i].n_non_null_key_vals;
-	}
-
-	ulint	n_unique = dict_index_get_n_unique(index);
-
-	table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
-
-	table->stat_clustered_index_size = index->stat_index_size;
-
-	/* analyze other indexes from the table, if any */
-
-	table->stat_sum_of_other_index_sizes = 0;
-
-	for (index = dict_table_get_next_index(index);
-	     index != NULL;
-	     index = dict_table_get_next_index(index)) {
-
+	for (; index; index = dict_table_get_next_index(index)) {
 		if (!index->is_btree()) {
 			continue;
 		}
 
 		dict_stats_empty_index(index, false);
 
-		if (dict_stats_should_ignore_index(index)) {
-			continue;
+		if (index->is_primary()
+		    || !dict_stats_should_ignore_index(index)) {
+			analyze.indexes.push_back(index);
 		}
+	}
+	table->stats_mutex_unlock();
+
+	analyze.stats.reserve(analyze.indexes.size());
+	for (const dict_index_t* index : analyze.indexes) {
+		analyze.stats.emplace_back(index->n_uniq);
+	}
 
-		table->stats_mutex_unlock();
-		stats = dict_stats_analyze_index(index);
-		table->stats_mutex_lock();
+	/* Analyze the indexes in parallel. This thread analyzes
+	indexes too, and then waits for the tasks to finish. */
+	std::vector<tpool::waitable_task*> tasks;
 
+	for (size_t i = std::min<size_t>(srv_stats_analyze_threads,
+					 analyze.indexes.size()); --i; ) {
+		auto task = new tpool::waitable_task(
+			dict_stats_analyze_t::task, &analyze);
+		tasks.push_back(task);
+		srv_thread_pool->submit_task(task);
+	}
+
+	analyze.run();
+
+	for (auto task : tasks) {
+		task->wait();
+		delete task;
+	}
+
+	for (const index_stats_t& stats : analyze.stats) {
 		if (stats.is_bulk_operation()) {
-			table->stats_mutex_unlock();
 			dict_stats_empty_table(table, false);
 			return DB_SUCCESS_LOCKED_REC;
 		}
+	}
+
+	table->stats_mutex_lock();
+
+	table->stat_sum_of_other_index_sizes = 0;
+
+	for (size_t i = 0; i < analyze.indexes.size(); i++) {
+		index = analyze.indexes[i];
+		const index_stats_t& stats = analyze.stats[i];
 
 		index->stat_index_size = stats.index_size;
 		index->stat_n_leaf_pages = stats.n_leaf_pages;
 
-		for (size_t i = 0; i < stats.stats.size(); ++i) {
-			index->stat_n_diff_key_vals[i]
-				= stats.stats[i].n_diff_key_vals;
-			index->stat_n_sample_sizes[i]
-				= stats.stats[i].n_sample_sizes;
-			index->stat_n_non_null_key_vals[i]
-				= stats.stats[i].n_non_null_key_vals;
+		for (size_t j = 0; j < stats.stats.size(); ++j) {
+			index->stat_n_diff_key_vals[j]
+				= stats.stats[j].n_diff_key_vals;
+			index->stat_n_sample_sizes[j]
+				= stats.stats[j].n_sample_sizes;
+			index->stat_n_non_null_key_vals[j]
+				= stats.stats[j].n_non_null_key_vals;
 		}
 
-		table->stat_sum_of_other_index_sizes
-			+= index->stat_index_size;
+		if (i) {
+			table->stat_sum_of_other_index_sizes
+				+= index->stat_index_size;
+		} else {
+			table->stat_n_rows = index->stat_n_diff_key_vals[
+				dict_index_get_n_unique(index) - 1];
+			table->stat_clustered_index_size
+				= index->stat_index_size;
+		}
 	}
 
 	table->stats_last_recalc = time(NULL);
@@ -58,6 +58,9 @@ struct recalc
   table_id_t id;
   /** state of the entry */
   enum { IDLE, IN_PROGRESS, IN_PROGRESS_DELETING, DELETING} state;
+  /** number of modified rows per row since the entry was added;
+  the entry with the largest ratio is processed first */
+  double ratio;
 };
 
 /** The multitude of tables whose stats are to be automatically recalculated */
@@ -97,8 +100,10 @@ Add a table to the recalc pool, which is processed by the
 background stats gathering thread. Only the table id is added to the
 list, so the table can be closed after being enqueued and it will be
 opened when needed. If the table does not exist later (has been DROPped),
-then it will be removed from the pool and skipped. */
-static void dict_stats_recalc_pool_add(table_id_t id)
+then it will be removed from the pool and skipped.
+@param id     table identifier
+@param ratio  number of modified rows per row in the table */
+static void dict_stats_recalc_pool_add(table_id_t id, double ratio)
 {
   ut_ad(!srv_read_only_mode);
   ut_ad(id);
@@ -106,9 +111,12 @@ static void dict_stats_recalc_pool_add(table_id_t id)
   mysql_mutex_lock(&recalc_pool_mutex);
 
   const auto begin= recalc_pool.begin(), end= recalc_pool.end();
-  if (end == std::find_if(begin, end, [&](const recalc &r){return r.id == id;}))
+  auto i= std::find_if(begin, end, [&](const recalc &r){return r.id == id;});
+  if (i != end)
+    i->ratio+= ratio;
+  else
   {
-    recalc_pool.emplace_back(recalc{id, recalc::IDLE});
+    recalc_pool.emplace_back(recalc{id, recalc::IDLE, ratio});
     schedule = true;
   }
 
@@ -180,7 +188,9 @@ void dict_stats_update_if_needed_func(dict_table_t *table)
 			}
 #endif /* WITH_WSREP */
 
-			dict_stats_recalc_pool_add(table->id);
+			dict_stats_recalc_pool_add(
+				table->id, double(counter)
+				/ double(n_rows + 1));
 			table->stat_modified_counter = 0;
 		}
 		return;
@@ -279,20 +289,24 @@ void dict_stats_deinit()
 }
 
 /**
-Get the first table that has been added for auto recalc and eventually
-update its stats.
-@return whether the first entry can be processed immediately */
+Get the most modified table that has been added for auto recalc and
+eventually update its stats.
+@return whether the entry can be processed immediately */
 static bool dict_stats_process_entry_from_recalc_pool(THD *thd)
 {
   ut_ad(!srv_read_only_mode);
   table_id_t table_id;
   mysql_mutex_lock(&recalc_pool_mutex);
 next_table_id_with_mutex:
-  for (auto &r : recalc_pool)
   {
-    if ((table_id= r.id) && r.state == recalc::IDLE)
+    recalc *best= nullptr;
+    for (auto &r : recalc_pool)
+      if (r.id && r.state == recalc::IDLE && (!best || r.ratio > best->ratio))
+        best= &r;
+    if (best)
     {
-      r.state= recalc::IN_PROGRESS;
+      table_id= best->id;
+      best->state= recalc::IN_PROGRESS;
       mysql_mutex_unlock(&recalc_pool_mutex);
       goto process;
     }
@@ -362,8 +376,9 @@ static bool dict_stats_process_entry_from_recalc_pool(THD *thd)
     ut_ad(i->state == recalc::IN_PROGRESS);
     recalc_pool.erase(i);
     const bool reschedule= !update_now && recalc_pool.empty();
+    /* A postponed entry goes behind all modified tables. */
     if (err == DB_SUCCESS_LOCKED_REC)
-      recalc_pool.emplace_back(recalc{table_id, recalc::IDLE});
+      recalc_pool.emplace_back(recalc{table_id, recalc::IDLE, 0});
     mysql_mutex_unlock(&recalc_pool_mutex);
     if (reschedule)
       dict_stats_schedule(MIN_RECALC_INTERVAL * 1000);
@@ -32,6 +32,7 @@ Modified           Jan Lindström jan.lindstrom@mariadb.com
 # include "buf0buf.h"
 #else
 #include "buf0dblwr.h"
+#include "buf0rea.h"
 #include "srv0srv.h"
 #include "srv0start.h"
 #include "mtr0mtr.h"
@@ -1029,6 +1030,8 @@ struct rotate_thread_t {
   space_list_t::iterator space
     = fil_system.space_list.end();/*!< current space or .end() */
   uint32_t offset = 0;            /*!< current page number */
+  uint32_t read_ahead_end = 0;    /*!< end of the pages whose reads
+                                  were submitted by fil_crypt_read_ahead() */
   ulint batch = 0;                /*!< #pages to rotate */
   uint min_key_version_found = 0; /*!< min key version found but not rotated */
   lsn_t end_lsn = 0;              /*!< max lsn when rotating this space */
@@ -1685,6 +1688,13 @@ fil_crypt_get_page_throttle(
 		return NULL;
 	}
 
+	if (offset < state->read_ahead_end) {
+		/* The read was submitted and accounted for by
+		fil_crypt_read_ahead(); wait for it to complete. */
+		return buf_page_get_gen(page_id, zip_size, RW_X_LATCH, NULL,
+					BUF_GET_POSSIBLY_FREED, mtr);
+	}
+
 	state->crypt_stat.pages_read_from_disk++;
 
 	const ulonglong start = my_interval_timer();
@@ -1716,6 +1726,20 @@ fil_crypt_get_page_throttle(
 	return block;
 }
 
+/** Sleep in order to stay within innodb_encryption_rotation_iops.
+@param sleeptime_ms  time to sleep, in milliseconds */
+static void fil_crypt_throttle_sleep(ulint sleeptime_ms)
+{
+  if (!sleeptime_ms)
+    return;
+  mysql_mutex_lock(&fil_crypt_threads_mutex);
+  timespec abstime;
+  set_timespec_nsec(abstime, 1000000ULL * sleeptime_ms);
+  my_cond_timedwait(&fil_crypt_throttle_sleep_cond,
+                    &fil_crypt_threads_mutex.m_mutex, &abstime);
+  mysql_mutex_unlock(&fil_crypt_threads_mutex);
+}
+
 /***********************************************************************
 Rotate one page
 @param[in,out]		key_state		Key state
@@ -1836,14 +1860,60 @@ fil_crypt_rotate_page(
 		mtr.commit();
 	}
 
-	if (sleeptime_ms) {
-		mysql_mutex_lock(&fil_crypt_threads_mutex);
-		timespec abstime;
-		set_timespec_nsec(abstime, 1000000ULL * sleeptime_ms);
-		my_cond_timedwait(&fil_crypt_throttle_sleep_cond,
-				  &fil_crypt_threads_mutex.m_mutex, &abstime);
-		mysql_mutex_unlock(&fil_crypt_threads_mutex);
-	}
+	fil_crypt_throttle_sleep(sleeptime_ms);
+}
+
+/** Submit asynchronous reads for those pages of an extent that are not
+in the buffer pool, so that the reads of a batch proceed concurrently.
+@param state  rotation state
+@param first  first page number
+@param end    page number after the last page
+@return number of submitted reads */
+TRANSACTIONAL_TARGET
+static ulint fil_crypt_read_ahead(rotate_thread_t *state, uint32_t first,
+                                  uint32_t end)
+{
+  fil_space_t *space= &*state->space;
+  const ulint zip_size= space->zip_size();
+  ulint n_reads= 0;
+
+  for (uint32_t page_no= first; page_no < end; page_no++)
+  {
+    const page_id_t page_id{space->id, page_no};
+    if (space->is_stopping())
+      break;
+    if (buf_dblwr.is_inside(page_id) ||
+        (space->id == TRX_SYS_SPACE && page_no == TRX_SYS_PAGE_NO))
+      continue;
+    buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(page_id.fold());
+    if (buf_pool.page_hash_contains(page_id, chain))
+      continue;
+    space->reacquire();
+    buf_read_page_background(space, page_id, zip_size);
+    n_reads++;
+  }
+
+  state->read_ahead_end= end;
+  state->crypt_stat.pages_read_from_disk+= n_reads;
+  return n_reads;
+}
+
+/** Charge the reads submitted by fil_crypt_read_ahead() to the
+innodb_encryption_rotation_iops budget of the thread.
+@param state    rotation state
+@param n_reads  number of submitted reads
+@param start    my_interval_timer() before the reads were submitted */
+static void fil_crypt_throttle_read_ahead(rotate_thread_t *state,
+                                          ulint n_reads, ulonglong start)
+{
+  const ulonglong end= my_interval_timer();
+  const ulonglong waited_us= end > start ? (end - start) / 1000 : 0;
+  state->cnt_waited+= n_reads;
+  state->sum_waited_us+= waited_us;
+
+  const ulonglong budget_us= 1000000ULL * n_reads / state->allocated_iops;
+  if (budget_us > waited_us)
+    fil_crypt_throttle_sleep(ulint((budget_us - waited_us) / 1000));
 }
 
 /***********************************************************************
@@ -1862,28 +1932,47 @@ fil_crypt_rotate_pages(
 
 	ut_ad(state->space->referenced());
 
-	for (; state->offset < end; state->offset++) {
+	/* Rotate the batch one extent at a time. The reads of the pages
+	of an extent are submitted upfront. */
+	while (state->offset < end) {
+		const uint32_t extent_end = std::min(
+			ut_2pow_round(state->offset, uint32_t(FSP_EXTENT_SIZE))
+			+ uint32_t(FSP_EXTENT_SIZE), end);
+		const ulonglong start = my_interval_timer();
+		const ulint n_reads = fil_crypt_read_ahead(
+			state, state->offset, extent_end);
+
+		for (; state->offset < extent_end; state->offset++) {
+
+			/* we can't rotate pages in dblwr buffer as
+			* it's not possible to read those due to lots of
+			* asserts in buffer pool.
+			*
+			* However since these are only (short-lived) copies
+			* of real pages, they will be updated anyway when the
+			* real page is updated
+			*/
+			if (buf_dblwr.is_inside(page_id_t(space_id,
+							  state->offset))) {
+				continue;
+			}
 
-		/* we can't rotate pages in dblwr buffer as
-		* it's not possible to read those due to lots of asserts
-		* in buffer pool.
-		*
-		* However since these are only (short-lived) copies of
-		* real pages, they will be updated anyway when the
-		* real page is updated
-		*/
-		if (buf_dblwr.is_inside(page_id_t(space_id, state->offset))) {
-			continue;
-		}
+			/* If space is marked as stopping, stop rotating
+			pages. */
+			if (state->space->is_stopping()) {
+				state->read_ahead_end = 0;
+				return;
+			}
 
-		/* If space is marked as stopping, stop rotating
-		pages. */
-		if (state->space->is_stopping()) {
-			break;
+			fil_crypt_rotate_page(key_state, state);
 		}
 
-		fil_crypt_rotate_page(key_state, state);
+		if (n_reads) {
+			fil_crypt_throttle_read_ahead(state, n_reads, start);
+		}
 	}
+
+	state->read_ahead_end = 0;
 }
 
 /***********************************************************************
@@ -2340,6 +2429,22 @@ fil_space_crypt_get_status(
 				crypt_data->rotate_state.next_offset;
 			status->rotate_max_page_number =
 				crypt_data->rotate_state.max_offset;
+
+			/* Page 0 is not rotated. next_offset may run
+			past max_offset by the size of the last batch. */
+			const ulint max_page = status->rotate_max_page_number;
+			const ulint next = std::min<ulint>(
+				status->rotate_next_page_number, max_page);
+			const time_t elapsed = time(NULL)
+				- crypt_data->rotate_state.start_time;
+			if (next > 1 && elapsed > 0) {
+				status->rotate_pages_per_second =
+					(next - 1) / ulint(elapsed);
+			}
+			if (status->rotate_pages_per_second) {
+				status->rotate_eta_seconds = (max_page - next)
+					/ status->rotate_pages_per_second;
+			}
 		}
 
 		mysql_mutex_unlock(&crypt_data->mutex);
@@ -574,6 +574,95 @@ dberr_t fsp_header_init(fil_space_t *space, uint32_t size, mtr_t *mtr)
 	return DB_SUCCESS;
 }
 
+/** Discard the free extents at the end of an undo tablespace.
+The caller must x-lock the tablespace, and later invoke
+mtr_t::shrink_pages() and mtr_t::commit_shrink().
+@param space     undo tablespace
+@param min_size  minimum size of the tablespace, in pages
+@param mtr       mini-transaction
+@param err       error code
+@return the new size of the tablespace, in pages
+@retval 0 if the tablespace cannot be shrunk */
+uint32_t fsp_shrink_undo_tablespace(fil_space_t *space, uint32_t min_size,
+                                    mtr_t *mtr, dberr_t *err)
+{
+  ut_ad(srv_is_undo_tablespace(space->id));
+  ut_ad(mtr->memo_contains(*space));
+
+  buf_block_t *header= fsp_get_header(space, mtr, err);
+  if (!header)
+    return 0;
+
+  const uint32_t extent_size= FSP_EXTENT_SIZE;
+  const uint32_t size=
+    mach_read_from_4(FSP_HEADER_OFFSET + FSP_SIZE + header->page.frame);
+  const uint32_t limit=
+    mach_read_from_4(FSP_HEADER_OFFSET + FSP_FREE_LIMIT + header->page.frame);
+  ut_ad(size == space->size_in_header);
+  ut_ad(limit == space->free_limit);
+  min_size= ut_calc_align(min_size, extent_size);
+  ut_ad(!(limit % extent_size));
+
+  if (limit > size)
+  {
+    *err= DB_CORRUPTION;
+    return 0;
+  }
+
+  /* Find the end of the last extent that is not free. The extents
+  above the free limit are not part of any list. The first extent
+  of each descriptor page can never be free, because it contains
+  the descriptor page itself. */
+  uint32_t new_size= limit;
+  while (new_size >= min_size + extent_size)
+  {
+    const xdes_t *descr= xdes_get_descriptor_with_space_hdr(
+      header, space, new_size - extent_size, mtr, err);
+    if (!descr)
+      return 0;
+    if (xdes_get_state(descr) != XDES_FREE)
+      break;
+    new_size-= extent_size;
+  }
+
+  new_size= std::max(new_size, min_size);
+  if (new_size >= size)
+    return 0;
+
+  for (uint32_t i= new_size; i < limit; i+= extent_size)
+  {
+    buf_block_t *xdes;
+    xdes_t *descr= xdes_get_descriptor_with_space_hdr(header, space, i, mtr,
+                                                      err, &xdes);
+    if (!descr)
+      return 0;
+    ut_ad(xdes_get_state(descr) == XDES_FREE);
+    *err= flst_remove(header, FSP_HEADER_OFFSET + FSP_FREE, xdes,
+                      static_cast<uint16_t>(descr - xdes->page.frame +
+                                            XDES_FLST_NODE), mtr);
+    if (UNIV_UNLIKELY(*err != DB_SUCCESS))
+    {
+      space->set_corrupted();
+      return 0;
+    }
+    space->free_len--;
+  }
+
+  if (limit > new_size)
+  {
+    space->free_limit= new_size;
+    mtr->write<4>(*header, FSP_HEADER_OFFSET + FSP_FREE_LIMIT +
+                  header->page.frame, new_size);
+  }
+
+  space->size_in_header= new_size;
+  /* recv_sys_t::parse() expects to find a WRITE record that
+  covers all 4 bytes. */
+  mtr->write<4,mtr_t::FORCED>(*header, FSP_HEADER_OFFSET + FSP_SIZE +
+                              header->page.frame, new_size);
+  return new_size;
+}
+
 /** Try to extend a single-table tablespace so that a page would fit in the
 data file.
 @param[in,out]	space	tablespace
@@ -81,6 +81,16 @@ Atomic_relaxed<size_t> fts_max_total_cache_size;
 a configurable variable */
 size_t	fts_result_cache_limit;
 
+/** Maximum total size of the posting lists that are cached for
+queries, or 0 to disable the cache */
+size_t	fts_postings_cache_size;
+
+/** Total size of the cached posting lists of all tables */
+Atomic_counter<size_t>	fts_postings_cache_used;
+
+/** Number of posting lists that were found in the cache */
+Atomic_counter<size_t>	fts_postings_cache_hits;
+
 /** Variable specifying the maximum FTS max token size */
 ulong	fts_max_token_size;
 
@@ -276,6 +286,8 @@ fts_cache_destroy(fts_cache_t* cache)
 	mysql_mutex_destroy(&cache->deleted_lock);
 	mysql_mutex_destroy(&cache->doc_id_lock);
 
+	UT_DELETE(cache->postings);
+
 	if (cache->stopword_info.cached_stopword) {
 		rbt_free(cache->stopword_info.cached_stopword);
 	}
@@ -657,6 +669,8 @@ fts_cache_create(
 
 	cache->stopword_info.status = STOPWORD_NOT_INIT;
 
+	cache->postings = UT_NEW_NOKEY(fts_postings_cache_t());
+
 	return(cache);
 }
 
@@ -4113,6 +4127,7 @@ fts_sync_commit(
 		fts_cache_init(cache);
 		mysql_mutex_unlock(&cache->lock);
 		fts_sql_commit(trx);
+		cache->postings->invalidate();
 	} else {
 		ib::error() << "(" << error << ") during SYNC of "
 			"table " << sync->table->name;
@@ -172,6 +172,20 @@ struct fts_optimize_t {
 					been optimized */
 	ibool		del_list_regenerated;
 					/*!< BEING_DELETED list regenarated */
+
+	ulint		shard;		/*!< The auxiliary INDEX table to
+					optimize, or FTS_NUM_AUX_INDEX
+					for all of them */
+
+	const char*	last_word_param;/*!< CONFIG parameter for the last
+					word that was optimized */
+
+	const fts_optimize_t*
+			parent;		/*!< The instance that owns to_delete,
+					or NULL */
+
+	ulint		time_limit;	/*!< The amount of time optimizing in
+					a single pass, or 0 for no limit */
 };
 
 /** Used by the optimize, to keep state during compacting nodes. */
@@ -225,14 +239,26 @@ struct fts_msg_t {
 /** The number of words to read and optimize in a single pass. */
 ulong	fts_num_word_optimize;
 
+/** The number of threads that optimize the auxiliary INDEX tables
+of a table. */
+uint	fts_optimize_threads;
+
 /** Whether to enable additional FTS diagnostic printout. */
 char	fts_enable_diag_print;
 
 /** ZLib compressed block size.*/
 static ulint FTS_ZIP_BLOCK_SIZE	= 1024;
 
-/** The amount of time optimizing in a single pass, in seconds. */
-static ulint fts_optimize_time_limit;
+/** CONFIG parameters for the last word that was optimized in each
+auxiliary INDEX table when fts_optimize_threads > 1 */
+static const char* const fts_last_optimized_shard_word[FTS_NUM_AUX_INDEX] = {
+	FTS_LAST_OPTIMIZED_WORD "_1",
+	FTS_LAST_OPTIMIZED_WORD "_2",
+	FTS_LAST_OPTIMIZED_WORD "_3",
+	FTS_LAST_OPTIMIZED_WORD "_4",
+	FTS_LAST_OPTIMIZED_WORD "_5",
+	FTS_LAST_OPTIMIZED_WORD "_6"
+};
 
 /** It's defined in fts0fts.cc  */
 extern const char* fts_common_tables[];
@@ -817,9 +843,16 @@ fts_index_fetch_words(
 		fts_zip_initialize(optim->zip);
 	}
 
-	for (selected = fts_select_index(
-		     optim->fts_index_table.charset, word->f_str, word->f_len);
-	     selected < FTS_NUM_AUX_INDEX;
+	/* Read the words of one auxiliary INDEX table, or of all
+	tables starting from the one that contains word. */
+	const ulint	end = optim->shard < FTS_NUM_AUX_INDEX
+		? optim->shard + 1 : FTS_NUM_AUX_INDEX;
+
+	for (selected = optim->shard < FTS_NUM_AUX_INDEX
+		     ? optim->shard
+		     : fts_select_index(optim->fts_index_table.charset,
+					word->f_str, word->f_len);
+	     selected < end;
 	     selected++) {
 
 		char	table_name[MAX_FULL_NAME_LEN];
@@ -1557,7 +1590,7 @@ fts_optimize_compact(
 			we use this value for restarting optimize. */
 			error = fts_config_set_index_value(
 				optim->trx, index,
-				FTS_LAST_OPTIMIZED_WORD, &word->text);
+				optim->last_word_param, &word->text);
 		}
 
 		/* Free the word that was optimized. */
@@ -1565,9 +1598,9 @@ fts_optimize_compact(
 
 		ulint interval = ulint(time(NULL) - start_time);
 
-		if (fts_optimize_time_limit > 0
+		if (optim->time_limit > 0
 		    && (lint(interval) < 0
-			|| interval > fts_optimize_time_limit)) {
+			|| interval > optim->time_limit)) {
 
 			optim->done = TRUE;
 		}
@@ -1583,7 +1616,10 @@ static
 fts_optimize_t*
 fts_optimize_create(
 /*================*/
-	dict_table_t*	table)		/*!< in: table with FTS indexes */
+	dict_table_t*	table,		/*!< in: table with FTS indexes */
+	const fts_optimize_t*
+			parent)		/*!< in: instance whose deleted
+					doc ids to use, or NULL */
 {
 	fts_optimize_t*	optim;
 	mem_heap_t*	heap = mem_heap_create(128);
@@ -1592,7 +1628,16 @@ fts_optimize_create(
 
 	optim->self_heap = ib_heap_allocator_create(heap);
 
-	optim->to_delete = fts_doc_ids_create();
+	if (parent) {
+		optim->to_delete = parent->to_delete;
+		optim->del_list_regenerated = parent->del_list_regenerated;
+	} else {
+		optim->to_delete = fts_doc_ids_create();
+	}
+
+	optim->parent = parent;
+	optim->shard = FTS_NUM_AUX_INDEX;
+	optim->last_word_param = FTS_LAST_OPTIMIZED_WORD;
 
 	optim->words = ib_vector_create(
 		optim->self_heap, sizeof(fts_word_t), 256);
@@ -1738,7 +1783,9 @@ fts_optimize_free(
 	optim->trx->free();
 	optim->trx = NULL;
 
-	fts_doc_ids_free(optim->to_delete);
+	if (!optim->parent) {
+		fts_doc_ids_free(optim->to_delete);
+	}
 	fts_optimize_graph_free(&optim->graph);
 
 	ut_free(optim->name_prefix);
@@ -1786,7 +1833,7 @@ fts_optimize_words(
 	ut_a(!optim->done);
 
 	/* Get the time limit from the config table. */
-	fts_optimize_time_limit = fts_optimize_get_time_limit(
+	optim->time_limit = fts_optimize_get_time_limit(
 		optim->trx, &optim->fts_common_table);
 
 	const time_t start_time = time(NULL);
@@ -1821,6 +1868,8 @@ fts_optimize_words(
 
 			if (error == DB_SUCCESS) {
 				fts_sql_commit(optim->trx);
+				optim->table->fts->cache->postings
+					->invalidate();
 			} else {
 				fts_sql_rollback(optim->trx);
 			}
@@ -1888,7 +1937,7 @@ fts_optimize_index_completed(
 	*word.f_str = '\0';
 
 	error = fts_config_set_index_value(
-		optim->trx, index, FTS_LAST_OPTIMIZED_WORD, &word);
+		optim->trx, index, optim->last_word_param, &word);
 
 	if (UNIV_UNLIKELY(error != DB_SUCCESS)) {
 		ib::error() << "(" << error << ") while updating"
@@ -1920,7 +1969,7 @@ fts_optimize_index_read_words(
 		/* Get the last word that was optimized from
 		the config table. */
 		error = fts_config_get_index_value(
-			optim->trx, index, FTS_LAST_OPTIMIZED_WORD, word);
+			optim->trx, index, optim->last_word_param, word);
 	}
 
 	/* If record not found then we start from the top. */
@@ -2243,6 +2292,175 @@ fts_optimize_read_deleted_doc_id_snapshot(
 	return(error);
 }
 
+/** Auxiliary INDEX tables of a table that are being optimized by
+fts_optimize_indexes_parallel(), possibly by several threads */
+struct fts_optimize_shards_t
+{
+  /** the optimize instance of the table */
+  const fts_optimize_t *optim;
+  /** the FTS indexes */
+  std::vector<dict_index_t*> indexes;
+  /** the outcome of each auxiliary INDEX table, in the order
+  index * FTS_NUM_AUX_INDEX + shard */
+  std::vector<dberr_t> errors;
+  /** whether each auxiliary INDEX table was completely optimized */
+  std::vector<byte> completed;
+  /** the next auxiliary INDEX table to optimize */
+  Atomic_relaxed<size_t> next{0};
+
+  /** Optimize an auxiliary INDEX table.
+  @param i  index * FTS_NUM_AUX_INDEX + shard */
+  void optimize(size_t i)
+  {
+    fts_optimize_t *shard= fts_optimize_create(optim->table, optim);
+    shard->shard= i % FTS_NUM_AUX_INDEX;
+    shard->last_word_param= fts_last_optimized_shard_word[shard->shard];
+
+    dberr_t error= fts_optimize_index(shard,
+                                      indexes[i / FTS_NUM_AUX_INDEX]);
+    if (error == DB_SUCCESS)
+      fts_sql_commit(shard->trx);
+    else
+      fts_sql_rollback(shard->trx);
+
+    errors[i]= error;
+    completed[i]= shard->n_completed > 0;
+    fts_optimize_free(shard);
+  }
+
+  /** Optimize auxiliary INDEX tables until all have been optimized. */
+  void run()
+  {
+    for (;;)
+    {
+      const size_t i= next.fetch_add(1);
+      if (i >= errors.size())
+        break;
+      optimize(i);
+    }
+  }
+
+  /** Optimize auxiliary INDEX tables in a tpool task.
+  @param shards  fts_optimize_shards_t */
+  static void task(void *shards)
+  { static_cast<fts_optimize_shards_t*>(shards)->run(); }
+};
+
+/*********************************************************************//**
+Create the CONFIG parameters for the last word optimized in each auxiliary
+INDEX table if they do not exist, so that the concurrent transactions of
+fts_optimize_indexes_parallel() will only update existing records.
+@return DB_SUCCESS if all OK */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+fts_optimize_create_shard_params(
+/*=============================*/
+	fts_optimize_t*	optim,	/*!< in: optimize instance */
+	dict_index_t*	index)	/*!< in: FTS index */
+{
+	dberr_t	error = DB_SUCCESS;
+
+	for (ulint i = 0; i < FTS_NUM_AUX_INDEX && error == DB_SUCCESS;
+	     i++) {
+		fts_string_t	word;
+		byte		str[FTS_MAX_WORD_LEN + 1];
+
+		word.f_str = str;
+		word.f_len = sizeof(str) - 1;
+
+		error = fts_config_get_index_value(
+			optim->trx, index, fts_last_optimized_shard_word[i],
+			&word);
+
+		if (error == DB_RECORD_NOT_FOUND) {
+			word.f_len = 0;
+			*word.f_str = '\0';
+
+			error = fts_config_set_index_value(
+				optim->trx, index,
+				fts_last_optimized_shard_word[i], &word);
+		}
+	}
+
+	return(error);
+}
+
+/*********************************************************************//**
+Optimize the auxiliary INDEX tables of all the FTS indexes in
+fts_optimize_threads threads.
+@return DB_SUCCESS if all OK */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+fts_optimize_indexes_parallel(
+/*==========================*/
+	fts_optimize_t*	optim)	/*!< in: optimize instance */
+{
+	dberr_t			error = DB_SUCCESS;
+	fts_t*			fts = optim->table->fts;
+	fts_optimize_shards_t	shards;
+
+	shards.optim = optim;
+
+	for (ulint i = 0; i < ib_vector_size(fts->indexes); ++i) {
+		dict_index_t*	index = static_cast<dict_index_t*>(
+			ib_vector_getp(fts->indexes, i));
+
+		error = fts_optimize_create_shard_params(optim, index);
+
+		if (error != DB_SUCCESS) {
+			fts_sql_rollback(optim->trx);
+			return(error);
+		}
+
+		shards.indexes.push_back(index);
+	}
+
+	fts_sql_commit(optim->trx);
+
+	shards.errors.resize(shards.indexes.size() * FTS_NUM_AUX_INDEX,
+			     DB_SUCCESS);
+	shards.completed.resize(shards.errors.size());
+
+	/* This thread optimizes auxiliary INDEX tables too, and then
+	waits for the tasks to finish. */
+	std::vector<tpool::waitable_task*>	tasks;
+
+	for (size_t i = std::min<size_t>(fts_optimize_threads,
+					 shards.errors.size()); --i; ) {
+		auto task = new tpool::waitable_task(
+			fts_optimize_shards_t::task, &shards);
+		tasks.push_back(task);
+		srv_thread_pool->submit_task(task);
+	}
+
+	shards.run();
+
+	for (auto task : tasks) {
+		task->wait();
+		delete task;
+	}
+
+	for (size_t i = 0; i < shards.indexes.size(); i++) {
+		bool	completed = true;
+
+		for (size_t j = 0; j < FTS_NUM_AUX_INDEX; j++) {
+			const size_t	k = i * FTS_NUM_AUX_INDEX + j;
+
+			if (error == DB_SUCCESS) {
+				error = shards.errors[k];
+			}
+
+			completed = completed && shards.completed[k];
+		}
+
+		if (completed) {
+			++optim->n_completed;
+		}
+	}
+
+	return(error);
+}
+
 /*********************************************************************//**
 Optimze all the FTS indexes, skipping those that have already been
 optimized, since the FTS auxiliary indexes are not guaranteed to be
@@ -2258,6 +2476,10 @@ fts_optimize_indexes(
 	dberr_t		error = DB_SUCCESS;
 	fts_t*		fts = optim->table->fts;
 
+	if (fts_optimize_threads > 1) {
+		return(fts_optimize_indexes_parallel(optim));
+	}
+
 	/* Optimize the FTS indexes. */
 	for (i = 0; i < ib_vector_size(fts->indexes); ++i) {
 		dict_index_t*	index;
@@ -2445,7 +2667,7 @@ fts_optimize_table(
 		ib::info() << "FTS start optimize " << table->name;
 	}
 
-	optim = fts_optimize_create(table);
+	optim = fts_optimize_create(table, NULL);
 
 	// FIXME: Call this only at the start of optimize, currently we
 	// rely on DB_DUPLICATE_KEY to handle corrupting the snapshot.
@@ -149,6 +149,15 @@ struct fts_query_t {
 					fts_ast_visit_sub_exp() */
 
 	st_mysql_ftparser*	parser;	/*!< fts plugin parser */
+
+	fts_postings_t*	postings;	/*!< rows of the FTS INDEX table
+					being collected for the posting
+					list cache, or NULL */
+
+	uint64_t	postings_generation;
+					/*!< generation of the posting
+					list cache before the read view
+					of trx was created */
 };
 
 /** For phrase matching, first we collect the documents and the positions
@@ -280,6 +289,21 @@ fts_query_index_fetch_nodes(
 	void*		row,		/*!< in: sel_node_t* */
 	void*		user_arg);	/*!< in: pointer to ib_vector_t */
 
+/** Read the FTS INDEX rows that match a search string, from the posting
+list cache if possible.
+@param query	query instance
+@param graph	prepared statement
+@param token	the search string
+@param fetch	fetch callback
+@return DB_SUCCESS or error code */
+static
+dberr_t
+fts_query_fetch_nodes(
+	fts_query_t*		query,
+	que_t**			graph,
+	const fts_string_t*	token,
+	fts_fetch_t*		fetch);
+
 /********************************************************************
 Read and filter nodes.
 @return fts_node_t instance */
@@ -1118,7 +1142,6 @@ fts_query_difference(
 	const fts_string_t*	token)	/*!< in: token to search */
 {
 	ulint			n_doc_ids= 0;
-	trx_t*			trx = query->trx;
 	dict_table_t*		table = query->index->table;
 
 	ut_a(query->oper == FTS_IGNORE);
@@ -1185,8 +1208,7 @@ fts_query_difference(
 		fetch.read_arg = query;
 		fetch.read_record = fts_query_index_fetch_nodes;
 
-		error = fts_index_fetch_nodes(
-			trx, &graph, &query->fts_index_table, token, &fetch);
+		error = fts_query_fetch_nodes(query, &graph, token, &fetch);
 
 		/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 		ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
@@ -1194,7 +1216,9 @@ fts_query_difference(
 			query->error = error;
 		}
 
-		que_graph_free(graph);
+		if (graph) {
+			que_graph_free(graph);
+		}
 	}
 
 	/* The size can't increase. */
@@ -1221,7 +1245,6 @@ fts_query_intersect(
 	fts_query_t*		query,	/*!< in: query instance */
 	const fts_string_t*	token)	/*!< in: the token to search */
 {
-	trx_t*			trx = query->trx;
 	dict_table_t*		table = query->index->table;
 
 	ut_a(query->oper == FTS_EXIST);
@@ -1318,8 +1341,7 @@ fts_query_intersect(
 		fetch.read_arg = query;
 		fetch.read_record = fts_query_index_fetch_nodes;
 
-		error = fts_index_fetch_nodes(
-			trx, &graph, &query->fts_index_table, token, &fetch);
+		error = fts_query_fetch_nodes(query, &graph, token, &fetch);
 
 		/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 		ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
@@ -1327,7 +1349,9 @@ fts_query_intersect(
 			query->error = error;
 		}
 
-		que_graph_free(graph);
+		if (graph) {
+			que_graph_free(graph);
+		}
 
 		if (query->error == DB_SUCCESS) {
 			/* Make the intesection (rb tree) the current doc id
@@ -1408,7 +1432,6 @@ fts_query_union(
 {
 	fts_fetch_t		fetch;
 	ulint			n_doc_ids = 0;
-	trx_t*			trx = query->trx;
 	que_t*			graph = NULL;
 	dberr_t			error;
 
@@ -1440,8 +1463,7 @@ fts_query_union(
 	fetch.read_record = fts_query_index_fetch_nodes;
 
 	/* Read the nodes from disk. */
-	error = fts_index_fetch_nodes(
-		trx, &graph, &query->fts_index_table, token, &fetch);
+	error = fts_query_fetch_nodes(query, &graph, token, &fetch);
 
 	/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 	ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
@@ -1449,7 +1471,9 @@ fts_query_union(
 		query->error = error;
 	}
 
-	que_graph_free(graph);
+	if (graph) {
+		que_graph_free(graph);
+	}
 
 	if (query->error == DB_SUCCESS) {
 
@@ -2763,7 +2787,6 @@ fts_query_phrase_search(
 	if (num_token > 0) {
 		fts_string_t*	token = NULL;
 		fts_fetch_t	fetch;
-		trx_t*		trx = query->trx;
 		fts_ast_oper_t	oper = query->oper;
 		que_t*		graph = NULL;
 		ulint		i;
@@ -2815,9 +2838,8 @@ fts_query_phrase_search(
 				query->matched = query->match_array[i];
 			}
 
-			error = fts_index_fetch_nodes(
-				trx, &graph, &query->fts_index_table,
-				token, &fetch);
+			error = fts_query_fetch_nodes(
+				query, &graph, token, &fetch);
 
 			/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 			ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
@@ -2825,7 +2847,9 @@ fts_query_phrase_search(
 				query->error = error;
 			}
 
-			que_graph_free(graph);
+			if (graph) {
+				que_graph_free(graph);
+			}
 			graph = NULL;
 
 			fts_query_cache(query, token);
@@ -3345,32 +3369,28 @@ fts_query_filter_doc_ids(
 	}
 }
 
-/*****************************************************************//**
-Read the FTS INDEX row.
+/** Filter the doc ids of an FTS INDEX row.
+@param query	query instance
+@param word	the word of the row
+@param node	the other columns of the row
 @return DB_SUCCESS if all go well. */
 static
 dberr_t
-fts_query_read_node(
-/*================*/
-	fts_query_t*		query,	/*!< in: query instance */
-	const fts_string_t*	word,	/*!< in: current word */
-	que_node_t*		exp)	/*!< in: query graph node */
+fts_query_process_node(
+	fts_query_t*		query,
+	const fts_string_t*	word,
+	const fts_node_t*	node)
 {
-	int			i;
 	int			ret;
-	fts_node_t		node;
 	ib_rbt_bound_t		parent;
 	fts_word_freq_t*	word_freq;
-	ibool			skip = FALSE;
 	fts_string_t		term;
 	byte			buf[FTS_MAX_WORD_LEN + 1];
-	dberr_t			error = DB_SUCCESS;
 
 	ut_a(query->cur_node->type == FTS_AST_TERM
 	     || query->cur_node->type == FTS_AST_TEXT
 	     || query->cur_node->type == FTS_AST_PARSER_PHRASE_LIST);
 
-	memset(&node, 0, sizeof(node));
 	term.f_str = buf;
 
 	/* Need to consider the wildcard search case, the word frequency
@@ -3395,12 +3415,43 @@ fts_query_read_node(
 
 	word_freq = rbt_value(fts_word_freq_t, parent.last);
 
-	/* Start from 1 since the first column has been read by the caller.
-	Also, we rely on the order of the columns projected, to filter
-	out ilists that are out of range and we always want to read
-	the doc_count irrespective of the suitablility of the row. */
+	/* We always want to read the doc_count irrespective of
+	the suitablility of the row. */
+	word_freq->doc_count += node->doc_count;
+
+	/* Skip nodes whose doc ids are out range. */
+	if (query->oper == FTS_EXIST
+	    && ((query->upper_doc_id > 0
+		 && node->first_doc_id > query->upper_doc_id)
+		|| (query->lower_doc_id > 0
+		    && node->last_doc_id < query->lower_doc_id))) {
+		return(DB_SUCCESS);
+	}
+
+	return(fts_query_filter_doc_ids(
+		       query, &word_freq->word, word_freq,
+		       node, node->ilist, node->ilist_size, FALSE));
+}
+
+/*****************************************************************//**
+Read the FTS INDEX row.
+@return DB_SUCCESS if all go well. */
+static
+dberr_t
+fts_query_read_node(
+/*================*/
+	fts_query_t*		query,	/*!< in: query instance */
+	const fts_string_t*	word,	/*!< in: current word */
+	que_node_t*		exp)	/*!< in: query graph node */
+{
+	int			i;
+	fts_node_t		node;
+
+	memset(&node, 0, sizeof(node));
 
-	for (i = 1; exp && !skip; exp = que_node_get_next(exp), ++i) {
+	/* Start from 1 since the first column has been read by
+	the caller. */
+	for (i = 1; exp; exp = que_node_get_next(exp), ++i) {
 
 		dfield_t*	dfield = que_node_get_val(exp);
 		byte*		data = static_cast<byte*>(
@@ -3413,37 +3464,20 @@ fts_query_read_node(
 
 		switch (i) {
 		case 1: /* DOC_COUNT */
-			word_freq->doc_count += mach_read_from_4(data);
+			node.doc_count = mach_read_from_4(data);
 			break;
 
 		case 2: /* FIRST_DOC_ID */
 			node.first_doc_id = fts_read_doc_id(data);
-
-			/* Skip nodes whose doc ids are out range. */
-			if (query->oper == FTS_EXIST
-			    && query->upper_doc_id > 0
-			    && node.first_doc_id > query->upper_doc_id) {
-				skip = TRUE;
-			}
 			break;
 
 		case 3: /* LAST_DOC_ID */
 			node.last_doc_id = fts_read_doc_id(data);
-
-			/* Skip nodes whose doc ids are out range. */
-			if (query->oper == FTS_EXIST
-			    && query->lower_doc_id > 0
-			    && node.last_doc_id < query->lower_doc_id) {
-				skip = TRUE;
-			}
 			break;
 
 		case 4: /* ILIST */
-
-			error = fts_query_filter_doc_ids(
-					query, &word_freq->word, word_freq,
-					&node, data, len, FALSE);
-
+			node.ilist = data;
+			node.ilist_size = len;
 			break;
 
 		default:
@@ -3451,13 +3485,14 @@ fts_query_read_node(
 		}
 	}
 
-	if (!skip) {
-		/* Make sure all columns were read. */
+	/* Make sure all columns were read. */
+	ut_a(i == 5);
 
-		ut_a(i == 5);
+	if (query->postings) {
+		query->postings->add(*word, node);
 	}
 
-	return error;
+	return(fts_query_process_node(query, word, &node));
 }
 
 /*****************************************************************//**
@@ -3495,6 +3530,189 @@ fts_query_index_fetch_nodes(
 	}
 }
 
+void fts_postings_t::add(const fts_string_t &word, const fts_node_t &node)
+{
+  row_t row;
+  row.word= data.size();
+  row.word_len= word.f_len;
+  row.ilist= row.word + word.f_len;
+  row.ilist_size= node.ilist_size;
+  row.doc_count= node.doc_count;
+  row.first_doc_id= node.first_doc_id;
+  row.last_doc_id= node.last_doc_id;
+  data.insert(data.end(), word.f_str, word.f_str + word.f_len);
+  data.insert(data.end(), node.ilist, node.ilist + node.ilist_size);
+  rows.push_back(row);
+}
+
+std::string fts_postings_cache_t::key(index_id_t index_id,
+                                      const fts_string_t &word)
+{
+  std::string key(reinterpret_cast<const char*>(&index_id),
+                  sizeof index_id);
+  key.append(reinterpret_cast<const char*>(word.f_str), word.f_len);
+  return key;
+}
+
+fts_postings_cache_t::postings_ptr
+fts_postings_cache_t::find(const std::string &key)
+{
+  postings_ptr postings;
+  mutex.wr_lock();
+  auto i= map.find(key);
+  if (i != map.end())
+  {
+    lru.splice(lru.begin(), lru, i->second);
+    postings= i->second->second;
+  }
+  mutex.wr_unlock();
+  return postings;
+}
+
+uint64_t fts_postings_cache_t::get_generation()
+{
+  mutex.wr_lock();
+  const uint64_t g= generation;
+  mutex.wr_unlock();
+  return g;
+}
+
+void fts_postings_cache_t::evict()
+{
+  ut_ad(!lru.empty());
+  const size_t size= lru.back().first.size() + lru.back().second->size();
+  total_size-= size;
+  fts_postings_cache_used-= size;
+  map.erase(lru.back().first);
+  lru.pop_back();
+}
+
+void fts_postings_cache_t::insert(std::string &&key, postings_ptr postings,
+                                  uint64_t generation, size_t limit)
+{
+  const size_t size= key.size() + postings->size();
+  if (size > limit)
+    return;
+  mutex.wr_lock();
+  if (generation == this->generation && map.find(key) == map.end())
+  {
+    /* Only the posting lists of this table can be evicted here.
+    If the other tables use too much of the limit, do not cache. */
+    while (fts_postings_cache_used.add(size) + size > limit)
+    {
+      fts_postings_cache_used-= size;
+      if (lru.empty())
+        goto func_exit;
+      evict();
+    }
+    lru.emplace_front(std::move(key), std::move(postings));
+    map.emplace(lru.front().first, lru.begin());
+    total_size+= size;
+  }
+func_exit:
+  mutex.wr_unlock();
+}
+
+void fts_postings_cache_t::invalidate()
+{
+  lru_list discarded;
+  mutex.wr_lock();
+  generation++;
+  map.clear();
+  discarded.swap(lru);
+  fts_postings_cache_used-= total_size;
+  total_size= 0;
+  mutex.wr_unlock();
+  /* The posting lists will be freed here, unless they are
+  being used by fts_query_fetch_nodes(). */
+}
+
+/** Read the FTS INDEX rows that match a search string, from the posting
+list cache if possible.
+@param query	query instance
+@param graph	prepared statement
+@param token	the search string
+@param fetch	fetch callback
+@return DB_SUCCESS or error code */
+static
+dberr_t
+fts_query_fetch_nodes(
+	fts_query_t*		query,
+	que_t**			graph,
+	const fts_string_t*	token,
+	fts_fetch_t*		fetch)
+{
+	const size_t	limit = fts_postings_cache_size;
+
+	if (!limit) {
+		return(fts_index_fetch_nodes(query->trx, graph,
+					     &query->fts_index_table,
+					     token, fetch));
+	}
+
+	fts_postings_cache_t*	cache
+		= query->index->table->fts->cache->postings;
+	std::string	key = fts_postings_cache_t::key(
+		query->index->id, *token);
+
+	if (fts_postings_cache_t::postings_ptr postings = cache->find(key)) {
+		fts_postings_cache_hits++;
+
+		/* Process the rows like fts_query_index_fetch_nodes()
+		would have done. */
+		for (const fts_postings_t::row_t& row : postings->rows) {
+			fts_string_t	word;
+			fts_node_t	node;
+
+			word.f_str = const_cast<byte*>(
+				postings->data.data() + row.word);
+			word.f_len = row.word_len;
+
+			memset(&node, 0, sizeof(node));
+			node.doc_count = row.doc_count;
+			node.first_doc_id = row.first_doc_id;
+			node.last_doc_id = row.last_doc_id;
+			node.ilist = const_cast<byte*>(
+				postings->data.data() + row.ilist);
+			node.ilist_size = row.ilist_size;
+
+			/* Note: we pass error out by 'query->error' */
+			query->error = fts_query_process_node(
+				query, &word, &node);
+
+			if (query->error != DB_SUCCESS) {
+				ut_ad(query->error
+				      == DB_FTS_EXCEED_RESULT_CACHE_LIMIT);
+				break;
+			}
+		}
+
+		return(DB_SUCCESS);
+	}
+
+	auto		postings = std::make_shared<fts_postings_t>();
+
+	ut_ad(!query->postings);
+	query->postings = postings.get();
+
+	dberr_t	error = fts_index_fetch_nodes(
+		query->trx, graph, &query->fts_index_table, token, fetch);
+
+	query->postings = NULL;
+
+	DEBUG_SYNC_C("fts_query_fetch_nodes");
+
+	/* Only cache complete posting lists. If a change of the FTS
+	INDEX table was committed after the read view of query->trx
+	was created, the rows may be stale and will not be cached. */
+	if (error == DB_SUCCESS && query->error == DB_SUCCESS) {
+		cache->insert(std::move(key), std::move(postings),
+			      query->postings_generation, limit);
+	}
+
+	return(error);
+}
+
 /*****************************************************************//**
 Calculate the inverse document frequency (IDF) for all the terms. */
 static
@@ -3970,6 +4188,14 @@ fts_query(
 
 	*result = NULL;
 	memset(&query, 0x0, sizeof(query));
+
+	/* Any change of the FTS INDEX tables that is committed after
+	this will prevent the rows that this query reads from being
+	added to the posting list cache. This must be read before the
+	read view of query_trx is created. */
+	query.postings_generation
+		= index->table->fts->cache->postings->get_generation();
+
 	query_trx = trx_create();
 	query_trx->op_info = "FTS query";
 
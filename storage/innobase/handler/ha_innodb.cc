@@ -98,6 +98,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "row0log.h"
 #include "row0merge.h"
 #include "row0mysql.h"
+#include "row0pread.h"
 #include "row0quiesce.h"
 #include "row0sel.h"
 #include "row0upd.h"
@@ -396,6 +397,21 @@ static TYPELIB innodb_deadlock_report_typelib = {
 	NULL
 };
 
+/** Allowed values of innodb_buffer_pool_dump_format */
+static const char *innodb_buffer_pool_dump_format_names[]= {
+	"text", /* SRV_BUF_DUMP_TEXT */
+	"binary", /* SRV_BUF_DUMP_BINARY */
+	NullS
+};
+
+/** Enumeration of innodb_buffer_pool_dump_format */
+static TYPELIB innodb_buffer_pool_dump_format_typelib = {
+	array_elements(innodb_buffer_pool_dump_format_names) - 1,
+	"innodb_buffer_pool_dump_format_typelib",
+	innodb_buffer_pool_dump_format_names,
+	NULL
+};
+
 /** Allowed values of innodb_change_buffering */
 static const char* innodb_change_buffering_names[] = {
 	"none",		/* IBUF_USE_NONE */
@@ -889,6 +905,12 @@ static MYSQL_THDVAR_UINT(lock_wait_timeout, PLUGIN_VAR_RQCMDARG,
   "Timeout in seconds an InnoDB transaction may wait for a lock before being rolled back. The value 100000000 is infinite timeout.",
   NULL, NULL, 50, 0, 100000000, 0);
 
+static MYSQL_THDVAR_UINT(parallel_read_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads for counting the rows of a table"
+  " in SELECT COUNT(*) without a WHERE clause (1=disable)."
+  " The threads of all sessions together are limited to the number of CPUs",
+  NULL, NULL, 1, 1, 256, 0);
+
 static MYSQL_THDVAR_STR(ft_user_stopword_table,
   PLUGIN_VAR_OPCMDARG|PLUGIN_VAR_MEMALLOC,
   "User supplied stopword table name, effective in the session level.",
@@ -914,6 +936,17 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_buffer_pool_resize_status,  SHOW_CHAR},
   {"buffer_pool_load_incomplete",
   &export_vars.innodb_buffer_pool_load_incomplete,        SHOW_BOOL},
+  {"buffer_pool_adaptive_read_requests",
+   &export_vars.innodb_buffer_pool_adaptive_read_requests, SHOW_SIZE_T},
+  {"buffer_pool_adaptive_reads",
+   &export_vars.innodb_buffer_pool_adaptive_reads, SHOW_SIZE_T},
+  {"buffer_pool_ghost_hits_new", &buf_pool.stat.n_ghost_hits_new, SHOW_SIZE_T},
+  {"buffer_pool_ghost_hits_old", &buf_pool.stat.n_ghost_hits_old, SHOW_SIZE_T},
+  {"buffer_pool_lru_old_ratio", &buf_pool.LRU_old_ratio, SHOW_SIZE_T},
+  {"buffer_pool_midpoint_read_requests",
+   &export_vars.innodb_buffer_pool_midpoint_read_requests, SHOW_SIZE_T},
+  {"buffer_pool_midpoint_reads",
+   &export_vars.innodb_buffer_pool_midpoint_reads, SHOW_SIZE_T},
   {"buffer_pool_pages_data", &UT_LIST_GET_LEN(buf_pool.LRU), SHOW_SIZE_T},
   {"buffer_pool_bytes_data",
    &export_vars.innodb_buffer_pool_bytes_data, SHOW_SIZE_T},
@@ -960,7 +993,11 @@ static SHOW_VAR innodb_status_variables[]= {
   {"data_written", &export_vars.innodb_data_written, SHOW_SIZE_T},
   {"dblwr_pages_written", &export_vars.innodb_dblwr_pages_written,SHOW_SIZE_T},
   {"dblwr_writes", &export_vars.innodb_dblwr_writes, SHOW_SIZE_T},
+  {"dblwr_compact_writes", &export_vars.innodb_dblwr_compact_writes,
+   SHOW_SIZE_T},
   {"deadlocks", &lock_sys.deadlocks, SHOW_SIZE_T},
+  {"ft_postings_cache_hits", (size_t*) &fts_postings_cache_hits,
+   SHOW_SIZE_T},
   {"history_list_length", &export_vars.innodb_history_list_length,SHOW_SIZE_T},
   {"ibuf_discarded_delete_marks", &ibuf.n_discarded_ops[IBUF_OP_DELETE_MARK],
    SHOW_SIZE_T},
@@ -995,6 +1032,14 @@ static SHOW_VAR innodb_status_variables[]= {
   {"pages_created", &buf_pool.stat.n_pages_created, SHOW_SIZE_T},
   {"pages_read", &buf_pool.stat.n_pages_read, SHOW_SIZE_T},
   {"pages_written", &buf_pool.stat.n_pages_written, SHOW_SIZE_T},
+#ifdef UNIV_DEBUG
+  {"prefetch_cache_grown",
+   &export_vars.innodb_prefetch_cache_grown, SHOW_SIZE_T},
+  {"prefetch_cache_shrunk",
+   &export_vars.innodb_prefetch_cache_shrunk, SHOW_SIZE_T},
+#endif /* UNIV_DEBUG */
+  {"purge_lag_seconds", &export_vars.innodb_purge_lag_seconds, SHOW_SIZE_T},
+  {"purge_threads_used", &export_vars.innodb_purge_threads_used, SHOW_SIZE_T},
   {"row_lock_current_waits", &export_vars.innodb_row_lock_current_waits,
    SHOW_SIZE_T},
   {"row_lock_time", &export_vars.innodb_row_lock_time, SHOW_LONGLONG},
@@ -4225,6 +4270,9 @@ static int innodb_init(void* p)
 
 	innobase_old_blocks_pct = buf_LRU_old_ratio_update(
 		innobase_old_blocks_pct, true);
+	if (buf_LRU_policy != BUF_LRU_MIDPOINT) {
+		buf_LRU_policy_update(buf_LRU_policy);
+	}
 
 	ibuf_max_size_update(srv_change_buffer_max_size);
 
@@ -5028,6 +5076,10 @@ ha_innobase::table_flags() const
 	/* Need to use tx_isolation here since table flags is (also)
 	called before prebuilt is inited. */
 
+	if (THDVAR(thd, parallel_read_threads) > 1) {
+		flags |= HA_HAS_RECORDS;
+	}
+
 	if (thd_tx_isolation(thd) <= ISO_READ_COMMITTED) {
 		return(flags);
 	}
@@ -14328,6 +14380,68 @@ ha_innobase::records_in_range(
 	DBUG_RETURN((ha_rows) n_rows);
 }
 
+/** Count the rows that are visible to the current statement.
+This is invoked for SELECT COUNT(*) without a WHERE clause when
+table_flags() includes HA_HAS_RECORDS.
+@return number of rows
+@retval HA_POS_ERROR if the rows must be counted by a table scan */
+ha_rows ha_innobase::records()
+{
+	DBUG_ENTER("ha_innobase::records");
+
+	const uint n_threads = THDVAR(ha_thd(), parallel_read_threads);
+
+	if (n_threads <= 1) {
+		/* Some callers invoke this regardless of HA_HAS_RECORDS
+		and only expect an estimate. */
+		DBUG_RETURN(handler::records());
+	}
+
+	switch (thd_sql_command(ha_thd())) {
+	case SQLCOM_ALTER_TABLE:
+	case SQLCOM_OPTIMIZE:
+		/* copy_data_between_tables() only needs an estimate
+		for the progress report. */
+		DBUG_RETURN(handler::records());
+	default:
+		break;
+	}
+
+	update_thd(ha_thd());
+
+	dict_table_t*	ib_table = m_prebuilt->table;
+	trx_t*		trx = m_prebuilt->trx;
+
+	/* Locking reads, discarded or corrupted tables and tables that
+	were rebuilt after the read view was created are handled by
+	row_search_mvcc() in the ordinary table scan. */
+	if (m_prebuilt->select_lock_type != LOCK_NONE
+	    || !ib_table->is_accessible() || ib_table->no_rollback()
+	    || !row_merge_is_index_usable(
+		    trx, dict_table_get_first_index(ib_table))) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	trx->op_info = "counting rows";
+	trx_start_if_not_started(trx, false);
+	trx->read_view.open(trx);
+
+	ulint	n_rows;
+	dberr_t	err = row_count_parallel(m_prebuilt, n_threads, &n_rows);
+
+	trx->op_info = "";
+
+	DBUG_EXECUTE_IF("innodb_report_parallel_count",
+			push_warning_printf(m_user_thd,
+					    Sql_condition::WARN_LEVEL_NOTE,
+					    ER_UNKNOWN_ERROR,
+					    "DBUG: counted %zu rows of %s",
+					    size_t(n_rows),
+					    table->s->table_name.str););
+
+	DBUG_RETURN(err == DB_SUCCESS ? ha_rows(n_rows) : HA_POS_ERROR);
+}
+
 /*********************************************************************//**
 Gives an UPPER BOUND to the number of rows in a table. This is used in
 filesort.cc.
@@ -15733,6 +15847,16 @@ ha_innobase::reset()
 
 	reset_template();
 
+	/* Release a prefetch cache that grew during a long scan. It will
+	be allocated at the initial size again when it is needed. */
+	if (m_prebuilt->fetch_cache_alloc > MYSQL_FETCH_CACHE_SIZE) {
+		m_prebuilt->n_fetch_cached = 0;
+		m_prebuilt->fetch_cache_first = 0;
+		m_prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
+		row_sel_prefetch_cache_free(m_prebuilt);
+		ut_d(srv_stats.n_prefetch_shrunk.inc());
+	}
+
 	m_ds_mrr.dsmrr_close();
 
 	/* TODO: This should really be reset in reset_template() but for now
@@ -18823,6 +18947,13 @@ static MYSQL_SYSVAR_BOOL(doublewrite, srv_use_doublewrite_buf,
   " Disable with --skip-innodb-doublewrite.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(doublewrite_compact, srv_doublewrite_compact,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Write only the payload of page_compressed and ROW_FORMAT=COMPRESSED"
+  " pages to the doublewrite buffer, protected by one CRC-32C checksum"
+  " per batch, when this makes the batch shorter",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, srv_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Enable atomic writes, instead of using the doublewrite buffer, for files "
@@ -19042,6 +19173,20 @@ static MYSQL_SYSVAR_ULONGLONG(stats_persistent_sample_pages,
   " statistics (by ANALYZE, default 20)",
   NULL, NULL, 20, 1, ~0ULL, 0);
 
+static MYSQL_SYSVAR_UINT(stats_analyze_threads, srv_stats_analyze_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that analyze the indexes of a table in parallel"
+  " when calculating persistent statistics",
+  NULL, NULL, 1, 1, 64, 0);
+
+static MYSQL_SYSVAR_UINT(stats_random_dive_confidence,
+  srv_stats_random_dive_confidence,
+  PLUGIN_VAR_RQCMDARG,
+  "Confidence level in percent for sampling random leaf pages until"
+  " the persistent statistics estimate is within 10%, or 0 to sample"
+  " innodb_stats_persistent_sample_pages pages per key prefix (default)",
+  NULL, NULL, 0, 0, 99, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(stats_modified_counter, srv_stats_modified_counter,
   PLUGIN_VAR_RQCMDARG,
   "The number of rows modified before we calculate new statistics (default 0 = current limits)",
@@ -19107,6 +19252,19 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_dump_pct, srv_buf_pool_dump_pct,
   "Dump only the hottest N% of each buffer pool, defaults to 25",
   NULL, NULL, 25, 1, 100, 0);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_dump_interval, srv_buf_pool_dump_interval,
+  PLUGIN_VAR_RQCMDARG,
+  "Dump the buffer pool every N seconds, so that it can be loaded after a crash"
+  " (0 to disable)",
+  NULL, NULL, 0, 0, 86400, 0);
+
+static MYSQL_SYSVAR_ENUM(buffer_pool_dump_format, srv_buf_pool_dump_format,
+  PLUGIN_VAR_RQCMDARG,
+  "Format of the buffer pool dump file. TEXT lists the pages in LRU order;"
+  " BINARY is compact and lets a dump append only the changes to the"
+  " previous one",
+  NULL, NULL, SRV_BUF_DUMP_TEXT, &innodb_buffer_pool_dump_format_typelib);
+
 #ifdef UNIV_DEBUG
 /* Added to test the innodb_buffer_pool_load_incomplete status variable. */
 static MYSQL_SYSVAR_ULONG(buffer_pool_load_pages_abort, srv_buf_pool_load_pages_abort,
@@ -19130,6 +19288,11 @@ static MYSQL_SYSVAR_BOOL(buffer_pool_load_abort, innodb_buffer_pool_load_abort,
   "Abort a currently running load of the buffer pool",
   NULL, buffer_pool_load_abort, FALSE);
 
+static MYSQL_SYSVAR_UINT(buffer_pool_load_threads, srv_buf_pool_load_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that submit the page reads of a buffer pool load",
+  NULL, NULL, 1, 1, 64, 0);
+
 /* there is no point in changing this during runtime, thus readonly */
 static MYSQL_SYSVAR_BOOL(buffer_pool_load_at_startup, srv_buffer_pool_load_at_startup,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
@@ -19220,6 +19383,24 @@ static MYSQL_SYSVAR_ENUM(deadlock_report, innodb_deadlock_report,
   "How to report deadlocks (if innodb_deadlock_detect=ON).",
   NULL, NULL, Deadlock::REPORT_FULL, &innodb_deadlock_report_typelib);
 
+/** Update innodb_deadlock_detect_interval */
+static void innodb_deadlock_detect_interval_update(THD*, st_mysql_sys_var*,
+                                                   void*, const void *save)
+{
+  innodb_deadlock_detect_interval= *static_cast<const uint*>(save);
+  mysql_mutex_unlock(&LOCK_global_system_variables);
+  lock_deadlock_detect_update();
+  mysql_mutex_lock(&LOCK_global_system_variables);
+}
+
+static MYSQL_SYSVAR_UINT(deadlock_detect_interval,
+  innodb_deadlock_detect_interval,
+  PLUGIN_VAR_RQCMDARG,
+  "Interval in milliseconds between runs of the background deadlock"
+  " detector (if innodb_deadlock_detect=ON)."
+  " 0 (the default) searches for a deadlock on every lock wait.",
+  NULL, innodb_deadlock_detect_interval_update, 0, 0, 10000, 0);
+
 static MYSQL_SYSVAR_UINT(fill_factor, innobase_fill_factor,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of B-tree page filled during bulk insert",
@@ -19275,6 +19456,12 @@ static MYSQL_SYSVAR_SIZE_T(ft_result_cache_limit, fts_result_cache_limit,
   "InnoDB Fulltext search query result cache limit in bytes",
   NULL, NULL, 2000000000L, 1000000L, SIZE_T_MAX, 0);
 
+static MYSQL_SYSVAR_SIZE_T(ft_postings_cache_size, fts_postings_cache_size,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum total size in bytes of the InnoDB Fulltext search posting"
+  " lists that are cached for queries, or 0 to disable (default)",
+  NULL, NULL, 0, 0, SIZE_T_MAX, 0);
+
 static MYSQL_SYSVAR_ULONG(ft_min_token_size, fts_min_token_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "InnoDB Fulltext search minimum token size in characters",
@@ -19290,6 +19477,12 @@ static MYSQL_SYSVAR_ULONG(ft_num_word_optimize, fts_num_word_optimize,
   "InnoDB Fulltext search number of words to optimize for each optimize table call ",
   NULL, NULL, 2000, 1000, 10000, 0);
 
+static MYSQL_SYSVAR_UINT(ft_optimize_threads, fts_optimize_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that optimize the auxiliary INDEX tables of an"
+  " InnoDB Fulltext search index in parallel",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(ft_sort_pll_degree, fts_sort_pll_degree,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "InnoDB Fulltext search parallel sort degree, will round up to nearest power of 2 number",
@@ -19300,6 +19493,11 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(merge_sort_threads, srv_merge_sort_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads for merging sorted runs in index creation (1=disable)",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -19361,6 +19559,42 @@ static MYSQL_SYSVAR_UINT(old_blocks_time, buf_LRU_old_threshold_ms,
   " The timeout is disabled if 0.",
   NULL, NULL, 1000, 0, UINT_MAX32, 0);
 
+static const char *innodb_lru_policy_names[]=
+{
+  "midpoint",
+  "adaptive",
+  NullS
+};
+
+static TYPELIB innodb_lru_policy_typelib=
+{
+  array_elements(innodb_lru_policy_names) - 1,
+  "innodb_lru_policy_typelib",
+  innodb_lru_policy_names,
+  NULL
+};
+
+/** Update innodb_lru_policy */
+static void innodb_lru_policy_update(THD*, st_mysql_sys_var*, void*,
+                                     const void *save)
+{
+  const ulong policy= *static_cast<const ulong*>(save);
+  mysql_mutex_unlock(&LOCK_global_system_variables);
+  buf_LRU_policy_update(policy);
+  if (policy == BUF_LRU_MIDPOINT)
+    /* Revert any adaptation of the "old" sublist length. */
+    buf_LRU_old_ratio_update(innobase_old_blocks_pct, true);
+  mysql_mutex_lock(&LOCK_global_system_variables);
+}
+
+static MYSQL_SYSVAR_ENUM(lru_policy, buf_LRU_policy,
+  PLUGIN_VAR_RQCMDARG,
+  "Buffer pool replacement policy: midpoint (with innodb_old_blocks_pct"
+  " \"old\" blocks) or adaptive (innodb_old_blocks_pct is only the"
+  " initial value, adjusted based on accesses to recently evicted pages)",
+  NULL, innodb_lru_policy_update, BUF_LRU_MIDPOINT,
+  &innodb_lru_policy_typelib);
+
 static MYSQL_SYSVAR_ULONG(open_files, innobase_open_files,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "How many files at the maximum InnoDB keeps open at the same time.",
@@ -19541,6 +19775,12 @@ static MYSQL_SYSVAR_ULONG(read_ahead_threshold, srv_read_ahead_threshold,
   " trigger a readahead.",
   NULL, NULL, 56, 0, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(read_ahead_leaf_pages, srv_read_ahead_leaf_pages,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of pages to read ahead of a scan that follows the"
+  " chain of index leaf pages (0=disable)",
+  NULL, NULL, 0, 0, 256, 0);
+
 static MYSQL_SYSVAR_STR(monitor_enable, innobase_enable_monitor_counter,
   PLUGIN_VAR_RQCMDARG,
   "Turn on a monitor counter",
@@ -19602,6 +19842,12 @@ static MYSQL_SYSVAR_BOOL(read_only_compressed, innodb_read_only_compressed,
   "Make ROW_FORMAT=COMPRESSED tables read-only",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_BOOL(read_view_active_array, srv_read_view_active_array,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Create read views from a dense array of active transactions"
+  " instead of the transaction hash table",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_BOOL(cmp_per_index_enabled, srv_cmp_per_index_enabled,
   PLUGIN_VAR_OPCMDARG,
   "Enable INFORMATION_SCHEMA.innodb_cmp_per_index,"
@@ -19750,11 +19996,14 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_dump_now),
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
   MYSQL_SYSVAR(buffer_pool_dump_pct),
+  MYSQL_SYSVAR(buffer_pool_dump_interval),
+  MYSQL_SYSVAR(buffer_pool_dump_format),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_evict),
 #endif /* UNIV_DEBUG */
   MYSQL_SYSVAR(buffer_pool_load_now),
   MYSQL_SYSVAR(buffer_pool_load_abort),
+  MYSQL_SYSVAR(buffer_pool_load_threads),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_load_pages_abort),
 #endif /* UNIV_DEBUG */
@@ -19767,6 +20016,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(defragment_frequency),
   MYSQL_SYSVAR(lru_scan_depth),
   MYSQL_SYSVAR(lru_flush_size),
+  MYSQL_SYSVAR(lru_policy),
   MYSQL_SYSVAR(flush_neighbors),
   MYSQL_SYSVAR(checksum_algorithm),
   MYSQL_SYSVAR(compression_level),
@@ -19774,6 +20024,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(temp_data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(doublewrite_compact),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(use_atomic_writes),
   MYSQL_SYSVAR(fast_shutdown),
@@ -19788,13 +20039,17 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(ft_cache_size),
   MYSQL_SYSVAR(ft_total_cache_size),
   MYSQL_SYSVAR(ft_result_cache_limit),
+  MYSQL_SYSVAR(ft_postings_cache_size),
   MYSQL_SYSVAR(ft_enable_stopword),
   MYSQL_SYSVAR(ft_max_token_size),
   MYSQL_SYSVAR(ft_min_token_size),
   MYSQL_SYSVAR(ft_num_word_optimize),
+  MYSQL_SYSVAR(ft_optimize_threads),
   MYSQL_SYSVAR(ft_sort_pll_degree),
   MYSQL_SYSVAR(lock_wait_timeout),
+  MYSQL_SYSVAR(parallel_read_threads),
   MYSQL_SYSVAR(deadlock_detect),
+  MYSQL_SYSVAR(deadlock_detect_interval),
   MYSQL_SYSVAR(deadlock_report),
   MYSQL_SYSVAR(page_size),
   MYSQL_SYSVAR(log_buffer_size),
@@ -19827,6 +20082,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_persistent),
   MYSQL_SYSVAR(stats_persistent_sample_pages),
   MYSQL_SYSVAR(stats_auto_recalc),
+  MYSQL_SYSVAR(stats_analyze_threads),
+  MYSQL_SYSVAR(stats_random_dive_confidence),
   MYSQL_SYSVAR(stats_modified_counter),
   MYSQL_SYSVAR(stats_traditional),
 #ifdef BTR_CUR_HASH_ADAPT
@@ -19837,6 +20094,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(merge_sort_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -19857,8 +20115,10 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
   MYSQL_SYSVAR(random_read_ahead),
   MYSQL_SYSVAR(read_ahead_threshold),
+  MYSQL_SYSVAR(read_ahead_leaf_pages),
   MYSQL_SYSVAR(read_only),
   MYSQL_SYSVAR(read_only_compressed),
+  MYSQL_SYSVAR(read_view_active_array),
   MYSQL_SYSVAR(instant_alter_column_allowed),
   MYSQL_SYSVAR(io_capacity),
   MYSQL_SYSVAR(io_capacity_max),
@@ -19958,7 +20218,10 @@ i_s_innodb_sys_foreign,
 i_s_innodb_sys_foreign_cols,
 i_s_innodb_sys_tablespaces,
 i_s_innodb_sys_virtual,
-i_s_innodb_tablespaces_encryption
+i_s_innodb_tablespaces_encryption,
+i_s_innodb_adaptive_hash_per_index,
+i_s_innodb_lock_wait_graph,
+i_s_innodb_rollback_segments
 maria_declare_plugin_end;
 
 /** @brief Adjust some InnoDB startup parameters based on file contents
@@ -186,6 +186,8 @@ class ha_innobase final : public handler
                 const key_range*        max_key,
                 page_range*             pages) override;
 
+	ha_rows records() override;
+
 	ha_rows estimate_rows_upper_bound() override;
 
 	void update_create_info(HA_CREATE_INFO* create_info) override;
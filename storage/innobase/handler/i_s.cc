@@ -45,12 +45,16 @@ Created July 18, 2007 Vasil Dimov
 #include "srv0start.h"
 #include "trx0i_s.h"
 #include "trx0trx.h"
+#include "trx0sys.h"
+#include "trx0undo.h"
+#include "lock0lock.h"
 #include "srv0mon.h"
 #include "pars0pars.h"
 #include "fts0types.h"
 #include "fts0opt.h"
 #include "fts0priv.h"
 #include "btr0btr.h"
+#include "btr0sea.h"
 #include "page0zip.h"
 #include "fil0fil.h"
 #include "fil0crypt.h"
@@ -6618,6 +6622,12 @@ static ST_FIELD_INFO innodb_tablespaces_encryption_fields_info[]=
 #define TABLESPACES_ENCRYPTION_ROTATING_OR_FLUSHING 9
   Column("ROTATING_OR_FLUSHING", SLong(1), NOT_NULL),
 
+#define TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_PER_SECOND 10
+  Column("KEY_ROTATION_PAGES_PER_SECOND", ULonglong(), NULLABLE),
+
+#define TABLESPACES_ENCRYPTION_KEY_ROTATION_ETA_SECONDS 11
+  Column("KEY_ROTATION_ETA_SECONDS", ULonglong(), NULLABLE),
+
   CEnd()
 };
 } // namespace Show
@@ -6698,6 +6708,22 @@ i_s_dict_fill_tablespaces_encryption(
 			->set_null();
 	}
 
+	if (status.rotate_pages_per_second) {
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_PER_SECOND]
+			->set_notnull();
+		OK(fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_PER_SECOND]
+		   ->store(status.rotate_pages_per_second, true));
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_ETA_SECONDS]
+			->set_notnull();
+		OK(fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_ETA_SECONDS]
+		   ->store(status.rotate_eta_seconds, true));
+	} else {
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_PER_SECOND]
+			->set_null();
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_ETA_SECONDS]
+			->set_null();
+	}
+
 	OK(schema_table_store_record(thd, table_to_fill));
 
 skip:
@@ -6818,3 +6844,436 @@ struct st_maria_plugin	i_s_innodb_tablespaces_encryption =
 	INNODB_VERSION_STR,
 	MariaDB_PLUGIN_MATURITY_STABLE
 };
+
+namespace Show {
+/** Fields of INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PER_INDEX */
+static ST_FIELD_INFO innodb_adaptive_hash_per_index_fields_info[]=
+{
+#define AHI_DATABASE_NAME	0
+  Column("DATABASE_NAME", Varchar(NAME_CHAR_LEN), NOT_NULL),
+
+#define AHI_TABLE_NAME		1
+  Column("TABLE_NAME", Varchar(NAME_CHAR_LEN), NOT_NULL),
+
+#define AHI_INDEX_NAME		2
+  Column("INDEX_NAME", Varchar(NAME_CHAR_LEN), NOT_NULL),
+
+#define AHI_PAGES		3
+  Column("PAGES", ULonglong(), NOT_NULL),
+
+#define AHI_HITS		4
+  Column("HITS", ULonglong(), NOT_NULL),
+
+#define AHI_MISSES		5
+  Column("MISSES", ULonglong(), NOT_NULL),
+
+#define AHI_RETRIES		6
+  Column("RETRIES", ULonglong(), NOT_NULL),
+
+  CEnd()
+};
+} // namespace Show
+
+#ifdef BTR_CUR_HASH_ADAPT
+/** Fill a row of INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PER_INDEX
+for each index of a table that the adaptive hash index was used for.
+@param thd    connection
+@param table  table in the data dictionary cache
+@param t      I_S table to fill
+@return 0 on success */
+static int i_s_adaptive_hash_per_index_fill(THD *thd,
+                                            const dict_table_t &table,
+                                            TABLE *t)
+{
+  DBUG_ENTER("i_s_adaptive_hash_per_index_fill");
+  Field **fields= t->field;
+  char db_utf8[MAX_DB_UTF8_LEN];
+  char table_utf8[MAX_TABLE_UTF8_LEN];
+  bool converted= false;
+
+  for (const dict_index_t *index= dict_table_get_first_index(&table); index;
+       index= dict_table_get_next_index(index))
+  {
+    const btr_search_t *info= index->search_info;
+    if (!info)
+      continue;
+    using shard= btr_search_t::stats_t::shard;
+    const ulint hits= info->n_hash.sum(&shard::hits);
+    const ulint misses= info->n_hash.sum(&shard::misses);
+    const ulint retries= info->n_hash.sum(&shard::retries);
+    if (!(info->ref_count || hits || misses || retries))
+      continue;
+
+    if (!converted)
+    {
+      dict_fs2utf8(table.name.m_name, db_utf8, sizeof db_utf8,
+                   table_utf8, sizeof table_utf8);
+      converted= true;
+    }
+
+    OK(field_store_string(fields[AHI_DATABASE_NAME], db_utf8));
+    OK(field_store_string(fields[AHI_TABLE_NAME], table_utf8));
+    OK(field_store_string(fields[AHI_INDEX_NAME], index->name));
+    OK(fields[AHI_PAGES]->store(info->ref_count, true));
+    OK(fields[AHI_HITS]->store(hits, true));
+    OK(fields[AHI_MISSES]->store(misses, true));
+    OK(fields[AHI_RETRIES]->store(retries, true));
+    OK(schema_table_store_record(thd, t));
+  }
+
+  DBUG_RETURN(0);
+}
+#endif /* BTR_CUR_HASH_ADAPT */
+
+/** Populate INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PER_INDEX
+from the indexes in the data dictionary cache.
+@return 0 on success */
+static int i_s_adaptive_hash_per_index_fill_table(THD *thd,
+                                                  TABLE_LIST *tables, Item*)
+{
+  DBUG_ENTER("i_s_adaptive_hash_per_index_fill_table");
+  RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+  /* deny access to user without PROCESS_ACL privilege */
+  if (check_global_access(thd, PROCESS_ACL))
+    DBUG_RETURN(0);
+
+  int err= 0;
+#ifdef BTR_CUR_HASH_ADAPT
+  dict_sys.freeze(SRW_LOCK_CALL);
+
+  for (const dict_table_t *table= UT_LIST_GET_FIRST(dict_sys.table_LRU);
+       table && !err; table= UT_LIST_GET_NEXT(table_LRU, table))
+    err= i_s_adaptive_hash_per_index_fill(thd, *table, tables->table);
+
+  for (const dict_table_t *table= UT_LIST_GET_FIRST(dict_sys.table_non_LRU);
+       table && !err; table= UT_LIST_GET_NEXT(table_LRU, table))
+    err= i_s_adaptive_hash_per_index_fill(thd, *table, tables->table);
+
+  dict_sys.unfreeze();
+#endif /* BTR_CUR_HASH_ADAPT */
+  DBUG_RETURN(err);
+}
+
+/** Bind the dynamic table INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PER_INDEX
+@param p  table schema object
+@return 0 on success */
+static int innodb_adaptive_hash_per_index_init(void *p)
+{
+  DBUG_ENTER("innodb_adaptive_hash_per_index_init");
+  ST_SCHEMA_TABLE *schema= static_cast<ST_SCHEMA_TABLE*>(p);
+  schema->fields_info= Show::innodb_adaptive_hash_per_index_fields_info;
+  schema->fill_table= i_s_adaptive_hash_per_index_fill_table;
+  DBUG_RETURN(0);
+}
+
+struct st_maria_plugin	i_s_innodb_adaptive_hash_per_index =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	MYSQL_INFORMATION_SCHEMA_PLUGIN,
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	&i_s_info,
+
+	/* plugin name */
+	/* const char* */
+	"INNODB_ADAPTIVE_HASH_PER_INDEX",
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	plugin_author,
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	"InnoDB adaptive hash index usage per index",
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	PLUGIN_LICENSE_GPL,
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	innodb_adaptive_hash_per_index_init,
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	i_s_common_deinit,
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	INNODB_VERSION_SHORT,
+
+	/* struct st_mysql_show_var* */
+	NULL,
+
+	/* struct st_mysql_sys_var** */
+	NULL,
+
+	/* Maria extension */
+	INNODB_VERSION_STR,
+	MariaDB_PLUGIN_MATURITY_STABLE
+};
+
+namespace Show {
+/** Fields of INFORMATION_SCHEMA.INNODB_LOCK_WAIT_GRAPH */
+static ST_FIELD_INFO innodb_lock_wait_graph_fields_info[]=
+{
+#define LWG_REQUESTING_TRX_ID	0
+  Column("REQUESTING_TRX_ID", ULonglong(), NOT_NULL),
+
+#define LWG_BLOCKING_TRX_ID	1
+  Column("BLOCKING_TRX_ID", ULonglong(), NOT_NULL),
+
+#define LWG_LOCK_TYPE		2
+  Column("LOCK_TYPE", Varchar(32), NOT_NULL),
+
+#define LWG_WAIT_TIME_MS	3
+  Column("WAIT_TIME_MS", ULonglong(), NOT_NULL),
+
+#define LWG_IN_DEADLOCK		4
+  Column("IN_DEADLOCK", SLong(1), NOT_NULL),
+
+  CEnd()
+};
+} // namespace Show
+
+/** Populate INFORMATION_SCHEMA.INNODB_LOCK_WAIT_GRAPH
+from a snapshot of the waits-for graph.
+@return 0 on success */
+static int i_s_lock_wait_graph_fill_table(THD *thd, TABLE_LIST *tables, Item*)
+{
+  DBUG_ENTER("i_s_lock_wait_graph_fill_table");
+  RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+  /* deny access to user without PROCESS_ACL privilege */
+  if (check_global_access(thd, PROCESS_ACL))
+    DBUG_RETURN(0);
+
+  std::vector<lock_wait_edge_t> edges;
+  lock_wait_graph(edges);
+
+  TABLE *t= tables->table;
+  Field **fields= t->field;
+
+  for (const lock_wait_edge_t &e : edges)
+  {
+    OK(fields[LWG_REQUESTING_TRX_ID]->store(e.requesting_trx_id, true));
+    OK(fields[LWG_BLOCKING_TRX_ID]->store(e.blocking_trx_id, true));
+    OK(field_store_string(fields[LWG_LOCK_TYPE],
+                          e.table ? "TABLE" : "RECORD"));
+    OK(fields[LWG_WAIT_TIME_MS]->store(e.wait_time_ms, true));
+    OK(fields[LWG_IN_DEADLOCK]->store(e.deadlock, true));
+    OK(schema_table_store_record(thd, t));
+  }
+
+  DBUG_RETURN(0);
+}
+
+/** Bind the dynamic table INFORMATION_SCHEMA.INNODB_LOCK_WAIT_GRAPH
+@param p  table schema object
+@return 0 on success */
+static int innodb_lock_wait_graph_init(void *p)
+{
+  DBUG_ENTER("innodb_lock_wait_graph_init");
+  ST_SCHEMA_TABLE *schema= static_cast<ST_SCHEMA_TABLE*>(p);
+  schema->fields_info= Show::innodb_lock_wait_graph_fields_info;
+  schema->fill_table= i_s_lock_wait_graph_fill_table;
+  DBUG_RETURN(0);
+}
+
+struct st_maria_plugin	i_s_innodb_lock_wait_graph =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	MYSQL_INFORMATION_SCHEMA_PLUGIN,
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	&i_s_info,
+
+	/* plugin name */
+	/* const char* */
+	"INNODB_LOCK_WAIT_GRAPH",
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	plugin_author,
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	"InnoDB waits-for graph of transactions",
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	PLUGIN_LICENSE_GPL,
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	innodb_lock_wait_graph_init,
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	i_s_common_deinit,
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	INNODB_VERSION_SHORT,
+
+	/* struct st_mysql_show_var* */
+	NULL,
+
+	/* struct st_mysql_sys_var** */
+	NULL,
+
+	/* Maria extension */
+	INNODB_VERSION_STR,
+	MariaDB_PLUGIN_MATURITY_STABLE
+};
+
+namespace Show {
+/** Fields of INFORMATION_SCHEMA.INNODB_ROLLBACK_SEGMENTS */
+static ST_FIELD_INFO innodb_rollback_segments_fields_info[]=
+{
+#define RSEG_ID			0
+  Column("RSEG_ID", ULong(), NOT_NULL),
+
+#define RSEG_SPACE		1
+  Column("SPACE", ULong(), NOT_NULL),
+
+#define RSEG_PAGE_NO		2
+  Column("PAGE_NO", ULong(), NOT_NULL),
+
+#define RSEG_SIZE		3
+  Column("SIZE", ULonglong(), NOT_NULL),
+
+#define RSEG_CACHED_SIZE	4
+  Column("CACHED_SIZE", ULonglong(), NOT_NULL),
+
+#define RSEG_HISTORY_LENGTH	5
+  Column("HISTORY_LENGTH", ULonglong(), NOT_NULL),
+
+#define RSEG_ACTIVE_UNDO_LOGS	6
+  Column("ACTIVE_UNDO_LOGS", ULonglong(), NOT_NULL),
+
+#define RSEG_CACHED_UNDO_LOGS	7
+  Column("CACHED_UNDO_LOGS", ULonglong(), NOT_NULL),
+
+#define RSEG_SKIP_ALLOCATION	8
+  Column("SKIP_ALLOCATION", SLong(1), NOT_NULL),
+
+  CEnd()
+};
+} // namespace Show
+
+/** Populate INFORMATION_SCHEMA.INNODB_ROLLBACK_SEGMENTS
+with the space usage of the persistent rollback segments.
+@return 0 on success */
+static int i_s_rollback_segments_fill_table(THD *thd, TABLE_LIST *tables,
+                                            Item*)
+{
+  DBUG_ENTER("i_s_rollback_segments_fill_table");
+  RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+  /* deny access to user without PROCESS_ACL privilege */
+  if (check_global_access(thd, PROCESS_ACL))
+    DBUG_RETURN(0);
+
+  TABLE *t= tables->table;
+  Field **fields= t->field;
+
+  for (trx_rseg_t &rseg : trx_sys.rseg_array)
+  {
+    if (!rseg.space)
+      continue;
+
+    rseg.latch.rd_lock(SRW_LOCK_CALL);
+    const uint32_t space_id= rseg.space->id;
+    const uint32_t page_no= rseg.page_no;
+    const uint32_t size= rseg.curr_size;
+    const uint32_t history_size= rseg.history_size;
+    const size_t active= UT_LIST_GET_LEN(rseg.undo_list);
+    const size_t cached= UT_LIST_GET_LEN(rseg.undo_cached);
+    size_t cached_size= 0;
+    for (const trx_undo_t *undo= UT_LIST_GET_FIRST(rseg.undo_cached); undo;
+         undo= UT_LIST_GET_NEXT(undo_list, undo))
+      cached_size+= undo->size;
+    const bool skip= rseg.skip_allocation();
+    rseg.latch.rd_unlock();
+
+    OK(fields[RSEG_ID]->store(&rseg - trx_sys.rseg_array, true));
+    OK(fields[RSEG_SPACE]->store(space_id, true));
+    OK(fields[RSEG_PAGE_NO]->store(page_no, true));
+    OK(fields[RSEG_SIZE]->store(size, true));
+    OK(fields[RSEG_CACHED_SIZE]->store(cached_size, true));
+    OK(fields[RSEG_HISTORY_LENGTH]->store(history_size, true));
+    OK(fields[RSEG_ACTIVE_UNDO_LOGS]->store(active, true));
+    OK(fields[RSEG_CACHED_UNDO_LOGS]->store(cached, true));
+    OK(fields[RSEG_SKIP_ALLOCATION]->store(skip, true));
+    OK(schema_table_store_record(thd, t));
+  }
+
+  DBUG_RETURN(0);
+}
+
+/** Bind the dynamic table INFORMATION_SCHEMA.INNODB_ROLLBACK_SEGMENTS
+@param p  table schema object
+@return 0 on success */
+static int innodb_rollback_segments_init(void *p)
+{
+  DBUG_ENTER("innodb_rollback_segments_init");
+  ST_SCHEMA_TABLE *schema= static_cast<ST_SCHEMA_TABLE*>(p);
+  schema->fields_info= Show::innodb_rollback_segments_fields_info;
+  schema->fill_table= i_s_rollback_segments_fill_table;
+  DBUG_RETURN(0);
+}
+
+struct st_maria_plugin	i_s_innodb_rollback_segments =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	MYSQL_INFORMATION_SCHEMA_PLUGIN,
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	&i_s_info,
+
+	/* plugin name */
+	/* const char* */
+	"INNODB_ROLLBACK_SEGMENTS",
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	plugin_author,
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	"InnoDB rollback segments and their undo log space usage",
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	PLUGIN_LICENSE_GPL,
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	innodb_rollback_segments_init,
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	i_s_common_deinit,
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	INNODB_VERSION_SHORT,
+
+	/* struct st_mysql_show_var* */
+	NULL,
+
+	/* struct st_mysql_sys_var** */
+	NULL,
+
+	/* Maria extension */
+	INNODB_VERSION_STR,
+	MariaDB_PLUGIN_MATURITY_STABLE
+};
@@ -31,11 +31,48 @@ Created 2/17/1996 Heikki Tuuri
 #ifdef BTR_CUR_HASH_ADAPT
 #include "ha0ha.h"
 #include "srw_lock.h"
+#include "ut0counter.h"
+#include <thread>
 
 #ifdef UNIV_PFS_RWLOCK
 extern mysql_pfs_key_t btr_search_latch_key;
 #endif /* UNIV_PFS_RWLOCK */
 
+/** Latch of an adaptive hash index partition. The holder of the exclusive
+latch advances the version before and after modifying the partition, so that
+btr_search_guess_on_hash() can search the partition without acquiring the
+latch and then validate what it read, like buf_block_t::modify_clock.
+The version is odd while the partition is being modified. */
+struct btr_search_latch_t : srw_spin_lock
+{
+  /** the modification counter */
+  std::atomic<uint32_t> version;
+
+  void wr_lock(SRW_LOCK_ARGS(const char *file, unsigned line))
+  {
+    srw_spin_lock::wr_lock(SRW_LOCK_ARGS(file, line));
+    version.store(version.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  void wr_unlock()
+  {
+    version.store(version.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_release);
+    srw_spin_lock::wr_unlock();
+  }
+
+  /** Validate the reads that were made after the version was read.
+  @param v  the version that was read before the reads
+  @return whether the partition was not modified since v was read */
+  bool validate(uint32_t v) const
+  {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version.load(std::memory_order_relaxed) == v;
+  }
+};
+
 #define btr_search_sys_create() btr_search_sys.create()
 #define btr_search_sys_free() btr_search_sys.free()
 
@@ -110,7 +147,7 @@ void btr_search_drop_page_hash_when_freed(const page_id_t page_id);
 			inserted next to the cursor.
 @param[in]	ahi_latch	the adaptive hash index latch */
 void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
-                                           srw_spin_lock *ahi_latch);
+                                           btr_search_latch_t *ahi_latch);
 
 /** Updates the page hash index when a single record is inserted on a page.
 @param[in,out]	cursor		cursor which was positioned to the
@@ -119,7 +156,7 @@ void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
 				to the cursor
 @param[in]	ahi_latch	the adaptive hash index latch */
 void btr_search_update_hash_on_insert(btr_cur_t *cursor,
-                                      srw_spin_lock *ahi_latch);
+                                      btr_search_latch_t *ahi_latch);
 
 /** Updates the page hash index when a single record is deleted from a page.
 @param[in]	cursor	cursor which was positioned on the record to delete
@@ -216,6 +253,49 @@ struct btr_search_t{
 				the same prefix should be indexed in the
 				hash index */
 	/*---------------------- @} */
+	/** Counters of btr_search_guess_on_hash() that are reported in
+	INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PER_INDEX. They are
+	updated without holding any latch, by relaxed atomic operations
+	on shards that are chosen by get_rnd_value(), like ib_counter_t,
+	so that concurrent searches of a hot index seldom write to the
+	same cache line. */
+	struct stats_t
+	{
+		/** counters that are padded to a cache line */
+		struct shard
+		{
+			/** number of successful hash searches */
+			Atomic_relaxed<ulint>	hits;
+			/** number of failed hash searches */
+			Atomic_relaxed<ulint>	misses;
+			/** number of hash searches that had to acquire
+			the partition latch because the partition
+			was modified concurrently */
+			Atomic_relaxed<ulint>	retries;
+			char	pad[CPU_LEVEL1_DCACHE_LINESIZE
+				    - 3 * sizeof(Atomic_relaxed<ulint>)];
+		};
+
+		/** The shards. No alignas() is used, because
+		btr_search_info_create() allocates from a mem_heap_t. */
+		shard	shards[8];
+
+		/** @return a shard to update */
+		shard& get() { return shards[get_rnd_value()
+					     % array_elements(shards)]; }
+
+		/** @return the sum of a counter over all shards */
+		ulint sum(Atomic_relaxed<ulint> shard::*counter) const
+		{
+			ulint	total = 0;
+			for (const shard& s : shards) {
+				total += s.*counter;
+			}
+			return(total);
+		}
+	};
+	stats_t	n_hash;	/*!< AHI search counters; zero-initialized
+				by btr_search_info_create() */
 #ifdef UNIV_SEARCH_PERF_STAT
 	ulint	n_hash_succ;	/*!< number of successful hash searches thus
 				far */
@@ -240,7 +320,7 @@ struct btr_search_sys_t
   struct partition
   {
     /** latches protecting hash_table */
-    srw_spin_lock latch;
+    btr_search_latch_t latch;
     /** mapping of dtuple_fold() to rec_t* in buf_block_t::frame */
     hash_table_t table;
     /** memory heap for table */
@@ -309,9 +389,41 @@ struct btr_search_sys_t
   }
 
   /** Get the search latch for the adaptive hash index partition */
-  srw_spin_lock *get_latch(const dict_index_t &index) const
+  btr_search_latch_t *get_latch(const dict_index_t &index) const
   { return &get_part(index)->latch; }
 
+  /** Number of btr_search_guess_on_hash() calls that are searching a
+  partition without holding its latch, in slots that are chosen by
+  get_rnd_value(), so that the readers do not contend for a cache line */
+  ib_atomic_counter_element_t<uint32_t> readers[64];
+
+  /** Register a reader that will not acquire the partition latch.
+  @param part  adaptive hash index partition
+  @param slot  the slot to pass to reader_exit()
+  @return the version of the partition for btr_search_latch_t::validate() */
+  uint32_t reader_enter(const partition &part, size_t &slot)
+  {
+    slot= get_rnd_value() % array_elements(readers);
+    readers[slot].value.fetch_add(1, std::memory_order_seq_cst);
+    return part.latch.version.load(std::memory_order_seq_cst);
+  }
+
+  /** Unregister a reader that was registered by reader_enter().
+  @param slot  the slot that reader_enter() returned */
+  void reader_exit(size_t slot)
+  { readers[slot].value.fetch_sub(1, std::memory_order_release); }
+
+  /** Wait for the readers that were registered by reader_enter() before
+  all partition latches were acquired exclusively. After this, the hash
+  tables may be freed. */
+  void wait_for_readers()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (const auto &r : readers)
+      while (r.value.load(std::memory_order_acquire))
+        std::this_thread::yield();
+  }
+
   /** Create and initialize at startup */
   void create()
   {
@@ -354,7 +466,7 @@ TRANSACTIONAL_INLINE inline ulint dict_index_t::n_ahi_pages() const
 {
   if (!btr_search_enabled)
     return 0;
-  srw_spin_lock *latch= &btr_search_sys.get_part(*this)->latch;
+  btr_search_latch_t *latch= &btr_search_sys.get_part(*this)->latch;
 #if !defined NO_ELISION && !defined SUX_LOCK_GENERIC
   if (xbegin())
   {
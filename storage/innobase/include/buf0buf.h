@@ -1165,12 +1165,30 @@ struct buf_pool_stat_t{
 	ulint	n_ra_pages_evicted;/*!< number of read ahead
 				pages that are evicted without
 				being accessed */
+	ulint	n_ra_pages_read_leaf;/*!< number of pages read in
+				as part of buf_read_ahead_leaf() */
+	ib_counter_t<ulint, ib_counter_element_t>	n_ra_leaf_hits;
+				/*!< number of pages read by
+				buf_read_ahead_leaf() that the scan
+				reached afterwards;
+				NOT protected by buf_pool.mutex */
+	ib_counter_t<ulint, ib_counter_element_t>	n_ra_leaf_wasted;
+				/*!< number of pages read by
+				buf_read_ahead_leaf() that the scan
+				did not reach;
+				NOT protected by buf_pool.mutex */
 	ulint	n_pages_made_young; /*!< number of pages made young, in
 				buf_page_make_young() */
 	ulint	n_pages_not_made_young; /*!< number of pages not made
 				young because the first access
 				was not long enough ago, in
 				buf_page_peek_if_too_old() */
+	/** number of pages read soon after being evicted from the
+	"old" sublist, with innodb_lru_policy=adaptive */
+	ulint	n_ghost_hits_old;
+	/** number of pages read soon after being evicted from the
+	"new" sublist, with innodb_lru_policy=adaptive */
+	ulint	n_ghost_hits_new;
 	/** number of waits for eviction */
 	ulint	LRU_waits;
 	ulint	LRU_bytes;	/*!< LRU size in bytes */
@@ -1859,6 +1877,17 @@ class buf_pool_t
 					NOTE: LRU_old_len must be adjusted
 					whenever LRU_old shrinks or grows! */
 
+	/** With innodb_lru_policy=adaptive, hashes of recently evicted
+	pages (ghosts), with the least significant bit set if the page had
+	been in the "new" sublist; else nullptr */
+	uint32_t*	LRU_ghosts;
+	/** number of elements in LRU_ghosts, minus 1 */
+	size_t		LRU_ghosts_mask;
+	/** number of accesses to ghosts of "old" pages, minus
+	accesses to ghosts of "new" pages, since the latest adjustment
+	of LRU_old_ratio */
+	int		LRU_ghost_balance;
+
 	UT_LIST_BASE_NODE_T(buf_block_t) unzip_LRU;
 					/*!< base node of the
 					unzip_LRU list */
@@ -47,6 +47,9 @@ class buf_dblwr_t
     ulint first_free;
     /** number of slots reserved for the current write batch */
     ulint reserved;
+    /** if srv_doublewrite_compact, the number of payload bytes in
+    write_buf after the batch header page */
+    size_t used;
     /** the doublewrite buffer, aligned to srv_page_size */
     byte* write_buf;
     /** buffer blocks to be written via write_buf */
@@ -72,6 +75,8 @@ class buf_dblwr_t
   ulint writes_completed;
   /** number of pages written by flush_buffered_writes_completed() */
   ulint pages_written;
+  /** number of batches that were written in the compact format */
+  ulint batches_compact;
   /** condition variable for !writes_pending */
   pthread_cond_t write_cond;
   /** number of pending page writes */
@@ -87,6 +92,18 @@ class buf_dblwr_t
   /** Flush possible buffered writes to persistent storage. */
   bool flush_buffered_writes(const ulint size);
 
+  /** @return whether a page write does not fit in active_slot
+  @param size  payload size in bytes */
+  inline bool is_full(size_t size) const;
+
+  /** Prepare a slot for writing. If srv_doublewrite_compact and the
+  batch becomes shorter, write the header of a compact batch to the first
+  page of the slot. Otherwise, move the packed pages to one page per slot.
+  @param s    the slot that is about to be written
+  @param buf  the start of the data to write
+  @return number of bytes to write from buf */
+  size_t prepare_batch(slot *s, byte *&buf);
+
 public:
   /** Initialise the doublewrite buffer data structures. */
   void init();
@@ -107,6 +124,9 @@ class buf_dblwr_t
   /** @return the number of final pages written */
   ulint written() const
   { mysql_mutex_assert_owner(&mutex); return pages_written; }
+  /** @return the number of batches written in the compact format */
+  ulint compact_batches() const
+  { mysql_mutex_assert_owner(&mutex); return batches_compact; }
   /** Release the mutex */
   void unlock() { mysql_mutex_unlock(&mutex); }
 
@@ -120,6 +140,14 @@ class buf_dblwr_t
   @return DB_SUCCESS or error code */
   dberr_t init_or_load_pages(pfs_os_file_t file, const char *path);
 
+  /** Convert a batch that was written with innodb_doublewrite_compact=ON
+  to one page per slot.
+  @param buf      contents of the doublewrite buffer
+  @param n_slots  size of buf in pages
+  @return number of pages in buf
+  @retval 0 if the batch is incomplete or corrupted */
+  static ulint expand_compact(byte *buf, ulint n_slots);
+
   /** Process and remove the double write buffer pages for all tablespaces. */
   void recover();
 
@@ -38,6 +38,10 @@ void buf_load_abort();
 /** Start async buffer pool load, if srv_buffer_pool_load_at_startup was set.*/
 void buf_load_at_startup();
 
+/** Start a buffer pool dump if innodb_buffer_pool_dump_interval seconds
+have passed since the previous periodic dump. Invoked by srv_master_callback(). */
+void buf_dump_periodic();
+
 /** Wait for currently running load/dumps to finish*/
 void buf_load_dump_end();
 
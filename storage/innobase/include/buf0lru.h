@@ -166,6 +166,44 @@ least this many milliseconds ago.  Not protected by any mutex or latch. */
 extern uint	buf_LRU_old_threshold_ms;
 /* @} */
 
+/** The allowed values of innodb_lru_policy */
+enum buf_LRU_policy_t
+{
+  /** midpoint insertion, with innodb_old_blocks_pct old blocks */
+  BUF_LRU_MIDPOINT,
+  /** midpoint insertion, adapting the share of old blocks based on
+  accesses to recently evicted pages (ghost hits); pages that are
+  accessed soon after their eviction are added to the "new" sublist */
+  BUF_LRU_ADAPTIVE
+};
+
+/** The value of innodb_lru_policy */
+extern ulong buf_LRU_policy;
+
+/** Switch the buffer pool replacement policy.
+@param policy  the new value of innodb_lru_policy */
+void buf_LRU_policy_update(ulong policy);
+
+/** Check whether a page that is about to be read on demand was recently
+evicted.
+The caller must hold buf_pool.mutex.
+@param id  page identifier
+@return whether the page should be added to the "old" sublist */
+bool buf_LRU_read_to_old(const page_id_t id);
+
+/** Buffer pool hit statistics of a replacement policy */
+struct buf_LRU_policy_stat_t
+{
+  /** number of page requests while the policy was in effect */
+  ulint n_page_gets;
+  /** number of page reads while the policy was in effect */
+  ulint n_pages_read;
+};
+
+/** Get the buffer pool hit statistics of each replacement policy.
+@param stat  statistics, indexed by buf_LRU_policy_t */
+void buf_LRU_policy_stat(buf_LRU_policy_stat_t stat[BUF_LRU_ADAPTIVE + 1]);
+
 /** @brief Statistics for selecting the LRU list for eviction.
 
 These statistics are not 'of' LRU but 'for' LRU.  We keep count of I/O
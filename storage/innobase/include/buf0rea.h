@@ -102,6 +102,22 @@ which could result in a deadlock if the OS does not support asynchronous io.
 ulint
 buf_read_ahead_linear(const page_id_t page_id, ulint zip_size, bool ibuf);
 
+/** Read ahead of a scan that follows the chain of leaf pages of an index.
+If the scan has been moving to the FIL_PAGE_NEXT of the previous leaf page,
+submit asynchronous reads for the pages that it is expected to visit next.
+The read-ahead depth adapts to the fraction of the pages that the scans
+of the index actually reach.
+NOTE: the calling thread may own latches on pages: to avoid deadlocks this
+function must be written such that it cannot end up waiting for these
+latches!
+@param index     B-tree index
+@param page_id   leaf page that the scan just moved to
+@param next      FIL_PAGE_NEXT of page_id
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0
+@return number of page read requests issued */
+ulint buf_read_ahead_leaf(dict_index_t *index, const page_id_t page_id,
+                          uint32_t next, ulint zip_size);
+
 /** Issue read requests for pages that need to be recovered.
 @param space_id	tablespace identifier
 @param page_nos	page numbers to read, in ascending order */
@@ -48,6 +48,7 @@ Created 1/8/1996 Heikki Tuuri
 #include "fil0crypt.h"
 #include "mysql_com.h"
 #include <sql_const.h>
+#include <my_bit.h>
 #include <set>
 #include <algorithm>
 #include <iterator>
@@ -946,6 +947,115 @@ struct zip_pad_info_t {
 				rounds */
 };
 
+/** State of the self-adapting read-ahead of buf_read_ahead_leaf() for
+an index. The fields are zero-initialized in dict_mem_index_create() and
+protected by busy. */
+struct leaf_read_ahead_t {
+  /** Reset the state in dict_index_t::clone() */
+  leaf_read_ahead_t &operator=(const leaf_read_ahead_t&)
+  {
+    busy.store(false, std::memory_order_relaxed);
+    next= n_seq= depth= hits= skip= low= high= base= pending= 0;
+    memset(read, 0, sizeof read);
+    return *this;
+  }
+
+  /** Number of pages after base that can be tracked in read */
+  static constexpr uint32_t READ_BITS= 512;
+
+  /** Note that a page was submitted for reading.
+  @param page_no  page number, at least base */
+  void set_read(uint32_t page_no)
+  {
+    ut_ad(page_no - base < READ_BITS);
+    const uint32_t i= page_no - base;
+    read[i / 64]|= 1ULL << (i % 64);
+    pending++;
+  }
+
+  /** Check if a page was read ahead and not reached yet, and forget it.
+  @param page_no  page that the scan reached
+  @return whether page_no had been read ahead */
+  bool test_and_clear_read(uint32_t page_no)
+  {
+    const uint32_t i= page_no - base;
+    if (page_no < base || i >= READ_BITS)
+      return false;
+    const uint64_t bit= 1ULL << (i % 64);
+    if (!(read[i / 64] & bit))
+      return false;
+    read[i / 64]&= ~bit;
+    pending--;
+    return true;
+  }
+
+  /** Move base forward, forgetting the pages before it.
+  @param page_no  the new base
+  @return number of forgotten pages that had been read ahead */
+  uint32_t rebase(uint32_t page_no)
+  {
+    if (page_no <= base)
+      return 0;
+    const uint32_t d= page_no - base;
+    base= page_no;
+    uint32_t dropped= 0;
+    if (d >= READ_BITS)
+    {
+      for (uint64_t &w : read)
+      {
+        dropped+= my_count_bits(w);
+        w= 0;
+      }
+    }
+    else
+    {
+      const uint32_t dw= d / 64, db= d % 64, n= READ_BITS / 64;
+      for (uint32_t i= 0; i < dw; i++)
+        dropped+= my_count_bits(read[i]);
+      if (db)
+        dropped+= my_count_bits(read[dw] & ((1ULL << db) - 1));
+      for (uint32_t i= 0; i < n; i++)
+      {
+        const uint64_t lo= i + dw < n ? read[i + dw] : 0;
+        const uint64_t hi= i + dw + 1 < n ? read[i + dw + 1] : 0;
+        read[i]= db ? lo >> db | hi << (64 - db) : lo;
+      }
+    }
+    pending-= dropped;
+    return dropped;
+  }
+
+  /** @return whether the state was acquired */
+  bool try_lock() { return !busy.exchange(true, std::memory_order_acquire); }
+  /** Release the state */
+  void unlock() { busy.store(false, std::memory_order_release); }
+
+  /** whether a thread is accessing the state */
+  std::atomic<bool> busy;
+  /** the leaf page that a sequential scan would visit next, or 0 */
+  uint32_t next;
+  /** number of consecutive moves to the expected next leaf page */
+  uint32_t n_seq;
+  /** current read-ahead depth, in pages; 0 if not determined yet */
+  uint32_t depth;
+  /** number of pages read ahead that were reached since depth changed */
+  uint32_t hits;
+  /** number of moves before looking ahead again */
+  uint32_t skip;
+  /** first page of the most recent read-ahead window */
+  uint32_t low;
+  /** first page after the most recent read-ahead window */
+  uint32_t high;
+  /** the page that corresponds to the first bit of read */
+  uint32_t base;
+  /** number of bits set in read */
+  uint32_t pending;
+  /** pages at base and after it that were submitted for reading by
+  buf_read_ahead_leaf() and not reached by the scan yet; pages that were
+  in the buffer pool already are not included */
+  uint64_t read[READ_BITS / 64];
+};
+
 /** Number of samples of data size kept when page compression fails for
 a certain index.*/
 #define STAT_DEFRAG_DATA_SIZE_N_SAMPLE	10
@@ -1148,6 +1258,8 @@ struct dict_index_t {
 				when InnoDB was started up */
 	zip_pad_info_t	zip_pad;/*!< Information about state of
 				compression failures and successes */
+  /** state of buf_read_ahead_leaf() */
+  leaf_read_ahead_t leaf_read_ahead;
   /** lock protecting the non-leaf index pages */
   mutable index_lock lock;
 
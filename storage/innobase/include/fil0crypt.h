@@ -204,6 +204,9 @@ struct fil_space_crypt_status_t {
 	bool flushing;           /*!< is flush at end of rotation ongoing */
 	ulint rotate_next_page_number; /*!< next page if key rotating */
 	ulint rotate_max_page_number;  /*!< max page if key rotating */
+	ulint rotate_pages_per_second; /*!< rotation throughput, or 0 */
+	ulint rotate_eta_seconds;      /*!< estimated remaining time if
+				       rotate_pages_per_second != 0 */
 };
 
 /** Statistics about encryption key rotation */
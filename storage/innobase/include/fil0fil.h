@@ -206,6 +206,24 @@ class range_set
     ranges.emplace(new_range);
   }
 
+  /** Remove all values that are not smaller than a limit.
+  @param value  the smallest value to be removed */
+  void remove_from(uint32_t value)
+  {
+    range_set_t::iterator range= ranges.lower_bound({value, value});
+    if (range != ranges.begin())
+    {
+      range_set_t::iterator prev_range= std::prev(range);
+      if (prev_range->last >= value)
+      {
+        range_t new_range{prev_range->first, value - 1};
+        ranges.erase(prev_range);
+        ranges.emplace(new_range);
+      }
+    }
+    ranges.erase(range, ranges.end());
+  }
+
   /** Remove the value from the ranges.
   @param[in]	value	Value to be removed. */
   void remove_value(uint32_t value)
@@ -664,6 +682,11 @@ struct fil_space_t final
   /** Clear all freed ranges for undo tablespace when InnoDB
   encounters TRIM redo log record */
   void clear_freed_ranges() { freed_ranges.clear(); }
+
+  /** Clear the freed ranges at or above the end of a shrunk
+  undo tablespace.
+  @param size  the new size of the tablespace, in pages */
+  void clear_freed_ranges(uint32_t size) { freed_ranges.remove_from(size); }
 #endif /* !UNIV_INNOCHECKSUM */
   /** FSP_SPACE_FLAGS and FSP_FLAGS_MEM_ flags;
   check fsp0types.h to more info about flags. */
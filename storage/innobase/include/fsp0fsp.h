@@ -351,6 +351,19 @@ fsp_header_check_encryption_key(
 dberr_t fsp_header_init(fil_space_t *space, uint32_t size, mtr_t *mtr)
   MY_ATTRIBUTE((nonnull, warn_unused_result));
 
+/** Discard the free extents at the end of an undo tablespace.
+The caller must x-lock the tablespace, and later invoke
+mtr_t::shrink_pages() and mtr_t::commit_shrink().
+@param space     undo tablespace
+@param min_size  minimum size of the tablespace, in pages
+@param mtr       mini-transaction
+@param err       error code
+@return the new size of the tablespace, in pages
+@retval 0 if the tablespace cannot be shrunk */
+uint32_t fsp_shrink_undo_tablespace(fil_space_t *space, uint32_t min_size,
+                                    mtr_t *mtr, dberr_t *err)
+  MY_ATTRIBUTE((nonnull, warn_unused_result));
+
 /** Create a new segment.
 @param space                tablespace
 @param byte_offset          byte offset of the created segment header
@@ -126,6 +126,10 @@ extern ulong		fts_sort_pll_degree;
 call */
 extern ulong		fts_num_word_optimize;
 
+/** Variable specifying the number of threads that optimize the
+auxiliary INDEX tables of a table */
+extern uint		fts_optimize_threads;
+
 /** Variable specifying whether we do additional FTS diagnostic printout
 in the log */
 extern char		fts_enable_diag_print;
@@ -363,6 +367,15 @@ extern Atomic_relaxed<size_t> fts_max_total_cache_size;
 /** Variable specifying the FTS result cache limit for each query */
 extern size_t		fts_result_cache_limit;
 
+/** Variable specifying the total size of cached posting lists */
+extern size_t		fts_postings_cache_size;
+
+/** Total size of the cached posting lists of all tables */
+extern Atomic_counter<size_t>	fts_postings_cache_used;
+
+/** Number of posting lists that were found in the cache */
+extern Atomic_counter<size_t>	fts_postings_cache_hits;
+
 /** Variable specifying the maximum FTS max token size */
 extern ulong		fts_max_token_size;
 
@@ -32,6 +32,13 @@ Created 2007-03-27 Sunny Bains
 #include "que0types.h"
 #include "ut0byte.h"
 #include "ut0rbt.h"
+#include "srw_lock.h"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 /** Types used within FTS. */
 struct fts_que_t;
@@ -88,6 +95,106 @@ struct fts_stopword_t {
 
 struct fts_sync_t;
 
+/** The rows of an FTS INDEX table that matched a search string, as they
+were read by a query. The ilists are kept in the VLC encoded format. */
+struct fts_postings_t
+{
+  /** A row of an FTS INDEX table */
+  struct row_t
+  {
+    /** offset of the word in data */
+    size_t word;
+    /** length of the word in bytes */
+    ulint word_len;
+    /** offset of the ilist in data */
+    size_t ilist;
+    /** length of the ilist in bytes */
+    ulint ilist_size;
+    /** number of doc ids in the ilist */
+    ulint doc_count;
+    /** first doc id in the ilist */
+    doc_id_t first_doc_id;
+    /** last doc id in the ilist */
+    doc_id_t last_doc_id;
+  };
+
+  /** the rows, in the order they were read */
+  std::vector<row_t> rows;
+  /** the words and ilists of rows */
+  std::vector<byte> data;
+
+  /** Append a row.
+  @param word   the word of the row
+  @param node   the other columns of the row */
+  void add(const fts_string_t &word, const fts_node_t &node);
+
+  /** @return the approximate memory usage, in bytes */
+  size_t size() const
+  { return sizeof *this + rows.size() * sizeof(row_t) + data.size(); }
+};
+
+/** Posting lists of the FTS indexes of a table that were read by
+queries, kept until the next change of the FTS INDEX tables.
+The innodb_ft_postings_cache_size limit is shared by all tables;
+see fts_postings_cache_used. */
+class fts_postings_cache_t
+{
+public:
+  typedef std::shared_ptr<const fts_postings_t> postings_ptr;
+private:
+  typedef std::list<std::pair<std::string, postings_ptr> > lru_list;
+
+  /** protects all members */
+  srw_mutex mutex;
+  /** the cached posting lists, most recently used first */
+  lru_list lru;
+  /** lookup from key() to the element of lru */
+  std::unordered_map<std::string, lru_list::iterator> map;
+  /** total size of the cached posting lists of this table, in bytes;
+  included in fts_postings_cache_used */
+  size_t total_size= 0;
+  /** number of invalidate() calls */
+  uint64_t generation= 0;
+
+  /** Remove the least recently used entry.
+  Must be called while holding mutex. */
+  void evict();
+public:
+  fts_postings_cache_t() { mutex.init(); }
+  ~fts_postings_cache_t() { invalidate(); mutex.destroy(); }
+
+  /** Determine the cache key of a search string.
+  @param index_id  FTS index identifier
+  @param word      search string
+  @return the key */
+  static std::string key(index_id_t index_id, const fts_string_t &word);
+
+  /** Look up a posting list.
+  @param key  key()
+  @return the posting list
+  @retval nullptr if the posting list is not cached */
+  postings_ptr find(const std::string &key);
+
+  /** @return the number of invalidate() calls so far */
+  uint64_t get_generation();
+
+  /** Add a posting list, unless invalidate() was invoked after
+  get_generation() returned generation. If the posting lists of all
+  tables would exceed limit, evict posting lists of this table, or
+  do not add the posting list if that is not enough.
+  @param key         key()
+  @param postings    the posting list
+  @param generation  get_generation() before the read view of the
+                     query was created
+  @param limit       maximum fts_postings_cache_used */
+  void insert(std::string &&key, postings_ptr postings,
+              uint64_t generation, size_t limit);
+
+  /** Discard all posting lists. To be invoked after committing
+  a change of the FTS INDEX tables. */
+  void invalidate();
+};
+
 /** The cache for the FTS system. It is a memory-based inverted index
 that new entries are added to, until it grows over the configured maximum
 size, at which time its contents are written to the INDEX table. */
@@ -152,6 +259,9 @@ struct fts_cache_t
 
 	fts_stopword_t	stopword_info;	/*!< Cached stopwords for the FTS */
 	mem_heap_t*	cache_heap;	/*!< Cache Heap */
+
+	/** posting lists read by queries; see innodb_ft_postings_cache_size */
+	fts_postings_cache_t*	postings;
 };
 
 /** Columns of the FTS auxiliary INDEX table */
@@ -45,6 +45,8 @@ class ReadView;
 extern my_bool innodb_deadlock_detect;
 /** The value of innodb_deadlock_report */
 extern ulong innodb_deadlock_report;
+/** The value of innodb_deadlock_detect_interval */
+extern uint innodb_deadlock_detect_interval;
 
 namespace Deadlock
 {
@@ -52,6 +54,34 @@ namespace Deadlock
   enum report { REPORT_OFF, REPORT_BASIC, REPORT_FULL };
 }
 
+/** Create the timer of the background deadlock detector, and arm or
+disarm it according to innodb_deadlock_detect_interval. */
+void lock_deadlock_detect_start();
+/** Apply a changed innodb_deadlock_detect_interval. If the background
+deadlock detector was disabled, check the pending waits immediately. */
+void lock_deadlock_detect_update();
+/** Shut down the background deadlock detector. */
+void lock_deadlock_detect_shutdown();
+
+/** An edge of the waits-for graph */
+struct lock_wait_edge_t
+{
+  /** the waiting transaction */
+  trx_id_t requesting_trx_id;
+  /** the transaction that holds a conflicting lock */
+  trx_id_t blocking_trx_id;
+  /** how long the request has been waiting, in milliseconds */
+  ulonglong wait_time_ms;
+  /** whether a table lock is being waited for */
+  bool table;
+  /** whether the edge is part of a cycle (deadlock) */
+  bool deadlock;
+};
+
+/** Take a snapshot of the waits-for graph.
+@param edges  the waiting transactions and the transactions they wait for */
+void lock_wait_graph(std::vector<lock_wait_edge_t> &edges);
+
 /*********************************************************************//**
 Gets the heap_no of the smallest user record on a page.
 @return heap_no of smallest user record, or PAGE_HEAP_NO_SUPREMUM */
@@ -166,6 +166,11 @@ struct log_t
   static constexpr uint32_t FORMAT_10_8= 0x50687973;
   /** The MariaDB 10.8.0 format with innodb_encrypt_log=ON */
   static constexpr uint32_t FORMAT_ENC_10_8= FORMAT_10_8 | FORMAT_ENCRYPTED;
+  /** The MariaDB 10.9 redo log format: FORMAT_10_8, possibly containing
+  SHRINK_PAGES records, which older versions would consider corrupted */
+  static constexpr uint32_t FORMAT_10_9= 0x50687974;
+  /** The MariaDB 10.9 format with innodb_encrypt_log=ON */
+  static constexpr uint32_t FORMAT_ENC_10_9= FORMAT_10_9 | FORMAT_ENCRYPTED;
 
   /** Location of the first checkpoint block */
   static constexpr size_t CHECKPOINT_1= 4096;
@@ -234,20 +239,33 @@ typedef srw_lock log_rwlock_t;
   /** Buffer for writing to resize_log; @see flush_buf */
   byte *resize_flush_buf;
 
-  /** spin lock protecting lsn, buf_free in append_prepare() */
+  /** spin lock protecting lsn, buf_free in append_prepare() if is_pmem() */
   alignas(CPU_LEVEL1_DCACHE_LINESIZE) pthread_mutex_t lsn_lock;
   void init_lsn_lock() { pthread_mutex_init(&lsn_lock, LSN_LOCK_ATTR); }
   void lock_lsn() { pthread_mutex_lock(&lsn_lock); }
   void unlock_lsn() { pthread_mutex_unlock(&lsn_lock); }
   void destroy_lsn_lock() { pthread_mutex_destroy(&lsn_lock); }
 
+  /** the log sequence number that corresponds to buf[0] if !is_pmem();
+  protected by latch.wr_lock() */
+  lsn_t buf_start_lsn;
+
 public:
-  /** first free offset within buf use; protected by lsn_lock */
+  /** Flag in buf_free that is set by append_prepare() when buf is full.
+  Any concurrent reservation will then fail until write_buf() resets
+  buf_free, so that the space that is released by a failed reservation
+  cannot be handed out twice. */
+  static constexpr size_t BUF_FREE_BACKOFF= ~(~size_t{0} >> 1);
+
+  /** first free offset within buf use; if !is_pmem(), space is reserved
+  by append_prepare() with fetch_add() while holding latch.rd_lock(),
+  and the value may include BUF_FREE_BACKOFF; if is_pmem(),
+  protected by lsn_lock */
   Atomic_relaxed<size_t> buf_free;
-  /** number of write requests (to buf); protected by exclusive lsn_lock */
-  ulint write_to_buf;
-  /** number of waits in append_prepare(); protected by lsn_lock */
-  ulint waits;
+  /** number of write requests (to buf) */
+  Atomic_relaxed<ulint> write_to_buf;
+  /** number of waits in append_prepare() */
+  Atomic_relaxed<ulint> waits;
   /** recommended maximum size of buf, after which the buffer is flushed */
   size_t max_buf_free;
 
@@ -261,7 +279,7 @@ typedef srw_lock log_rwlock_t;
   uint32_t block_size;
 #endif
 public:
-  /** format of the redo log: e.g., FORMAT_10_8 */
+  /** format of the redo log: e.g., FORMAT_10_9 */
   uint32_t format;
   /** Log file */
   log_file_t log;
@@ -378,6 +396,18 @@ typedef srw_lock log_rwlock_t;
 
   lsn_t get_lsn(std::memory_order order= std::memory_order_relaxed) const
   { return lsn.load(order); }
+
+  /** @return the used length of buf, excluding BUF_FREE_BACKOFF */
+  size_t get_buf_free() const noexcept { return buf_free & ~BUF_FREE_BACKOFF; }
+
+  /** Set buf_free after get_lsn() has been assigned, while holding
+  latch.wr_lock() or during startup.
+  @param free  the first free offset within buf */
+  void set_buf_free(size_t free) noexcept
+  {
+    buf_free= free;
+    buf_start_lsn= get_lsn() - free;
+  }
   void set_lsn(lsn_t lsn) { this->lsn.store(lsn, std::memory_order_release); }
 
   lsn_t get_flushed_lsn(std::memory_order order= std::memory_order_acquire)
@@ -443,6 +473,12 @@ typedef srw_lock log_rwlock_t;
   /** Wait in append_prepare() for buffer to become available
   @param ex   whether log_sys.latch is exclusively locked */
   ATTRIBUTE_COLD static void append_prepare_wait(bool ex) noexcept;
+  /** Reserve space in buf if !is_pmem().
+  @param size   total length of the data to append(), in bytes
+  @param ex     whether log_sys.latch is exclusively locked
+  @return the start LSN and the offset within buf */
+  inline std::pair<lsn_t,size_t> append_reserve(size_t size, bool ex)
+    noexcept;
 public:
   /** Reserve space in the log buffer for appending data.
   @tparam pmem  log_sys.is_pmem()
@@ -468,12 +504,16 @@ typedef srw_lock log_rwlock_t;
 
   /** Set the log file format. */
   void set_latest_format(bool encrypted) noexcept
-  { format= encrypted ? FORMAT_ENC_10_8 : FORMAT_10_8; }
+  { format= encrypted ? FORMAT_ENC_10_9 : FORMAT_10_9; }
   /** @return whether the redo log is encrypted */
   bool is_encrypted() const noexcept { return format & FORMAT_ENCRYPTED; }
-  /** @return whether the redo log is in the latest format */
+  /** @return whether the redo log is in the latest format
+  or in FORMAT_10_8, which can be parsed in the same way */
   bool is_latest() const noexcept
-  { return (~FORMAT_ENCRYPTED & format) == FORMAT_10_8; }
+  {
+    const uint32_t f= ~FORMAT_ENCRYPTED & format;
+    return f == FORMAT_10_9 || f == FORMAT_10_8;
+  }
 
   /** @return capacity in bytes */
   lsn_t capacity() const noexcept { return file_size - START_OFFSET; }
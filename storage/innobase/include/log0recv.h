@@ -230,6 +230,11 @@ struct recv_sys_t
   lsn_t file_checkpoint;
   /** the time when progress was last reported */
   time_t progress_time;
+  /** the time when the current recovery batch was started */
+  time_t apply_start;
+  /** number of pages to which log was applied in the current batch;
+  protected by mutex */
+  size_t pages_applied;
 
   using map = std::map<const page_id_t, page_recv_t,
                        std::less<const page_id_t>,
@@ -247,8 +252,11 @@ struct recv_sys_t
   (indexed by page_id_t::space() - srv_undo_space_id_start) */
   struct trunc
   {
-    /** log sequence number of FILE_CREATE, or 0 if none */
+    /** log sequence number of the latest TRIM_PAGES or SHRINK_PAGES,
+    or 0 if none */
     lsn_t lsn;
+    /** log sequence number of the latest TRIM_PAGES, or 0 if none */
+    lsn_t reinit_lsn;
     /** truncated size of the tablespace, or 0 if not truncated */
     unsigned pages;
   } truncated_undo_spaces[127];
@@ -282,6 +290,12 @@ struct recv_sys_t
   @retval -1      if the page cannot be recovered due to corruption */
   buf_block_t *recover_low(const page_id_t page_id);
 
+  /** Initialize pages based on redo log records in srv_thread_pool tasks
+  and the calling thread, while the pages in the state RECV_BEING_READ are
+  being recovered by the read completion callbacks.
+  @param page_ids  pages in the state RECV_WILL_NOT_READ, in ascending order */
+  void recover_parallel(const std::vector<page_id_t> &page_ids);
+
   /** All found log files (multiple ones are possible if we are upgrading
   from before MariaDB Server 10.5.1) */
   std::vector<log_file_t> files;
@@ -365,6 +379,15 @@ struct recv_sys_t
     return true;
   }
 
+  /** @return the number of pages per second that the current batch
+  has recovered
+  @param time  the current time */
+  size_t apply_rate(time_t time) const
+  {
+    mysql_mutex_assert_owner(&mutex);
+    return pages_applied / std::max<size_t>(size_t(time - apply_start), 1);
+  }
+
   /** The alloc() memory alignment, in bytes */
   static constexpr size_t ALIGNMENT= sizeof(size_t);
 
@@ -635,3 +635,15 @@ inline void mtr_t::trim_pages(const page_id_t id)
   m_log.close(l);
   set_trim_pages();
 }
+
+/** Discard the end of an undo tablespace while it remains in use.
+@param id       first page identifier that will not be in the file */
+inline void mtr_t::shrink_pages(const page_id_t id)
+{
+  if (!is_logged())
+    return;
+  byte *l= log_write<EXTENDED>(id, nullptr, 1, true);
+  *l++= SHRINK_PAGES;
+  m_log.close(l);
+  set_trim_pages();
+}
@@ -612,6 +612,9 @@ struct mtr_t {
   /** Trim the end of a tablespace.
   @param id       first page identifier that will not be in the file */
   inline void trim_pages(const page_id_t id);
+  /** Discard the end of an undo tablespace while it remains in use.
+  @param id       first page identifier that will not be in the file */
+  inline void shrink_pages(const page_id_t id);
 
   /** Write a log record about a file operation.
   @param type           file operation
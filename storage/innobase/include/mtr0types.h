@@ -281,7 +281,12 @@ enum mrec_ext_t
   This is similar to the old MLOG_COMP_REC_DELETE record. */
   DELETE_ROW_FORMAT_DYNAMIC= 9,
   /** Truncate a data file. */
-  TRIM_PAGES= 10
+  TRIM_PAGES= 10,
+  /** Discard the pages at the end of an undo tablespace whose
+  rollback segments remain in use. Unlike TRIM_PAGES, the pages
+  before the page identifier are not reinitialized.
+  Introduced in log_t::FORMAT_10_9. */
+  SHRINK_PAGES= 11
 };
 
 
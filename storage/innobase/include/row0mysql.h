@@ -439,9 +439,14 @@ struct mysql_row_templ_t {
 	ulint	is_virtual;		/*!< if a column is a virtual column */
 };
 
+/* Initial number of rows in fetch_cache after positioning a cursor */
 #define MYSQL_FETCH_CACHE_SIZE		8
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
+/* Maximum number of rows in fetch_cache */
+#define MYSQL_FETCH_CACHE_MAX_SIZE	1024
+/* Maximum size of fetch_cache in bytes, unless a row is larger */
+#define MYSQL_FETCH_CACHE_MAX_BYTES	(256U << 10)
 
 #define ROW_PREBUILT_ALLOCATED	78540783
 #define ROW_PREBUILT_FREED	26423527
@@ -615,8 +620,7 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
-					/*!< a cache for fetched rows if we
+	byte**		fetch_cache;	/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
 					batch; we reserve mysql_row_len
@@ -625,6 +629,12 @@ struct row_prebuilt_t {
 					allocated mem buf start, because
 					there is a 4 byte magic number at the
 					start and at the end */
+	ulint		fetch_cache_alloc;/*!< number of rows allocated
+					in fetch_cache */
+	ulint		fetch_cache_size;/*!< maximum number of rows in
+					fetch_cache in the current batch;
+					grows with the number of rows fetched
+					after positioning the cursor */
 	bool		keep_other_fields_on_keyread; /*!< when using fetch
 					cache with HA_EXTRA_KEYREAD, don't
 					overwrite other fields in mysql row
@@ -0,0 +1,68 @@
+/*****************************************************************************
+
+Copyright (c) 2023, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/row0pread.h
+Parallel scan of an index in key ranges
+*******************************************************/
+
+#pragma once
+
+#include "data0types.h"
+#include "dict0types.h"
+#include "row0types.h"
+#include "mem0mem.h"
+#include <vector>
+
+struct row_prebuilt_t;
+
+/** A key range [start, end) of an index; nullptr denotes an open end */
+struct row_pread_range_t
+{
+  /** the smallest key in the range, or nullptr for the start of the index */
+  const dtuple_t *start;
+  /** the smallest key after the range, or nullptr for the end of the index */
+  const dtuple_t *end;
+};
+
+/** Key ranges that together cover an index */
+typedef std::vector<row_pread_range_t> row_pread_ranges_t;
+
+/** Split an index into key ranges at the node pointer records of
+the highest B-tree level that contains enough of them.
+@param index     B-tree index
+@param n_ranges  desired number of ranges
+@param heap      memory heap for the range boundaries
+@param ranges    the ranges, in ascending order of keys
+@return error code */
+dberr_t row_pread_split(dict_index_t *index, ulint n_ranges, mem_heap_t *heap,
+                        row_pread_ranges_t &ranges)
+  MY_ATTRIBUTE((nonnull, warn_unused_result));
+
+/** Count the records of the clustered index that are visible in the
+read view of the transaction. The index is split by row_pread_split()
+and the ranges are scanned by srv_thread_pool tasks and by the
+calling thread, all sharing prebuilt->trx->read_view. The srv_thread_pool
+tasks of all concurrent calls are limited to the number of CPUs.
+@param prebuilt   table handle
+@param n_threads  maximum number of concurrently scanning threads
+@param n_rows     number of visible records
+@return error code */
+dberr_t row_count_parallel(row_prebuilt_t *prebuilt, ulint n_threads,
+                           ulint *n_rows)
+  MY_ATTRIBUTE((nonnull, warn_unused_result));
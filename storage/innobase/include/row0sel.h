@@ -178,6 +178,10 @@ current read view.
 dberr_t row_check_index(row_prebuilt_t *prebuilt, ulint *n_rows)
   MY_ATTRIBUTE((nonnull, warn_unused_result));
 
+/** Free the prefetch cache.
+@param prebuilt  prebuilt struct */
+void row_sel_prefetch_cache_free(row_prebuilt_t *prebuilt);
+
 /** Read the max AUTOINC value from an index.
 @param[in] index	index starting with an AUTO_INCREMENT column
 @return	the largest AUTO_INCREMENT value
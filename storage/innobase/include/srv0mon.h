@@ -165,6 +165,9 @@ enum monitor_id_t {
 	MONITOR_OVLD_BUF_POOL_WAIT_FREE,
 	MONITOR_OVLD_BUF_POOL_READ_AHEAD,
 	MONITOR_OVLD_BUF_POOL_READ_AHEAD_EVICTED,
+	MONITOR_OVLD_BUF_POOL_READ_AHEAD_LEAF,
+	MONITOR_OVLD_BUF_POOL_READ_AHEAD_LEAF_HITS,
+	MONITOR_OVLD_BUF_POOL_READ_AHEAD_LEAF_WASTED,
 	MONITOR_OVLD_BUF_POOL_PAGE_TOTAL,
 	MONITOR_OVLD_BUF_POOL_PAGE_MISC,
 	MONITOR_OVLD_BUF_POOL_PAGES_DATA,
@@ -135,6 +135,21 @@ struct srv_stats_t
 	/** Number of system rows inserted */
 	ulint_ctr_n_t		n_system_rows_inserted;
 
+	/** Number of batches of rows copied to the prefetch cache
+	of row_search_mvcc() */
+	ulint_ctr_n_t		n_prefetch_batches;
+
+	/** Number of rows returned from the prefetch cache */
+	ulint_ctr_n_t		n_prefetch_rows;
+
+#ifdef UNIV_DEBUG
+	/** Number of times the prefetch cache was allocated larger */
+	ulint_ctr_n_t		n_prefetch_grown;
+
+	/** Number of grown prefetch caches freed at the end of a statement */
+	ulint_ctr_n_t		n_prefetch_shrunk;
+#endif /* UNIV_DEBUG */
+
 	/** Number of times secondary index lookup triggered cluster lookup */
 	ulint_ctr_n_t		n_sec_rec_cluster_reads;
 
@@ -195,6 +210,9 @@ extern char*	srv_data_home;
 recovery and open all tables in RO mode instead of RW mode. We don't
 sync the max trx id to disk either. */
 extern my_bool	srv_read_only_mode;
+/** innodb_read_view_active_array: whether MVCC snapshots are copied from
+a dense array of active transactions instead of trx_sys.rw_trx_hash */
+extern my_bool	srv_read_view_active_array;
 /** Set if InnoDB operates in read-only mode or innodb-force-recovery
 is greater than SRV_FORCE_NO_IBUF_MERGE. */
 extern my_bool	high_level_read_only;
@@ -204,6 +222,8 @@ extern my_bool	srv_file_per_table;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Number of threads for merging sorted runs in index creation */
+extern ulong	srv_merge_sort_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -280,6 +300,20 @@ extern ulint	srv_buf_pool_base_size;
 extern ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 extern ulong	srv_buf_pool_dump_pct;
+/** Interval between periodic buffer pool dumps in seconds, or 0 */
+extern ulong	srv_buf_pool_dump_interval;
+/** Format of the buffer pool dump file */
+enum srv_buf_dump_format_t
+{
+  /** one "space,page" line per page, in LRU order */
+  SRV_BUF_DUMP_TEXT= 0,
+  /** delta-encoded page lists, to which changes can be appended */
+  SRV_BUF_DUMP_BINARY
+};
+/** innodb_buffer_pool_dump_format */
+extern ulong	srv_buf_pool_dump_format;
+/** Number of threads that submit the reads of a buffer pool load */
+extern uint	srv_buf_pool_load_threads;
 #ifdef UNIV_DEBUG
 /** Abort load after this amount of pages */
 extern ulong srv_buf_pool_load_pages_abort;
@@ -291,6 +325,7 @@ extern ulint	srv_lock_table_size;
 extern ulong	srv_checksum_algorithm;
 extern my_bool	srv_random_read_ahead;
 extern ulong	srv_read_ahead_threshold;
+extern ulong	srv_read_ahead_leaf_pages;
 extern uint	srv_n_read_io_threads;
 extern uint	srv_n_write_io_threads;
 
@@ -345,8 +380,13 @@ extern my_bool			srv_stats_auto_recalc;
 extern my_bool			srv_stats_include_delete_marked;
 extern unsigned long long	srv_stats_modified_counter;
 extern my_bool			srv_stats_sample_traditional;
+/** innodb_stats_analyze_threads */
+extern uint			srv_stats_analyze_threads;
+/** innodb_stats_random_dive_confidence */
+extern uint			srv_stats_random_dive_confidence;
 
 extern my_bool	srv_use_doublewrite_buf;
+extern my_bool	srv_doublewrite_compact;
 extern ulong	srv_checksum_algorithm;
 
 extern my_bool	srv_force_primary_key;
@@ -646,8 +686,18 @@ struct export_var_t{
 	ulint innodb_buffer_pool_pages_total;	/*!< Buffer pool size */
 	ulint innodb_buffer_pool_bytes_data;	/*!< File bytes used */
 	ulint innodb_buffer_pool_pages_misc;	/*!< Miscellanous pages */
+	/** page requests with innodb_lru_policy=midpoint */
+	ulint innodb_buffer_pool_midpoint_read_requests;
+	/** page reads with innodb_lru_policy=midpoint */
+	ulint innodb_buffer_pool_midpoint_reads;
+	/** page requests with innodb_lru_policy=adaptive */
+	ulint innodb_buffer_pool_adaptive_read_requests;
+	/** page reads with innodb_lru_policy=adaptive */
+	ulint innodb_buffer_pool_adaptive_reads;
 #ifdef UNIV_DEBUG
 	ulint innodb_buffer_pool_pages_latched;	/*!< Latched pages */
+	ulint innodb_prefetch_cache_grown;	/*!< n_prefetch_grown */
+	ulint innodb_prefetch_cache_shrunk;	/*!< n_prefetch_shrunk */
 #endif /* UNIV_DEBUG */
 	ulint innodb_checkpoint_age;
 	ulint innodb_checkpoint_max_age;
@@ -659,6 +709,8 @@ struct export_var_t{
 	ulint innodb_data_reads;		/*!< I/O read requests */
 	ulint innodb_dblwr_pages_written;	/*!< srv_dblwr_pages_written */
 	ulint innodb_dblwr_writes;		/*!< srv_dblwr_writes */
+	/** doublewrite batches in the innodb_doublewrite_compact format */
+	ulint innodb_dblwr_compact_writes;
 	ulint innodb_deadlocks;
 	ulint innodb_history_list_length;
 	lsn_t innodb_lsn_current;
@@ -671,6 +723,10 @@ struct export_var_t{
 	ulint innodb_mem_dictionary;
 	/** log_sys.get_lsn() - recv_sys.lsn */
 	lsn_t innodb_os_log_written;
+	/** purge_sys.lag() */
+	ulint innodb_purge_lag_seconds;
+	/** number of purge tasks that the purge coordinator is using */
+	ulint innodb_purge_threads_used;
 	ulint innodb_row_lock_waits;		/*!< srv_n_lock_wait_count */
 	ulint innodb_row_lock_current_waits;	/*!< srv_n_lock_wait_current_count */
 	int64_t innodb_row_lock_time;		/*!< srv_n_lock_wait_time
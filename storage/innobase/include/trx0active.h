@@ -0,0 +1,246 @@
+/*****************************************************************************
+
+Copyright (c) 2023, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/trx0active.h
+Compact array of active read-write transactions for MVCC snapshots
+*******************************************************/
+
+#pragma once
+
+#include "univ.i"
+#include "my_cpu.h"
+#include <atomic>
+
+/**
+  Identifiers and serialisation numbers of the active read-write
+  transactions, stored in a dense array of slots.
+
+  trx_sys_t::snapshot_ids() normally iterates trx_sys.rw_trx_hash, which
+  requires pinning and visiting every element of a lock-free list. With
+  innodb_read_view_active_array=ON, the snapshot is copied from this
+  array instead: a sequential scan of at most end() slots of 24 bytes.
+
+  Each slot is protected by a sequence number, which is odd while id or
+  no is being modified. A slot is claimed by insert() by making an even
+  sequence number odd while the slot is free; after that, only the
+  owning transaction modifies the slot until erase(). snapshot() retries
+  reading a slot until it observes the same even sequence number before
+  and after reading id and no. Without this, a snapshot could pair the
+  id of a transaction with the no of the next transaction that reused
+  the slot, overstating the purge limit of the read view.
+
+  The memory ordering is the responsibility of the caller, in the same
+  way as for trx_sys.rw_trx_hash: insert() and assign_no() must be
+  followed by a RELEASE operation (trx_sys_t::refresh_rw_trx_hash_version())
+  and snapshot() must be preceded by the matching ACQUIRE operation.
+
+  If all slots are in use, insert() returns NONE and snapshots must be
+  taken from trx_sys.rw_trx_hash until the overflowing transactions
+  have been erased.
+*/
+class trx_active_t
+{
+public:
+  /** number of slots */
+  static constexpr uint32_t N_SLOTS= 8192;
+  /** insert() return value when all slots are in use */
+  static constexpr uint32_t NONE= ~uint32_t{0};
+
+private:
+  /** A transaction slot */
+  struct slot_t
+  {
+    /** transaction identifier, or 0 if the slot is free */
+    std::atomic<ib_id_t> id;
+    /** transaction serialisation number, or IB_ID_MAX if not assigned */
+    std::atomic<ib_id_t> no;
+    /** sequence number; odd while id or no is being modified */
+    std::atomic<uint32_t> seq;
+
+    /** Try to claim a free slot.
+    @return whether the slot was claimed and write_lock() was acquired */
+    bool claim()
+    {
+      uint32_t s= seq.load(std::memory_order_acquire);
+      if ((s & 1) || id.load(std::memory_order_relaxed))
+        return false;
+      /* Any modification of the slot increments seq. Because the slot
+      was free at s, the compare_exchange succeeds only if it still is. */
+      if (!seq.compare_exchange_strong(s, s + 1, std::memory_order_relaxed))
+        return false;
+      std::atomic_thread_fence(std::memory_order_release);
+      return true;
+    }
+    /** Start modifying an owned slot. */
+    void write_lock()
+    {
+      ut_ad(!(seq.load(std::memory_order_relaxed) & 1));
+      seq.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+    /** Finish modifying the slot. */
+    void write_unlock()
+    {
+      ut_ad(seq.load(std::memory_order_relaxed) & 1);
+      seq.fetch_add(1, std::memory_order_release);
+    }
+    /** Read a consistent pair of id and no.
+    @param trx_no  the transaction serialisation number
+    @return the transaction identifier */
+    ib_id_t read(ib_id_t &trx_no) const
+    {
+      for (;;)
+      {
+        const uint32_t s= seq.load(std::memory_order_acquire);
+        if (!(s & 1))
+        {
+          const ib_id_t i= id.load(std::memory_order_relaxed);
+          trx_no= no.load(std::memory_order_relaxed);
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (s == seq.load(std::memory_order_relaxed))
+            return i;
+        }
+        MY_RELAX_CPU();
+      }
+    }
+  };
+
+  /** 1 + the largest index of a slot that has ever been used */
+  alignas(CPU_LEVEL1_DCACHE_LINESIZE) std::atomic<uint32_t> m_end;
+  /** number of registered transactions for which no slot was available */
+  std::atomic<uint32_t> m_overflow;
+  /** where insert() starts looking for a free slot */
+  alignas(CPU_LEVEL1_DCACHE_LINESIZE) std::atomic<uint32_t> m_hint;
+  /** the slots */
+  alignas(CPU_LEVEL1_DCACHE_LINESIZE) slot_t m_slots[N_SLOTS];
+
+public:
+  /** Initialize all slots as free. */
+  void create()
+  {
+    m_end.store(0, std::memory_order_relaxed);
+    m_overflow.store(0, std::memory_order_relaxed);
+    m_hint.store(0, std::memory_order_relaxed);
+    for (slot_t &s : m_slots)
+    {
+      s.id.store(0, std::memory_order_relaxed);
+      s.no.store(IB_ID_MAX, std::memory_order_relaxed);
+      s.seq.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /** Register an active transaction.
+  @param id  transaction identifier
+  @return the allocated slot
+  @retval NONE if all slots are in use */
+  uint32_t insert(ib_id_t id)
+  {
+    ut_ad(id);
+    uint32_t i= m_hint.load(std::memory_order_relaxed);
+    for (uint32_t n= N_SLOTS; n--; i= (i + 1) & (N_SLOTS - 1))
+    {
+      slot_t &s= m_slots[i];
+      if (!s.claim())
+        continue;
+      ut_ad(s.no.load(std::memory_order_relaxed) == IB_ID_MAX);
+      s.id.store(id, std::memory_order_relaxed);
+      s.write_unlock();
+      m_hint.store((i + 1) & (N_SLOTS - 1), std::memory_order_relaxed);
+      uint32_t end= m_end.load(std::memory_order_relaxed);
+      while (end <= i &&
+             !m_end.compare_exchange_weak(end, i + 1,
+                                          std::memory_order_relaxed));
+      return i;
+    }
+    m_overflow.fetch_add(1, std::memory_order_relaxed);
+    return NONE;
+  }
+
+  /** Assign the serialisation number of a transaction.
+  @param slot  return value of insert()
+  @param no    transaction serialisation number */
+  void assign_no(uint32_t slot, ib_id_t no)
+  {
+    if (slot == NONE)
+      return;
+    slot_t &s= m_slots[slot];
+    s.write_lock();
+    s.no.store(no, std::memory_order_relaxed);
+    s.write_unlock();
+  }
+
+  /** Deregister a transaction.
+  @param slot  return value of insert() */
+  void erase(uint32_t slot)
+  {
+    if (slot == NONE)
+    {
+      ut_ad(m_overflow.load(std::memory_order_relaxed));
+      m_overflow.fetch_sub(1, std::memory_order_relaxed);
+      return;
+    }
+    ut_ad(slot < m_end.load(std::memory_order_relaxed));
+    slot_t &s= m_slots[slot];
+    s.write_lock();
+    s.id.store(0, std::memory_order_relaxed);
+    s.no.store(IB_ID_MAX, std::memory_order_relaxed);
+    s.write_unlock();
+    m_hint.store(slot, std::memory_order_relaxed);
+  }
+
+  /** @return whether some transactions are missing from the array */
+  bool overflowed() const
+  { return m_overflow.load(std::memory_order_relaxed); }
+
+  /** @return 1 + the largest index of a slot that has been used */
+  uint32_t end() const { return m_end.load(std::memory_order_relaxed); }
+
+  /** Invoke a function on the active transactions.
+  @param f  function to invoke on the id and no of each transaction */
+  template<typename F> void for_each(F f) const
+  {
+    for (const slot_t *s= m_slots, * const end= s + this->end(); s < end; s++)
+    {
+      ib_id_t no;
+      if (const ib_id_t id= s->read(no))
+        f(id, no);
+    }
+  }
+
+  /** Copy the identifiers of the active transactions.
+  @tparam ids_t  std::vector or similar
+  @param ids     the identifiers of the transactions below limit (unsorted)
+  @param limit   smallest transaction identifier not yet assigned
+  @return min(limit, serialisation numbers of the transactions) */
+  template<typename ids_t>
+  ib_id_t snapshot(ids_t &ids, ib_id_t limit) const
+  {
+    ib_id_t min_no= limit;
+    for_each([&](ib_id_t id, ib_id_t no)
+    {
+      if (id < limit)
+      {
+        ids.push_back(id);
+        if (no < min_no)
+          min_no= no;
+      }
+    });
+    return min_no;
+  }
+};
@@ -202,6 +202,27 @@ class purge_sys_t
 
 	/** Heap for reading the undo log records */
 	mem_heap_t*	heap;
+private:
+  /** A sample of trx_sys.get_max_trx_id() for estimating the purge lag:
+  any transaction with a smaller trx_t::no had committed before time. */
+  struct lag_sample_t
+  {
+    /** trx_sys.get_max_trx_id() */
+    trx_id_t trx_id;
+    /** time of the sample */
+    time_t time;
+  };
+  /** samples in ascending order; only accessed by the purge coordinator */
+  lag_sample_t lag_samples[64];
+  /** number of elements in lag_samples */
+  unsigned n_lag_samples;
+  /** minimum interval between lag_samples, in seconds; grows when
+  the samples are thinned out */
+  unsigned lag_interval;
+  /** a time before the commit of the oldest transaction whose history
+  has not been purged, or 0 if not known */
+  Atomic_relaxed<time_t> lag_since;
+public:
   /**
     Constructor.
 
@@ -299,6 +320,20 @@ class purge_sys_t
   /** Update end_view at the end of a purge batch. */
   inline void clone_end_view();
 
+  /** Update the purge lag estimate at the end of a purge batch.
+  @param now  current time */
+  void update_lag(time_t now);
+  /** @return the estimated time in seconds since the oldest transaction
+  whose history has not been purged was committed */
+  ulint lag() const
+  {
+    const time_t since= lag_since;
+    if (!since || !trx_sys.history_exists())
+      return 0;
+    const time_t now= time(nullptr);
+    return now > since ? ulint(now - since) : 0;
+  }
+
   struct view_guard
   {
     inline view_guard();
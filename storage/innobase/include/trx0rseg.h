@@ -128,6 +128,9 @@ struct alignas(CPU_LEVEL1_DCACHE_LINESIZE) trx_rseg_t
     ut_ad(r == SKIP);
 #endif
   }
+  /** Note that undo tablespace truncation was abandoned, while the
+  segment may be in use. */
+  void cancel_skip_allocation() { ut_ad(is_persistent()); ref_reset_skip(); }
   /** @return whether the segment is marked for undo truncation */
   bool skip_allocation() const { return ref_load() & SKIP; }
   /** Increment the reference count */
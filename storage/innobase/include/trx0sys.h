@@ -35,6 +35,7 @@ Created 3/26/1996 Heikki Tuuri
 #include "read0types.h"
 #include "page0types.h"
 #include "trx0trx.h"
+#include "trx0active.h"
 #include "ilist.h"
 #include "my_cpu.h"
 
@@ -855,6 +856,12 @@ class trx_sys_t
 
   bool m_initialised;
 
+  /** whether snapshot_ids() copies active_trx (innodb_read_view_active_array) */
+  bool m_active_array;
+
+  /** Active read-write transactions, if m_active_array */
+  trx_active_t active_trx;
+
 public:
   /** List of all transactions. */
   thread_safe_trx_ilist_t trx_list;
@@ -990,7 +997,10 @@ class trx_sys_t
   */
   void assign_new_trx_no(trx_t *trx)
   {
-    trx->rw_trx_hash_element->no= get_new_trx_id_no_refresh();
+    const trx_id_t no= get_new_trx_id_no_refresh();
+    trx->rw_trx_hash_element->no= no;
+    if (m_active_array)
+      active_trx.assign_no(trx->active_slot, no);
     refresh_rw_trx_hash_version();
   }
 
@@ -1011,6 +1021,10 @@ class trx_sys_t
     of rw_trx_hash.iterate_no_dups(). It means that some transaction
     identifiers may appear multiple times in ids.
 
+    With innodb_read_view_active_array=ON, the identifiers are copied from
+    the dense active_trx array instead of iterating rw_trx_hash, unless
+    some transactions did not fit in the array.
+
     @param[in,out] caller_trx used to get access to rw_trx_hash_pins
     @param[out]    ids        array to store registered transaction identifiers
     @param[out]    max_trx_id variable to store m_max_trx_id value
@@ -1027,6 +1041,15 @@ class trx_sys_t
     arg.m_no= arg.m_id;
 
     ids->clear();
+
+    if (m_active_array && !active_trx.overflowed())
+    {
+      ids->reserve(active_trx.end());
+      *max_trx_id= arg.m_id;
+      *min_trx_no= active_trx.snapshot(*ids, arg.m_id);
+      return;
+    }
+
     ids->reserve(rw_trx_hash.size() + 32);
     rw_trx_hash.iterate(caller_trx, copy_one_id, &arg);
 
@@ -1095,11 +1118,26 @@ class trx_sys_t
   void register_rw(trx_t *trx)
   {
     trx->id= get_new_trx_id_no_refresh();
-    rw_trx_hash.insert(trx);
+    register_recovered_rw(trx);
     refresh_rw_trx_hash_version();
   }
 
 
+  /**
+    Registers a read-write transaction whose identifier has been assigned.
+
+    This is invoked directly for transactions that are resurrected from
+    undo logs on startup, before any MVCC snapshots are created.
+  */
+
+  void register_recovered_rw(trx_t *trx)
+  {
+    rw_trx_hash.insert(trx);
+    if (m_active_array)
+      trx->active_slot= active_trx.insert(trx->id);
+  }
+
+
   /**
     Deregisters read-write transaction.
 
@@ -1110,6 +1148,8 @@ class trx_sys_t
   void deregister_rw(trx_t *trx)
   {
     rw_trx_hash.erase(trx);
+    if (m_active_array)
+      active_trx.erase(trx->active_slot);
   }
 
 
@@ -946,6 +946,8 @@ struct trx_t : ilist_node<>
 					error, or empty. */
 	rw_trx_hash_element_t *rw_trx_hash_element;
 	LF_PINS *rw_trx_hash_pins;
+	/** slot in trx_sys.active_trx if innodb_read_view_active_array=ON */
+	uint32_t active_slot;
 	ulint		magic_n;
 
 	/** @return whether any persistent undo log has been generated */
@@ -48,7 +48,9 @@ Created 5/7/1996 Heikki Tuuri
 #include "scope.h"
 #include <debug_sync.h>
 
+#include <mutex>
 #include <set>
+#include <unordered_map>
 
 #ifdef WITH_WSREP
 #include <mysql/service_wsrep.h>
@@ -58,6 +60,8 @@ Created 5/7/1996 Heikki Tuuri
 my_bool innodb_deadlock_detect;
 /** The value of innodb_deadlock_report */
 ulong innodb_deadlock_report;
+/** The value of innodb_deadlock_detect_interval */
+uint innodb_deadlock_detect_interval;
 
 #ifdef HAVE_REPLICATION
 extern "C" void thd_rpl_deadlock_check(MYSQL_THD thd, MYSQL_THD other_thd);
@@ -279,9 +283,11 @@ namespace Deadlock
   static bool check_and_resolve(trx_t *trx);
 
   /** Quickly detect a deadlock using Brent's cycle detection algorithm.
+  @tparam count  whether to increment lock_sys.deadlocks on a cycle
   @param trx     transaction that is waiting for another transaction
   @return a transaction that is part of a cycle
   @retval nullptr if no cycle was found */
+  template<bool count= true>
   inline trx_t *find_cycle(trx_t *trx)
   {
     mysql_mutex_assert_owner(&lock_sys.wait_mutex);
@@ -291,7 +297,8 @@ namespace Deadlock
       if (tortoise == hare)
       {
         ut_ad(l > 1);
-        lock_sys.deadlocks++;
+        if (count)
+          lock_sys.deadlocks++;
         /* Note: Normally, trx should be part of any deadlock cycle
         that is found. However, if innodb_deadlock_detect=OFF had been
         in effect in the past, it is possible that trx will be waiting
@@ -1114,7 +1121,10 @@ static void lock_reset_lock_and_trx_wait(lock_t *lock)
   ut_ad(lock->is_waiting());
   ut_ad(!trx->lock.wait_lock || trx->lock.wait_lock == lock);
   if (trx_t *wait_trx= trx->lock.wait_trx)
+  {
     Deadlock::to_check.erase(wait_trx);
+    Deadlock::to_check.erase(trx);
+  }
   trx->lock.wait_lock= nullptr;
   trx->lock.wait_trx= nullptr;
   lock->type_mode&= ~LOCK_WAIT;
@@ -3954,6 +3964,101 @@ TRANSACTIONAL_TARGET static bool lock_release_try(trx_t *trx)
   return all_released;
 }
 
+/** Release the explicit locks of a committing transaction while
+holding lock_sys.latch in shared mode, waiting for each lock_sys.rec_hash
+cell latch or dict_table_t::lock_mutex in the normal latching order.
+@param trx   committed transaction
+@return whether all locks were released */
+static bool lock_release_shared(trx_t *trx)
+{
+  DBUG_ASSERT(trx->state == TRX_STATE_COMMITTED_IN_MEMORY);
+  DBUG_ASSERT(!trx->is_referenced());
+  /* number of times that a lock was modified while we waited for
+  the latch that protects it */
+  ulint retries= 0;
+restart:
+  ulint count= 1000;
+  lock_sys.rd_lock(SRW_LOCK_CALL);
+
+  /* Other threads may modify trx->lock.trx_locks while holding
+  trx->mutex and the latch of a lock_sys.rec_hash cell, even though
+  our transaction has been committed: a page split, merge or discard
+  moves our record locks to other pages by lock_rec_add_to_queue()
+  and frees them from the old page by lock_rec_discard(). We must not
+  hold trx->mutex while waiting for a cell latch. After acquiring it,
+  we check that the lock was not moved. */
+  for (;;)
+  {
+    trx->mutex_lock();
+    lock_t *lock= UT_LIST_GET_LAST(trx->lock.trx_locks);
+    if (!lock)
+    {
+      trx->mutex_unlock();
+      break;
+    }
+    ut_ad(lock->trx == trx);
+    if (!lock->is_table())
+    {
+      ut_ad(!lock->index->table->is_temporary());
+      const page_id_t id{lock->un_member.rec_lock.page_id};
+      auto &lock_hash= lock_sys.hash_get(lock->type_mode);
+      trx->mutex_unlock();
+      auto latch= lock_sys_t::hash_table::latch(lock_hash.cell_get(id.fold()));
+      DEBUG_SYNC_C("lock_release_shared");
+      latch->acquire();
+      trx->mutex_lock();
+      if (lock != UT_LIST_GET_LAST(trx->lock.trx_locks) ||
+          lock->is_table() || lock->un_member.rec_lock.page_id != id ||
+          &lock_sys.hash_get(lock->type_mode) != &lock_hash)
+      {
+        trx->mutex_unlock();
+        latch->release();
+        if (++retries >= 100)
+        {
+          lock_sys.rd_unlock();
+          return false;
+        }
+        continue;
+      }
+      lock_rec_dequeue_from_page(lock, false);
+      trx->mutex_unlock();
+      latch->release();
+    }
+    else
+    {
+      /* The table cannot be dropped, because we are holding a lock. */
+      dict_table_t *table= lock->un_member.tab_lock.table;
+      ut_ad(!table->is_temporary());
+      trx->mutex_unlock();
+      table->lock_mutex_lock();
+      trx->mutex_lock();
+      if (lock != UT_LIST_GET_LAST(trx->lock.trx_locks))
+      {
+        /* A record lock was moved while we were waiting. */
+        trx->mutex_unlock();
+        table->lock_mutex_unlock();
+        if (++retries >= 100)
+        {
+          lock_sys.rd_unlock();
+          return false;
+        }
+        continue;
+      }
+      lock_table_dequeue(lock, false);
+      trx->mutex_unlock();
+      table->lock_mutex_unlock();
+    }
+
+    if (!--count)
+      break;
+  }
+
+  lock_sys.rd_unlock();
+  if (!count)
+    goto restart;
+  return true;
+}
+
 /** Release the explicit locks of a committing transaction,
 and release possible other transactions waiting because of these locks. */
 void lock_release(trx_t *trx)
@@ -3968,11 +4073,23 @@ void lock_release(trx_t *trx)
 #endif
   ulint count;
 
+  DBUG_EXECUTE_IF("lock_release_shared", goto release_shared;);
+
   for (count= 5; count--; )
     if (lock_release_try(trx))
       goto released;
 
-  /* Fall back to acquiring lock_sys.latch in exclusive mode */
+  /* Fall back to waiting for the latches. Because there is no need
+  to hold trx->mutex across the latch acquisition, lock_sys.latch
+  does not have to be acquired in exclusive mode. */
+#ifndef DBUG_OFF
+release_shared:
+#endif
+  if (lock_release_shared(trx))
+    goto released;
+
+  /* Our locks kept being moved by other threads. Fall back to
+  acquiring lock_sys.latch in exclusive mode. */
 restart:
   count= 1000;
   /* There is probably no point to try lock elision here;
@@ -4011,7 +4128,8 @@ void lock_release(trx_t *trx)
     goto restart;
 
 released:
-  if (UNIV_UNLIKELY(Deadlock::to_be_checked))
+  if (UNIV_UNLIKELY(Deadlock::to_be_checked) &&
+      !innodb_deadlock_detect_interval)
   {
     mysql_mutex_lock(&lock_sys.wait_mutex);
     lock_sys.deadlock_check();
@@ -6418,7 +6536,13 @@ static bool Deadlock::check_and_resolve(trx_t *trx)
   if (!innodb_deadlock_detect)
     return false;
 
-  if (UNIV_LIKELY_NULL(find_cycle(trx)) && report(trx, true) == trx)
+  if (innodb_deadlock_detect_interval)
+  {
+    /* Leave it to lock_deadlock_detect_callback() to find any cycle. */
+    if (to_check.emplace(trx).second)
+      to_be_checked= true;
+  }
+  else if (UNIV_LIKELY_NULL(find_cycle(trx)) && report(trx, true) == trx)
     return true;
 
   if (UNIV_LIKELY(!trx->lock.was_chosen_as_deadlock_victim))
@@ -6449,6 +6573,13 @@ void lock_sys_t::deadlock_check()
       auto i= Deadlock::to_check.begin();
       if (i == Deadlock::to_check.end())
         break;
+      /* The waits-for graph is protected by wait_mutex. Only for
+      reporting and resolving a deadlock we need exclusive latch. */
+      if (!Deadlock::find_cycle<false>(*i))
+      {
+        Deadlock::to_check.erase(i);
+        continue;
+      }
       if (acquired);
 #if !defined NO_ELISION && !defined SUX_LOCK_GENERIC
       else if (xbegin())
@@ -6486,6 +6617,136 @@ void lock_sys_t::deadlock_check()
     wr_unlock();
 }
 
+/** Protects lock_deadlock_timer */
+static std::mutex lock_deadlock_timer_mutex;
+/** The timer of the background deadlock detector */
+static std::unique_ptr<tpool::timer> lock_deadlock_timer;
+
+/** Check the waits-for graph for cycles that were formed since the
+previous invocation. With innodb_deadlock_detect_interval>0, lock_wait()
+will not search for a cycle, but defers that work to this task. */
+static void lock_deadlock_detect_callback(void*)
+{
+  if (!Deadlock::to_be_checked)
+    return;
+  mysql_mutex_lock(&lock_sys.wait_mutex);
+  lock_sys.deadlock_check();
+  mysql_mutex_unlock(&lock_sys.wait_mutex);
+}
+
+/** Arm or disarm lock_deadlock_timer according to
+innodb_deadlock_detect_interval. */
+static void lock_deadlock_detect_schedule()
+{
+  if (const int interval= int(innodb_deadlock_detect_interval))
+    lock_deadlock_timer->set_time(interval, interval);
+  else
+    lock_deadlock_timer->disarm();
+}
+
+/** Create the timer of the background deadlock detector, and arm or
+disarm it according to innodb_deadlock_detect_interval. */
+void lock_deadlock_detect_start()
+{
+  std::lock_guard<std::mutex> lk(lock_deadlock_timer_mutex);
+  if (!lock_deadlock_timer)
+    lock_deadlock_timer.reset(srv_thread_pool->create_timer
+                              (lock_deadlock_detect_callback));
+  lock_deadlock_detect_schedule();
+}
+
+/** Apply a changed innodb_deadlock_detect_interval. If the background
+deadlock detector was disabled, check the pending waits immediately. */
+void lock_deadlock_detect_update()
+{
+  {
+    std::lock_guard<std::mutex> lk(lock_deadlock_timer_mutex);
+    if (!lock_deadlock_timer)
+      return;
+    lock_deadlock_detect_schedule();
+  }
+  if (!innodb_deadlock_detect_interval)
+    lock_deadlock_detect_callback(nullptr);
+}
+
+/** Shut down the background deadlock detector. */
+void lock_deadlock_detect_shutdown()
+{
+  std::lock_guard<std::mutex> lk(lock_deadlock_timer_mutex);
+  lock_deadlock_timer.reset();
+}
+
+/** Take a snapshot of the waits-for graph.
+@param edges  the waiting transactions and the transactions they wait for */
+void lock_wait_graph(std::vector<lock_wait_edge_t> &edges)
+{
+  /* trx_t::lock.wait_trx may only be changed while holding
+  lock_sys.latch in some mode. Exclusive lock_sys.latch blocks any
+  changes to the waits-for graph. */
+  std::vector<const trx_t*> waiting, blocking;
+  const ulonglong now= my_hrtime_coarse().val;
+  {
+    LockMutexGuard g{SRW_LOCK_CALL};
+    trx_sys.trx_list.for_each([&](const trx_t &trx) {
+      const lock_t *wait_lock= trx.lock.wait_lock;
+      const trx_t *wait_trx= trx.lock.wait_trx;
+      if (!wait_lock || !wait_trx)
+        return;
+      const ulonglong start= my_hrtime_t(trx.lock.suspend_time).val;
+      edges.emplace_back(lock_wait_edge_t{trx.id, wait_trx->id,
+                                          now > start
+                                          ? (now - start) / 1000 : 0,
+                                          wait_lock->is_table(), false});
+      waiting.emplace_back(&trx);
+      blocking.emplace_back(wait_trx);
+    });
+  }
+
+  /* Each transaction waits for at most one other transaction. Follow
+  each path until it reaches the end of the graph, an already visited
+  node, or a node on the current path, which closes a cycle. */
+  const size_t n= edges.size();
+  std::unordered_map<const trx_t*, size_t> index;
+  index.reserve(n);
+  for (size_t i= 0; i < n; i++)
+    index.emplace(waiting[i], i);
+
+  constexpr size_t END= ~size_t{0};
+  std::vector<size_t> next(n, END);
+  for (size_t i= 0; i < n; i++)
+  {
+    auto it= index.find(blocking[i]);
+    if (it != index.end())
+      next[i]= it->second;
+  }
+
+  enum { UNVISITED, ON_PATH, VISITED };
+  std::vector<byte> state(n, UNVISITED);
+  std::vector<size_t> path;
+  for (size_t i= 0; i < n; i++)
+  {
+    size_t j= i;
+    for (; j != END && state[j] == UNVISITED; j= next[j])
+    {
+      state[j]= ON_PATH;
+      path.emplace_back(j);
+    }
+    if (j != END && state[j] == ON_PATH)
+    {
+      size_t k= j;
+      do
+      {
+        edges[k].deadlock= true;
+        k= next[k];
+      }
+      while (k != j);
+    }
+    for (size_t p : path)
+      state[p]= VISITED;
+    path.clear();
+  }
+}
+
 /** Update the locks when a page is split and merged to two pages,
 in defragmentation. */
 void lock_update_split_and_merge(
@@ -561,7 +561,7 @@ static size_t log_encrypt_buf(byte iv[MY_AES_BLOCK_SIZE],
 /** Encrypt the log */
 ATTRIBUTE_NOINLINE void mtr_t::encrypt()
 {
-  ut_ad(log_sys.format == log_t::FORMAT_ENC_10_8);
+  ut_ad(log_sys.format == log_t::FORMAT_ENC_10_9);
   ut_ad(m_log.size());
 
   alignas(8) byte iv[MY_AES_BLOCK_SIZE];
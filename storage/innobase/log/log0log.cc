@@ -133,7 +133,7 @@ void log_t::create()
   next_checkpoint_lsn= 0;
   checkpoint_pending= false;
 
-  buf_free= 0;
+  set_buf_free(0);
 
   ut_ad(is_initialised());
 }
@@ -210,7 +210,8 @@ void log_t::attach(log_file_t file, os_offset_t size)
 #ifdef HAVE_PMEM
   ut_ad(!buf);
   ut_ad(!flush_buf);
-  if (size && !(size_t(size) & 4095) && srv_operation != SRV_OPERATION_BACKUP)
+  if (size && !(size_t(size) & 4095) && srv_operation != SRV_OPERATION_BACKUP
+      && !DBUG_IF("innodb_log_no_mmap"))
   {
     void *ptr= log_mmap(log.m_file, size);
     if (ptr != MAP_FAILED)
@@ -254,7 +255,7 @@ void log_t::attach(log_file_t file, os_offset_t size)
 void log_t::header_write(byte *buf, lsn_t lsn, bool encrypted)
 {
   mach_write_to_4(my_assume_aligned<4>(buf) + LOG_HEADER_FORMAT,
-                  log_sys.FORMAT_10_8);
+                  log_sys.FORMAT_10_9);
   mach_write_to_8(my_assume_aligned<8>(buf + LOG_HEADER_START_LSN), lsn);
   static constexpr const char LOG_HEADER_CREATOR_CURRENT[]=
     "MariaDB "
@@ -297,7 +298,7 @@ void log_t::create(lsn_t lsn) noexcept
   else
 #endif
   {
-    buf_free= 0;
+    set_buf_free(0);
     memset_aligned<4096>(flush_buf, 0, buf_size);
     memset_aligned<4096>(buf, 0, buf_size);
   }
@@ -484,7 +485,7 @@ log_t::resize_start_status log_t::resize_start(os_offset_t size) noexcept
         }
         else
         {
-          memcpy_aligned<16>(resize_buf, buf, (buf_free + 15) & ~15);
+          memcpy_aligned<16>(resize_buf, buf, (get_buf_free() + 15) & ~15);
           start_lsn= first_lsn +
             (~lsn_t{get_block_size() - 1} & (write_lsn - first_lsn));
         }
@@ -777,9 +778,12 @@ template<bool release_latch> inline lsn_t log_t::write_buf() noexcept
 
   if (write_lsn >= lsn)
   {
+    ut_ad(write_lsn == lsn);
+    /* A reservation that exceeds buf_size may have set
+    BUF_FREE_BACKOFF. Let append_prepare() retry. */
+    buf_free= get_buf_free();
     if (release_latch)
       latch.wr_unlock();
-    ut_ad(write_lsn == lsn);
   }
   else
   {
@@ -792,10 +796,11 @@ template<bool release_latch> inline lsn_t log_t::write_buf() noexcept
     DBUG_PRINT("ib_log", ("write " LSN_PF " to " LSN_PF " at " LSN_PF,
                           write_lsn, lsn, offset));
     const byte *write_buf{buf};
-    size_t length{buf_free};
+    size_t length{get_buf_free()};
     ut_ad(length >= (calc_lsn_offset(write_lsn) & block_size_1));
+    ut_ad(lsn == buf_start_lsn + length);
     const size_t new_buf_free{length & block_size_1};
-    buf_free= new_buf_free;
+    set_buf_free(new_buf_free);
     ut_ad(new_buf_free == ((lsn - first_lsn) & block_size_1));
 
     if (new_buf_free)
@@ -980,7 +985,7 @@ Tries to establish a big enough margin of free space in the log buffer, such
 that a new log entry can be catenated without an immediate need for a flush. */
 ATTRIBUTE_COLD static void log_flush_margin()
 {
-  if (log_sys.buf_free > log_sys.max_buf_free)
+  if (log_sys.get_buf_free() > log_sys.max_buf_free)
     log_buffer_flush_to_disk(false);
 }
 
@@ -1072,6 +1077,7 @@ ATTRIBUTE_COLD void logs_empty_and_mark_files_at_shutdown()
 		buf_dump_start();
 	}
 	srv_monitor_timer.reset();
+	lock_deadlock_detect_shutdown();
 
 	if (do_srv_shutdown) {
 		srv_shutdown(srv_fast_shutdown == 0);
@@ -28,6 +28,7 @@ Created 9/20/1997 Heikki Tuuri
 
 #include <map>
 #include <string>
+#include <thread>
 #include <my_service_manager.h>
 
 #include "log0recv.h"
@@ -1799,6 +1800,7 @@ dberr_t recv_sys_t::find_checkpoint()
     sql_print_error("InnoDB: Unsupported redo log format."
                     " The redo log was created with %s.", creator);
     return DB_ERROR;
+  case log_t::FORMAT_10_9:
   case log_t::FORMAT_10_8:
     if (files.size() != 1)
     {
@@ -1822,7 +1824,7 @@ dberr_t recv_sys_t::find_checkpoint()
       return DB_ERROR;
     }
     else
-      log_sys.format= log_t::FORMAT_ENC_10_8;
+      log_sys.format|= log_t::FORMAT_ENCRYPTED;
 
     for (size_t field= log_t::CHECKPOINT_1; field <= log_t::CHECKPOINT_2;
          field+= log_t::CHECKPOINT_2 - log_t::CHECKPOINT_1)
@@ -2576,13 +2578,32 @@ inline recv_sys_t::parse_mtr_result recv_sys_t::parse(store_t store, source &l)
           innodb_undo_log_truncate=ON. Discard old log for all pages. */
           trim({space_id, 0}, lsn);
           truncated_undo_spaces[space_id - srv_undo_space_id_start]=
-            { lsn, page_no };
+            { lsn, lsn, page_no };
           if (undo_space_trunc)
             undo_space_trunc(space_id);
 #endif
           last_offset= 1; /* the next record must not be same_page  */
           continue;
         }
+        if (rlen == 1 && *cl == SHRINK_PAGES)
+        {
+          /* SHRINK_PAGES was introduced in FORMAT_10_9. */
+          if ((~log_t::FORMAT_ENCRYPTED & log_sys.format) ==
+              log_t::FORMAT_10_8 ||
+              !srv_is_undo_tablespace(space_id) ||
+              page_no < SRV_UNDO_TABLESPACE_SIZE_IN_PAGES)
+            goto record_corrupted;
+          /* fsp_shrink_undo_tablespace() discarded the free extents
+          at the end of the file. Discard old log for those pages. */
+          trim({space_id, page_no}, lsn);
+          trunc &t= truncated_undo_spaces[space_id - srv_undo_space_id_start];
+          t.lsn= lsn;
+          t.pages= page_no;
+          if (undo_space_trunc)
+            undo_space_trunc(space_id);
+          last_offset= 1; /* the next record must not be same_page  */
+          continue;
+        }
         last_offset= FIL_PAGE_TYPE;
         break;
       case OPTION:
@@ -3126,13 +3147,19 @@ static buf_block_t *recv_recover_page(buf_block_t *block, mtr_t &mtr,
 	ut_ad(!block || p->second.is_being_processed());
 	ut_ad(!block || !recv_sys.pages.empty());
 
+	if (block) {
+		recv_sys.pages_applied++;
+	}
+
 	if (recv_sys.report(now)) {
 		const size_t n = recv_sys.pages.size();
-		sql_print_information("InnoDB: To recover: %zu pages from log",
-				      n);
+		const size_t rate = recv_sys.apply_rate(now);
+		sql_print_information("InnoDB: To recover: %zu pages from log"
+				      " (%zu pages/s)", n, rate);
 		service_manager_extend_timeout(INNODB_EXTEND_TIMEOUT_INTERVAL,
 					       "To recover: %zu pages"
-					       " from log", n);
+					       " from log (%zu pages/s)",
+					       n, rate);
 	}
 
 	return block;
@@ -3374,6 +3401,98 @@ buf_block_t *recv_sys_t::recover_low(const page_id_t page_id)
   return block;
 }
 
+/** Pages that are being initialized based on redo log records by
+recv_sys_t::recover_parallel() */
+struct recv_init_t
+{
+  /** default number of adjacent pages that are claimed at a time */
+  static constexpr size_t CHUNK= 32;
+
+  /** the pages, in ascending order */
+  const std::vector<page_id_t> &page_ids;
+  /** number of adjacent pages that are claimed at a time */
+  size_t chunk= CHUNK;
+  /** index of the next chunk of page_ids[] to process */
+  Atomic_relaxed<size_t> next{0};
+#ifndef DBUG_OFF
+  /** number of run() invocations that initialized some pages */
+  Atomic_counter<size_t> active{0};
+#endif
+
+  recv_init_t(const std::vector<page_id_t> &page_ids) : page_ids(page_ids) {}
+
+  /** Process chunks until all pages have been processed or
+  corruption has been detected. */
+  void run()
+  {
+    ut_d(bool claimed= false);
+    for (;;)
+    {
+      size_t i= next.fetch_add(chunk);
+      if (i >= page_ids.size())
+        return;
+#ifndef DBUG_OFF
+      if (!claimed)
+      {
+        claimed= true;
+        active++;
+      }
+#endif
+      for (const size_t end= std::min(i + chunk, page_ids.size());
+           i < end; i++)
+      {
+        if (recv_sys.is_corrupt_log() || recv_sys.is_corrupt_fs())
+          return;
+        recv_sys.recover(page_ids[i]);
+        DBUG_EXECUTE_IF("recv_parallel_tasks",
+                        std::this_thread::sleep_for(
+                          std::chrono::milliseconds(1)););
+      }
+    }
+  }
+
+  /** Task callback for srv_thread_pool */
+  static void task(void *arg) { static_cast<recv_init_t*>(arg)->run(); }
+};
+
+void recv_sys_t::recover_parallel(const std::vector<page_id_t> &page_ids)
+{
+  mysql_mutex_assert_not_owner(&mutex);
+  recv_init_t init(page_ids);
+  std::vector<tpool::waitable_task*> tasks;
+  /* Claim one page at a time, so that every task gets some work. */
+  DBUG_EXECUTE_IF("recv_parallel_tasks", init.chunk= 1;);
+
+  for (size_t i= std::min<size_t>(srv_n_read_io_threads,
+                                  (page_ids.size() + init.chunk - 1) /
+                                  init.chunk); i-- > 1; )
+  {
+    auto task= new tpool::waitable_task(recv_init_t::task, &init);
+    tasks.push_back(task);
+    srv_thread_pool->submit_task(task);
+  }
+
+  init.run();
+
+  for (auto task : tasks)
+  {
+    task->wait();
+    delete task;
+  }
+
+#ifndef DBUG_OFF
+  static bool reported;
+  if (!reported && init.active > 1 && DBUG_IF("recv_parallel_tasks"))
+  {
+    reported= true;
+    sql_print_information("InnoDB: Initialized %zu pages in %zu of %zu"
+                          " parallel recovery tasks",
+                          page_ids.size(), size_t{init.active},
+                          tasks.size() + 1);
+  }
+#endif
+}
+
 inline fil_space_t *fil_system_t::find(const char *path) const
 {
   mysql_mutex_assert_owner(&mutex);
@@ -3458,6 +3577,8 @@ void recv_sys_t::apply(bool last_batch)
 
     apply_log_recs= true;
     apply_batch_on= true;
+    apply_start= time(nullptr);
+    pages_applied= 0;
 
     for (auto id= srv_undo_tablespaces_open; id--;)
     {
@@ -3469,7 +3590,11 @@ void recv_sys_t::apply(bool last_batch)
         Even though we recv_sys_t::parse() already invoked trim(),
         this will be needed in case recovery consists of multiple batches
         (there was an invocation with !last_batch). */
-        trim({id + srv_undo_space_id_start, 0}, t.lsn);
+        if (t.reinit_lsn)
+          trim({id + srv_undo_space_id_start, 0}, t.reinit_lsn);
+        /* A later SHRINK_PAGES only discarded the end of the file. */
+        if (t.lsn != t.reinit_lsn)
+          trim({id + srv_undo_space_id_start, t.pages}, t.lsn);
         if (fil_space_t *space = fil_space_get(id + srv_undo_space_id_start))
         {
           ut_ad(UT_LIST_GET_LEN(space->chain) == 1);
@@ -3498,6 +3623,12 @@ void recv_sys_t::apply(bool last_batch)
       log_sys.latch.wr_lock(SRW_LOCK_CALL);
     mysql_mutex_lock(&mutex);
 
+    /* Pages that will be initialized based on redo log records. They
+    are recovered after the reads of all other pages have been submitted,
+    so that the reads will be completed while the pages are being
+    initialized. */
+    std::vector<page_id_t> init_pages;
+
     for (map::iterator p= pages.begin(); p != pages.end(); )
     {
       const page_id_t page_id= p->first;
@@ -3528,7 +3659,15 @@ void recv_sys_t::apply(bool last_batch)
         else
           deferred_spaces.defers.erase(d);
         if (!free_block)
-          goto next_free_block;
+        {
+          mysql_mutex_unlock(&mutex);
+          if (!last_batch)
+            log_sys.latch.wr_unlock();
+          free_block= buf_LRU_get_free_block(false);
+          if (!last_batch)
+            log_sys.latch.wr_lock(SRW_LOCK_CALL);
+          mysql_mutex_lock(&mutex);
+        }
         p= pages.lower_bound(page_id);
         continue;
       }
@@ -3539,19 +3678,8 @@ void recv_sys_t::apply(bool last_batch)
         p++;
         continue;
       case page_recv_t::RECV_WILL_NOT_READ:
-        if (UNIV_LIKELY(!!recover_low(page_id, p, mtr, free_block)))
-        {
-next_free_block:
-          mysql_mutex_unlock(&mutex);
-          if (!last_batch)
-            log_sys.latch.wr_unlock();
-          free_block= buf_LRU_get_free_block(false);
-          if (!last_batch)
-            log_sys.latch.wr_lock(SRW_LOCK_CALL);
-          mysql_mutex_lock(&mutex);
-          break;
-        }
-        ut_ad(p == pages.end() || p->first > page_id);
+        init_pages.push_back(page_id);
+        p++;
         continue;
       case page_recv_t::RECV_NOT_PROCESSED:
         recv_read_in_area(page_id, p);
@@ -3564,6 +3692,18 @@ void recv_sys_t::apply(bool last_batch)
 
     buf_pool.free_block(free_block);
 
+    if (!init_pages.empty())
+    {
+      /* Allocating blocks may initiate a redo log write; see above. */
+      mysql_mutex_unlock(&mutex);
+      if (!last_batch)
+        log_sys.latch.wr_unlock();
+      recover_parallel(init_pages);
+      if (!last_batch)
+        log_sys.latch.wr_lock(SRW_LOCK_CALL);
+      mysql_mutex_lock(&mutex);
+    }
+
     /* Wait until all the pages have been processed */
     for (;;)
     {
@@ -3605,6 +3745,11 @@ void recv_sys_t::apply(bool last_batch)
                               " to ignore corrupted pages.");
       return;
     }
+
+    const time_t now= time(nullptr);
+    sql_print_information("InnoDB: Recovered %zu pages from redo log"
+                          " in %zu seconds (%zu pages/s)", pages_applied,
+                          size_t(now - apply_start), apply_rate(now));
   }
 
   if (last_batch)
@@ -4317,7 +4462,7 @@ dberr_t recv_recovery_from_checkpoint_start()
 				 PROT_READ | PROT_WRITE);
 #endif
 		}
-		log_sys.buf_free = recv_sys.offset;
+		log_sys.set_buf_free(recv_sys.offset);
 		if (recv_needed_recovery
 		    && srv_operation == SRV_OPERATION_NORMAL) {
 			/* Write a FILE_CHECKPOINT marker as the first thing,
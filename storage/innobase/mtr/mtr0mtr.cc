@@ -497,7 +497,7 @@ void mtr_t::commit_shrink(fil_space_t &space)
   ut_ad(!is_inside_ibuf());
   ut_ad(!high_level_read_only);
   ut_ad(m_modifications);
-  ut_ad(m_made_dirty);
+  ut_ad(m_made_dirty || !space.is_being_truncated);
   ut_ad(!m_memo.empty());
   ut_ad(!recv_recovery_is_on());
   ut_ad(m_log_mode == MTR_LOG_ALL);
@@ -520,7 +520,14 @@ void mtr_t::commit_shrink(fil_space_t &space)
   os_file_truncate(space.chain.start->name, space.chain.start->handle,
                    os_offset_t{space.size} << srv_page_size_shift, true);
 
-  space.clear_freed_ranges();
+  space.freed_range_mutex.lock();
+  if (space.is_being_truncated)
+    space.clear_freed_ranges();
+  else
+    /* The pages below the new size are still in use, and some of
+    them may have been freed by earlier mini-transactions. */
+    space.clear_freed_ranges(space.size);
+  space.freed_range_mutex.unlock();
 
   const page_id_t high{space.id, space.size};
   size_t modified= 0;
@@ -583,12 +590,16 @@ void mtr_t::commit_shrink(fil_space_t &space)
   log_sys.latch.wr_unlock();
   m_latch_ex= false;
 
-  mysql_mutex_lock(&fil_system.mutex);
-  ut_ad(space.is_being_truncated);
-  ut_ad(space.is_stopping());
-  space.clear_stopping();
-  space.is_being_truncated= false;
-  mysql_mutex_unlock(&fil_system.mutex);
+  /* When only free extents at the end of the file were discarded
+  by fsp_shrink_undo_tablespace(), the tablespace was never stopped. */
+  if (space.is_being_truncated)
+  {
+    mysql_mutex_lock(&fil_system.mutex);
+    ut_ad(space.is_stopping());
+    space.clear_stopping();
+    space.is_being_truncated= false;
+    mysql_mutex_unlock(&fil_system.mutex);
+  }
 
   release();
   release_resources();
@@ -869,8 +880,7 @@ ATTRIBUTE_COLD static void log_overwrite_warning(lsn_t lsn)
 @param ex   whether log_sys.latch is exclusively locked */
 ATTRIBUTE_COLD void log_t::append_prepare_wait(bool ex) noexcept
 {
-  log_sys.waits++;
-  log_sys.unlock_lsn();
+  log_sys.waits.fetch_add(1);
 
   if (ex)
     log_sys.latch.wr_unlock();
@@ -884,8 +894,51 @@ ATTRIBUTE_COLD void log_t::append_prepare_wait(bool ex) noexcept
     log_sys.latch.wr_lock(SRW_LOCK_CALL);
   else
     log_sys.latch.rd_lock(SRW_LOCK_CALL);
+}
 
-  log_sys.lock_lsn();
+/** Reserve space in buf if !is_pmem().
+Concurrent mini-transactions that hold latch.rd_lock() reserve
+disjoint ranges of buf by buf_free.fetch_add() and copy their log
+in parallel. The LSN of each range is determined by its offset,
+because buf_start_lsn can only change while holding latch.wr_lock(),
+which write_buf() will only acquire after all copying has completed.
+@param size   total length of the data to append(), in bytes
+@param ex     whether log_sys.latch is exclusively locked
+@return the start LSN and the offset within buf */
+inline std::pair<lsn_t,size_t> log_t::append_reserve(size_t size, bool ex)
+  noexcept
+{
+  ut_ad(!is_pmem());
+#ifdef DBUG_OFF
+  const size_t avail{buf_size - size};
+#else
+  size_t avail{buf_size - size};
+  /* Pretend that buf is small, so that concurrent reservations fail
+  often. The limit is above size, so that a failed reservation implies
+  that there is some log in buf for write_buf() to write. */
+  DBUG_EXECUTE_IF("log_buf_small",
+                  if (size < 32768) avail= std::min(avail, 65536 - size););
+#endif
+  write_to_buf.fetch_add(1);
+
+  size_t b;
+  for (ut_d(int count= 50);
+       UNIV_UNLIKELY((b= buf_free.fetch_add(size)) > avail); )
+  {
+    /* The reservation failed. Prevent anyone from reserving the space
+    that we are releasing, because some reservations after ours might
+    still be pending release. */
+    buf_free.fetch_or(BUF_FREE_BACKOFF);
+    buf_free.fetch_sub(size);
+    append_prepare_wait(ex);
+    ut_ad(count--);
+  }
+
+  const lsn_t l{buf_start_lsn + b}, end{l + size};
+  for (lsn_t old{lsn.load(std::memory_order_relaxed)};
+       old < end && !lsn.compare_exchange_weak(old, end,
+                                              std::memory_order_relaxed); ) {}
+  return {l, b};
 }
 
 /** Reserve space in the log buffer for appending data.
@@ -905,17 +958,27 @@ std::pair<lsn_t,byte*> log_t::append_prepare(size_t size, bool ex) noexcept
 #endif
   ut_ad(pmem == is_pmem());
   const lsn_t checkpoint_margin{last_checkpoint_lsn + log_capacity - size};
-  const size_t avail{(pmem ? size_t(capacity()) : buf_size) - size};
+
+  if (!pmem)
+  {
+    const auto r= append_reserve(size, ex);
+    if (UNIV_UNLIKELY(r.first > checkpoint_margin) || r.second >= max_buf_free)
+      set_check_flush_or_checkpoint();
+    return {r.first, &buf[r.second]};
+  }
+
+  const size_t avail{size_t(capacity()) - size};
   lock_lsn();
-  write_to_buf++;
+  write_to_buf.fetch_add(1);
 
   for (ut_d(int count= 50);
-       UNIV_UNLIKELY((pmem
-                      ? size_t(get_lsn() -
-                               get_flushed_lsn(std::memory_order_relaxed))
-                      : size_t{buf_free}) > avail); )
+       UNIV_UNLIKELY(size_t(get_lsn() -
+                            get_flushed_lsn(std::memory_order_relaxed)) >
+                     avail); )
   {
+    unlock_lsn();
     append_prepare_wait(ex);
+    lock_lsn();
     ut_ad(count--);
   }
 
@@ -924,13 +987,12 @@ std::pair<lsn_t,byte*> log_t::append_prepare(size_t size, bool ex) noexcept
   const size_t b{buf_free};
   size_t new_buf_free{b};
   new_buf_free+= size;
-  if (pmem && new_buf_free >= file_size)
+  if (new_buf_free >= file_size)
     new_buf_free-= size_t(capacity());
   buf_free= new_buf_free;
   unlock_lsn();
 
-  if (UNIV_UNLIKELY(l > checkpoint_margin) ||
-      (!pmem && b >= max_buf_free))
+  if (UNIV_UNLIKELY(l > checkpoint_margin))
     set_check_flush_or_checkpoint();
 
   return {l, &buf[b]};
@@ -4029,11 +4029,17 @@ void fil_node_t::find_metadata(os_file_t file
     atomic_write= true;
   }
   else
+  {
     /* On Windows, all single sector writes are atomic, as per
     WriteFile() documentation on MSDN. */
     atomic_write= srv_use_atomic_writes &&
       IF_WIN(srv_page_size == block_size,
 	     my_test_if_atomic_write(file, space->physical_size()));
+    /* Pretend that the file resides on a device that guarantees
+    atomic writes of a page, so that use_doublewrite() will not hold. */
+    DBUG_EXECUTE_IF("innodb_atomic_write",
+                    atomic_write= srv_use_atomic_writes != 0;);
+  }
 }
 
 /** Read the first page of a data file.
@@ -28,6 +28,7 @@ Completed by Sunny Bains and Marko Makela
 #include <log.h>
 #include <sql_class.h>
 #include <math.h>
+#include <mutex>
 
 #include "row0merge.h"
 #include "row0ext.h"
@@ -61,6 +62,9 @@ Completed by Sunny Bains and Marko Makela
 /* Whether to disable file system cache */
 char	srv_disable_sort_file_cache;
 
+/** Number of threads for merging sorted runs in row_merge_sort() */
+ulong	srv_merge_sort_threads = 1;
+
 /** Class that caches spatial index row tuples made from a single cluster
 index page scan, and then insert into corresponding index tree */
 class spatial_index_info {
@@ -3113,6 +3117,15 @@ row_merge_read_clustered_index(
 	ROW_MERGE_WRITE_GET_NEXT_LOW(N, INDEX, AT_END)
 #endif /* HAVE_PSI_STAGE_INTERFACE */
 
+/** Serializes the reporting of duplicate keys by the concurrent merges
+of row_merge_parallel(), which share dup->table->record[0] */
+struct row_merge_dup_sync_t
+{
+	std::mutex	mutex;
+	/** whether a duplicate has been copied to dup->table->record[0] */
+	bool		reported = false;
+};
+
 /** Merge two blocks of records on disk and write a bigger block.
 @param[in]	dup	descriptor of index being created
 @param[in]	file	file containing index entries
@@ -3125,6 +3138,8 @@ ALTER TABLE. If not NULL stage->inc() will be called for each record
 processed.
 @param[in,out]	crypt_block	encryption buffer
 @param[in]	space	tablespace ID for encryption
+@param[in,out]	dup_sync	for reporting a duplicate of concurrent
+merges, or NULL if this is the only merge
 @return DB_SUCCESS or error code */
 static MY_ATTRIBUTE((warn_unused_result))
 dberr_t
@@ -3137,7 +3152,8 @@ row_merge_blocks(
 	merge_file_t*		of,
 	ut_stage_alter_t*	stage MY_ATTRIBUTE((unused)),
 	row_merge_block_t*	crypt_block,
-	ulint			space)
+	ulint			space,
+	row_merge_dup_sync_t*	dup_sync = NULL)
 {
 	mem_heap_t*	heap;	/*!< memory heap for offsets0, offsets1 */
 
@@ -3199,12 +3215,24 @@ row_merge_blocks(
 	while (mrec0 && mrec1) {
 		int cmp = cmp_rec_rec_simple(
 			mrec0, mrec1, offsets0, offsets1,
-			dup->index, dup->table);
+			dup->index, dup_sync ? NULL : dup->table);
 		if (cmp < 0) {
 			ROW_MERGE_WRITE_GET_NEXT(0, dup->index, goto merged);
 		} else if (cmp) {
 			ROW_MERGE_WRITE_GET_NEXT(1, dup->index, goto merged);
 		} else {
+			if (dup_sync && dup->table) {
+				/* Report the first duplicate that any
+				of the concurrent merges found. */
+				std::lock_guard<std::mutex> g(dup_sync->mutex);
+				if (!dup_sync->reported) {
+					dup_sync->reported = true;
+					innobase_rec_to_mysql(dup->table,
+							      mrec0,
+							      dup->index,
+							      offsets0);
+				}
+			}
 			mem_heap_free(heap);
 			DBUG_RETURN(DB_DUPLICATE_KEY);
 		}
@@ -3473,6 +3501,229 @@ row_merge(
 	return(DB_SUCCESS);
 }
 
+namespace
+{
+/** State of a merge pass that is shared by the threads of
+row_merge_parallel(). Like in row_merge(), the first half of the runs
+is merged with the second half. Each merge of two runs is an
+independent job. The output of the merge of the runs starting at
+run_offset[k] and run_offset[half + k] is written at the offset where
+it would start if the input runs of all preceding jobs had been laid out
+back to back. Because the output of a merge never occupies more blocks
+than its inputs, the jobs cannot overlap. The gaps between the output
+runs are never read, because runs are only accessed via run_offset[]. */
+struct row_merge_pass_t
+{
+  /** transaction */
+  trx_t *const trx;
+  /** descriptor of the index being created */
+  const row_merge_dup_t *const dup;
+  /** input file */
+  const merge_file_t *const file;
+  /** output file handle */
+  const pfs_os_file_t out;
+  /** first offset of each input run */
+  const ulint *const run_offset;
+  /** first offset of each output run */
+  ulint *const out_offset;
+  /** number of input runs */
+  const ulint n_run;
+  /** number of input runs in the first half */
+  const ulint half;
+  /** tablespace ID for encryption */
+  const ulint space;
+  /** number of the next job to execute */
+  Atomic_relaxed<ulint> next{0};
+  /** number of records written */
+  Atomic_relaxed<ulint> n_rec{0};
+  /** end offset of the output file */
+  Atomic_relaxed<ulint> end{0};
+  /** the first error that was encountered */
+  Atomic_relaxed<dberr_t> err{DB_SUCCESS};
+  /** for reporting a duplicate key found by one of the merges */
+  row_merge_dup_sync_t dup_sync;
+
+  row_merge_pass_t(trx_t *trx, const row_merge_dup_t *dup,
+                   const merge_file_t *file, pfs_os_file_t out,
+                   const ulint *run_offset, ulint *out_offset, ulint n_run,
+                   ulint space) :
+    trx(trx), dup(dup), file(file), out(out), run_offset(run_offset),
+    out_offset(out_offset), n_run(n_run), half(n_run / 2), space(space) {}
+
+  /** @return the number of jobs (output runs) */
+  ulint n_jobs() const { return n_run - half; }
+
+  /** Execute jobs until all have been executed or an error occurs.
+  @param block        3 buffers
+  @param crypt_block  encryption buffer, or nullptr */
+  void run(row_merge_block_t *block, row_merge_block_t *crypt_block)
+  {
+    while (err == DB_SUCCESS)
+    {
+      const ulint k= next.fetch_add(1);
+      if (k >= n_jobs())
+        break;
+      dberr_t e= trx_is_interrupted(trx)
+        ? DB_INTERRUPTED : execute(k, block, crypt_block);
+      if (e != DB_SUCCESS)
+      {
+        dberr_t expected= DB_SUCCESS;
+        err.compare_exchange_strong(expected, e);
+      }
+    }
+  }
+
+private:
+  /** Merge or copy runs to one output run.
+  @param k            job number
+  @param block        3 buffers
+  @param crypt_block  encryption buffer, or nullptr
+  @return error code */
+  dberr_t execute(ulint k, row_merge_block_t *block,
+                  row_merge_block_t *crypt_block)
+  {
+    ulint foffs1= run_offset[half + k];
+    merge_file_t of;
+    of.fd= out;
+    of.offset= (k < half ? run_offset[k] : run_offset[half]) + foffs1 -
+      run_offset[half];
+    of.n_rec= 0;
+    out_offset[k]= of.offset;
+
+    if (k < half)
+    {
+      ulint foffs0= run_offset[k];
+      if (dberr_t e= row_merge_blocks(dup, file, block, &foffs0, &foffs1,
+                                      &of, nullptr, crypt_block, space,
+                                      &dup_sync))
+        return e;
+    }
+    else if (!row_merge_blocks_copy(dup->index, file, block, &foffs1, &of,
+                                    nullptr, crypt_block, space))
+      return DB_CORRUPTION;
+
+    n_rec.fetch_add(of.n_rec);
+    /* The output of the last job ends at the end of the file. */
+    if (k + 1 == n_jobs())
+      end= of.offset;
+    return DB_SUCCESS;
+  }
+};
+
+/** A thread that participates in row_merge_parallel() */
+struct row_merge_worker_t
+{
+  /** the merge pass */
+  row_merge_pass_t *pass;
+  /** 3 buffers */
+  row_merge_block_t *block;
+  /** encryption buffer, or nullptr */
+  row_merge_block_t *crypt_block;
+
+  /** Task callback for srv_thread_pool */
+  static void run(void *arg)
+  {
+    row_merge_worker_t *w= static_cast<row_merge_worker_t*>(arg);
+    w->pass->run(w->block, w->crypt_block);
+  }
+};
+}
+
+/** Merge disk files, executing the merges of pairs of runs concurrently.
+@param[in]	trx		transaction
+@param[in]	dup		descriptor of index being created
+@param[in,out]	file		file containing index entries
+@param[in]	n_threads	number of threads
+@param[in,out]	block		3 buffers for each thread
+@param[in,out]	tmpfd		temporary file handle
+@param[in,out]	num_run		Number of runs that remain to be merged
+@param[in,out]	run_offset	Array that contains the first offset number
+for each merge run
+@param[in,out]	stage		performance schema accounting object, used by
+ALTER TABLE. If not NULL stage->inc() will be called for each record
+processed.
+@param[in,out]	crypt_block	encryption buffer for each thread, or NULL
+@param[in]	space		tablespace ID for encryption
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_parallel(
+	trx_t*			trx,
+	const row_merge_dup_t*	dup,
+	merge_file_t*		file,
+	ulint			n_threads,
+	row_merge_block_t**	block,
+	pfs_os_file_t*		tmpfd,
+	ulint*			num_run,
+	ulint*			run_offset,
+	ut_stage_alter_t*	stage,
+	row_merge_block_t**	crypt_block,
+	ulint			space)
+{
+	ulint*	out_offset = static_cast<ulint*>(
+		ut_malloc_nokey(*num_run * sizeof *out_offset));
+
+	if (!out_offset) {
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	row_merge_pass_t	pass(trx, dup, file, *tmpfd, run_offset,
+				     out_offset, *num_run, space);
+
+	n_threads = std::min(n_threads, pass.n_jobs());
+
+	std::vector<row_merge_worker_t>		workers(n_threads);
+	std::vector<tpool::waitable_task*>	tasks;
+
+	for (ulint i = 0; i < n_threads; i++) {
+		workers[i].pass = &pass;
+		workers[i].block = block[i];
+		workers[i].crypt_block = crypt_block ? crypt_block[i] : NULL;
+
+		if (i) {
+			tasks.push_back(new tpool::waitable_task(
+				row_merge_worker_t::run, &workers[i]));
+			srv_thread_pool->submit_task(tasks.back());
+		}
+	}
+
+	row_merge_worker_t::run(&workers[0]);
+
+	for (tpool::waitable_task* task : tasks) {
+		task->wait();
+		delete task;
+	}
+
+	dberr_t	error = pass.err;
+
+	if (error == DB_SUCCESS && UNIV_UNLIKELY(pass.n_rec != file->n_rec)) {
+		error = DB_CORRUPTION;
+	}
+
+	if (error == DB_SUCCESS) {
+		ut_ad(pass.end <= file->offset);
+
+#ifdef HAVE_PSI_STAGE_INTERFACE
+		if (stage != NULL) {
+			for (ulint i = 0; i < file->n_rec; i++) {
+				stage->inc();
+			}
+		}
+#endif /* HAVE_PSI_STAGE_INTERFACE */
+
+		*num_run = pass.n_jobs();
+		memcpy(run_offset, out_offset, *num_run * sizeof *run_offset);
+
+		/* Swap file descriptors for the next pass. */
+		*tmpfd = file->fd;
+		file->fd = pass.out;
+		file->offset = pass.end;
+	}
+
+	ut_free(out_offset);
+	return(error);
+}
+
 /** Merge disk files.
 @param[in]	trx	transaction
 @param[in]	dup	descriptor of index being created
@@ -3528,9 +3779,56 @@ row_merge_sort(
 	/* "run_offset" records each run's first offset number */
 	run_offset = (ulint*) ut_malloc_nokey(file->offset * sizeof(ulint));
 
-	/* This tells row_merge() where to start for the first round
-	of merge. */
-	run_offset[half] = half;
+	/* Full-text indexes are sorted by fts_parallel_tokenization()
+	in srv_thread_pool tasks already. */
+	ulint	n_threads = dup->index->type & DICT_FTS
+		? 1 : std::min<ulint>(srv_merge_sort_threads, num_runs / 2);
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	std::vector<row_merge_block_t*>	blocks{block};
+	std::vector<row_merge_block_t*>	crypt_blocks{crypt_block};
+	std::vector<ut_new_pfx_t>	pfx;
+
+	if (n_threads > 1) {
+		pfx.resize(2 * n_threads);
+
+		for (ulint i = 1; i < n_threads; i++) {
+			row_merge_block_t* b = alloc.allocate_large(
+				3 * srv_sort_buf_size, &pfx[2 * i]);
+			row_merge_block_t* c = NULL;
+
+			if (b && crypt_block) {
+				c = alloc.allocate_large(
+					3 * srv_sort_buf_size,
+					&pfx[2 * i + 1]);
+				if (!c) {
+					alloc.deallocate_large(b, &pfx[2 * i]);
+					b = NULL;
+				}
+			}
+
+			if (!b) {
+				/* Use the buffers that we got. */
+				break;
+			}
+
+			blocks.push_back(b);
+			crypt_blocks.push_back(c);
+		}
+
+		n_threads = blocks.size();
+	}
+
+	if (n_threads > 1) {
+		/* Initially, each block is a run.
+		This tells row_merge_parallel() where each run starts. */
+		for (ulint i = 0; i < num_runs; i++) {
+			run_offset[i] = i;
+		}
+	} else {
+		/* This tells row_merge() where to start for the first round
+		of merge. */
+		run_offset[half] = half;
+	}
 
 	/* The file should always contain at least one byte (the end
 	of file marker).  Thus, it must be at least one block. */
@@ -3564,9 +3862,16 @@ row_merge_sort(
 		}
 #endif /* __sun__ */
 
-		error = row_merge(trx, dup, file, block, tmpfd,
-				  &num_runs, run_offset, stage,
-				  crypt_block, space);
+		error = n_threads > 1
+			? row_merge_parallel(trx, dup, file, n_threads,
+					     blocks.data(), tmpfd,
+					     &num_runs, run_offset, stage,
+					     crypt_block
+					     ? crypt_blocks.data() : NULL,
+					     space)
+			: row_merge(trx, dup, file, block, tmpfd,
+				    &num_runs, run_offset, stage,
+				    crypt_block, space);
 
 		if(update_progress) {
 			merge_count++;
@@ -3587,6 +3892,14 @@ row_merge_sort(
 
 	ut_free(run_offset);
 
+	for (ulint i = 1; i < blocks.size(); i++) {
+		alloc.deallocate_large(blocks[i], &pfx[2 * i]);
+		if (crypt_blocks[i]) {
+			alloc.deallocate_large(crypt_blocks[i],
+					       &pfx[2 * i + 1]);
+		}
+	}
+
 	/* Progress report only for "normal" indexes. */
 #ifndef __sun__
 	if (dup && !(dup->index->type & DICT_FTS)) {
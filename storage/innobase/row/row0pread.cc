@@ -0,0 +1,381 @@
+/*****************************************************************************
+
+Copyright (c) 2023, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file row/row0pread.cc
+Parallel scan of an index in key ranges
+*******************************************************/
+
+#include "row0pread.h"
+#include "btr0btr.h"
+#include "btr0pcur.h"
+#include "dict0dict.h"
+#include "rem0cmp.h"
+#include "row0mysql.h"
+#include "row0row.h"
+#include "row0vers.h"
+#include "trx0trx.h"
+#include "srv0srv.h"
+#include <thread>
+
+/** Split an index into key ranges at the node pointer records of
+the highest B-tree level that contains enough of them.
+@param index     B-tree index
+@param n_ranges  desired number of ranges
+@param heap      memory heap for the range boundaries
+@param ranges    the ranges, in ascending order of keys
+@return error code */
+dberr_t row_pread_split(dict_index_t *index, ulint n_ranges, mem_heap_t *heap,
+                        row_pread_ranges_t &ranges)
+{
+  ut_ad(index->is_btree());
+  ut_ad(n_ranges);
+
+  ranges.clear();
+
+  const ulint n_fields= dict_index_get_n_unique_in_tree_nonleaf(index);
+  std::vector<const dtuple_t*> bounds;
+  std::vector<uint32_t> pages{index->page}, children;
+  mem_heap_t *offsets_heap= nullptr;
+  rec_offs offsets_[REC_OFFS_NORMAL_SIZE];
+  rec_offs *offsets= offsets_;
+  rec_offs_init(offsets_);
+  dberr_t err= DB_SUCCESS;
+
+  mtr_t mtr;
+  mtr.start();
+  /* Block page splits and merges while we are looking at the
+  node pointers. The key ranges remain valid after that, even if
+  the tree is reorganized. */
+  mtr_sx_lock_index(index, &mtr);
+
+  for (ulint level= ULINT_UNDEFINED; n_ranges > 1; level--)
+  {
+    bounds.clear();
+    children.clear();
+
+    for (const uint32_t page : pages)
+    {
+      const buf_block_t *block=
+        btr_block_get(*index, page, RW_S_LATCH, false, &mtr, &err);
+      if (!block)
+        goto func_exit;
+
+      const page_t *frame= block->page.frame;
+      const uint16_t l= btr_page_get_level(frame);
+
+      if (level == ULINT_UNDEFINED)
+        level= l;
+      else if (UNIV_UNLIKELY(l != level))
+      {
+        err= DB_CORRUPTION;
+        goto func_exit;
+      }
+
+      if (!level)
+        /* The root page is the only leaf page. */
+        goto func_exit;
+
+      for (const rec_t *rec=
+             page_rec_get_next_const(page_get_infimum_rec(frame));;
+           rec= page_rec_get_next_const(rec))
+      {
+        if (UNIV_UNLIKELY(!rec))
+        {
+          err= DB_CORRUPTION;
+          goto func_exit;
+        }
+        if (page_rec_is_supremum(rec))
+          break;
+
+        offsets= rec_get_offsets(rec, index, offsets, 0, ULINT_UNDEFINED,
+                                 &offsets_heap);
+        children.push_back(btr_node_ptr_get_child_page_no(rec, offsets));
+
+        if (rec_get_info_bits(rec, page_is_comp(frame)) &
+            REC_INFO_MIN_REC_FLAG)
+          continue;
+
+        dtuple_t *tuple= dtuple_create(heap, n_fields);
+        dict_index_copy_types(tuple, index, n_fields);
+        rec_copy_prefix_to_dtuple(tuple, rec, index, 0, n_fields, heap);
+        bounds.push_back(tuple);
+      }
+    }
+
+    if (level == 1 || bounds.size() >= n_ranges - 1)
+      break;
+
+    /* Too few node pointers on this level. Because this level had
+    fewer than n_ranges records, the next one has fewer than n_ranges
+    pages, and reading all of them is cheap. */
+    pages.swap(children);
+  }
+
+func_exit:
+  mtr.commit();
+
+  if (UNIV_LIKELY_NULL(offsets_heap))
+    mem_heap_free(offsets_heap);
+
+  if (err != DB_SUCCESS)
+    return err;
+
+  /* Pick at most n_ranges - 1 evenly spaced boundaries. */
+  const ulint n_bounds= std::min<ulint>(bounds.size(), n_ranges - 1);
+  const dtuple_t *start= nullptr;
+
+  for (ulint i= 1; i <= n_bounds; i++)
+  {
+    const dtuple_t *end= bounds[i * bounds.size() / (n_bounds + 1)];
+    ranges.push_back({start, end});
+    start= end;
+  }
+
+  ranges.push_back({start, nullptr});
+  return DB_SUCCESS;
+}
+
+namespace
+{
+/** Number of srv_thread_pool tasks of row_count_parallel() that are
+running or queued, in all sessions */
+Atomic_relaxed<ulint> row_pread_tasks;
+
+/** Reserve srv_thread_pool tasks for row_count_parallel(). The tasks of
+all sessions together are limited to the number of CPUs, so that a
+session cannot flood srv_thread_pool whatever innodb_parallel_read_threads
+is set to.
+@param n  desired number of tasks
+@return number of reserved tasks, possibly 0 */
+ulint row_pread_tasks_reserve(ulint n)
+{
+  const ulint max_tasks= std::max(1U, std::thread::hardware_concurrency());
+  ulint reserved= row_pread_tasks;
+  for (;;)
+  {
+    if (reserved >= max_tasks)
+      return 0;
+    const ulint r= std::min(n, max_tasks - reserved);
+    if (row_pread_tasks.compare_exchange_strong(reserved, reserved + r))
+      return r;
+  }
+}
+
+/** State shared by the threads of row_count_parallel() */
+struct row_count_t
+{
+  /** table handle */
+  row_prebuilt_t *const prebuilt;
+  /** the ranges to scan */
+  const row_pread_ranges_t &ranges;
+  /** whether row versions need to be checked against the read view */
+  const bool consistent;
+  /** index of the next range in ranges */
+  Atomic_relaxed<size_t> next{0};
+  /** number of records counted so far */
+  Atomic_relaxed<ulint> n_rows{0};
+  /** the first error that was encountered */
+  Atomic_relaxed<dberr_t> err{DB_SUCCESS};
+
+  row_count_t(row_prebuilt_t *prebuilt, const row_pread_ranges_t &ranges) :
+    prebuilt(prebuilt), ranges(ranges),
+    consistent(!prebuilt->table->is_temporary() &&
+               prebuilt->trx->isolation_level != TRX_ISO_READ_UNCOMMITTED)
+  {}
+
+  /** Scan ranges until all have been processed or an error occurs */
+  void run()
+  {
+    while (err == DB_SUCCESS)
+    {
+      const size_t i= next.fetch_add(1);
+      if (i >= ranges.size())
+        break;
+      ulint n= 0;
+      if (dberr_t e= scan(ranges[i], n))
+      {
+        dberr_t expected= DB_SUCCESS;
+        err.compare_exchange_strong(expected, e);
+        break;
+      }
+      n_rows.fetch_add(n);
+    }
+  }
+
+  /** Task callback for srv_thread_pool */
+  static void run(void *arg) { static_cast<row_count_t*>(arg)->run(); }
+
+private:
+  /** Count the visible records in a range.
+  @param range  key range
+  @param n      number of visible records
+  @return error code */
+  dberr_t scan(const row_pread_range_t &range, ulint &n);
+};
+
+dberr_t row_count_t::scan(const row_pread_range_t &range, ulint &n)
+{
+  dict_index_t *const index= dict_table_get_first_index(prebuilt->table);
+  ReadView &view= prebuilt->trx->read_view;
+  const bool comp= index->table->not_redundant();
+  mem_heap_t *heap= nullptr;
+  mem_heap_t *vers_heap= nullptr;
+  rec_offs offsets_[REC_OFFS_NORMAL_SIZE];
+  rec_offs *offsets= offsets_;
+  rec_offs_init(offsets_);
+
+  btr_pcur_t pcur;
+  pcur.btr_cur.page_cur.index= index;
+  mtr_t mtr;
+  mtr.start();
+
+  dberr_t err= range.start
+    ? btr_pcur_open_with_no_init(range.start, PAGE_CUR_GE, BTR_SEARCH_LEAF,
+                                 &pcur, &mtr)
+    : pcur.open_leaf(true, index, BTR_SEARCH_LEAF, &mtr);
+
+  while (err == DB_SUCCESS)
+  {
+    const rec_t *rec= btr_pcur_get_rec(&pcur);
+
+    if (page_rec_is_supremum(rec))
+    {
+      if (btr_pcur_is_after_last_in_tree(&pcur))
+        break;
+      if (this->err != DB_SUCCESS)
+        break;
+      if (trx_is_interrupted(prebuilt->trx))
+      {
+        err= DB_INTERRUPTED;
+        break;
+      }
+      err= btr_pcur_move_to_next_page(&pcur, &mtr);
+      if (vers_heap)
+        mem_heap_empty(vers_heap);
+      continue;
+    }
+
+    if (page_rec_is_infimum(rec))
+      goto next_rec;
+
+    offsets= rec_get_offsets(rec, index, offsets, index->n_core_fields,
+                             ULINT_UNDEFINED, &heap);
+
+    if (range.end && cmp_dtuple_rec(range.end, rec, index, offsets) <= 0)
+      break;
+
+    if (rec_get_info_bits(rec, comp) & REC_INFO_MIN_REC_FLAG)
+      /* Skip the metadata record of instant ALTER TABLE. */
+      goto next_rec;
+
+    if (consistent &&
+        !view.changes_visible(row_get_rec_trx_id(rec, index, offsets)))
+    {
+      if (!vers_heap)
+        vers_heap= mem_heap_create(srv_page_size);
+      rec_t *old_vers;
+      err= row_vers_build_for_consistent_read(rec, &mtr, index, &offsets,
+                                              &view,
+                                              &heap, vers_heap, &old_vers,
+                                              nullptr);
+      if (err != DB_SUCCESS)
+        break;
+      if (!old_vers)
+        goto next_rec;
+      rec= old_vers;
+    }
+
+    n+= !rec_get_deleted_flag(rec, comp);
+
+next_rec:
+    if (UNIV_UNLIKELY(!btr_pcur_move_to_next_on_page(&pcur)))
+      err= DB_CORRUPTION;
+  }
+
+  mtr.commit();
+  btr_pcur_close(&pcur);
+
+  if (vers_heap)
+    mem_heap_free(vers_heap);
+  if (UNIV_LIKELY_NULL(heap))
+    mem_heap_free(heap);
+
+  return err;
+}
+}
+
+/** Count the records of the clustered index that are visible in the
+read view of the transaction.
+@param prebuilt   table handle
+@param n_threads  maximum number of concurrently scanning threads
+@param n_rows     number of visible records
+@return error code */
+dberr_t row_count_parallel(row_prebuilt_t *prebuilt, ulint n_threads,
+                           ulint *n_rows)
+{
+  dict_index_t *index= dict_table_get_first_index(prebuilt->table);
+  ut_ad(n_threads);
+  ut_ad(prebuilt->table->is_temporary() ||
+        prebuilt->trx->isolation_level == TRX_ISO_READ_UNCOMMITTED ||
+        prebuilt->trx->read_view.is_open());
+
+  *n_rows= 0;
+
+  if (const trx_id_t bulk_trx_id= prebuilt->table->bulk_trx_id)
+    if (!prebuilt->trx->read_view.changes_visible(bulk_trx_id))
+      return DB_SUCCESS;
+
+  mem_heap_t *heap= mem_heap_create(1024);
+  row_pread_ranges_t ranges;
+
+  /* Create a few ranges per thread, so that the work is balanced
+  even if the records are not evenly distributed. */
+  dberr_t err= row_pread_split(index, n_threads * 4, heap, ranges);
+
+  if (err == DB_SUCCESS)
+  {
+    row_count_t ctx(prebuilt, ranges);
+    std::vector<tpool::waitable_task*> tasks;
+
+    for (ulint i= row_pread_tasks_reserve(std::min<ulint>(n_threads,
+                                                          ranges.size()) - 1);
+         i--; )
+    {
+      auto task= new tpool::waitable_task(row_count_t::run, &ctx);
+      tasks.push_back(task);
+      srv_thread_pool->submit_task(task);
+    }
+
+    ctx.run();
+
+    for (auto task : tasks)
+    {
+      task->wait();
+      delete task;
+    }
+
+    row_pread_tasks.fetch_sub(tasks.size());
+
+    err= ctx.err;
+    *n_rows= ctx.n_rows;
+  }
+
+  mem_heap_free(heap);
+  return err;
+}
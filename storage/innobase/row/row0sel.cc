@@ -3862,23 +3862,58 @@ row_sel_dequeue_cached_row_for_mysql(
 	}
 }
 
+/** Free the prefetch cache.
+@param prebuilt  prebuilt struct */
+void row_sel_prefetch_cache_free(row_prebuilt_t *prebuilt)
+{
+	if (!prebuilt->fetch_cache) {
+		return;
+	}
+
+	const byte* ptr = reinterpret_cast<const byte*>(
+		prebuilt->fetch_cache + prebuilt->fetch_cache_alloc);
+
+	for (ulint i = 0; i < prebuilt->fetch_cache_alloc; i++) {
+		ulint	magic1 = mach_read_from_4(ptr);
+		ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+
+		ut_a(ptr == prebuilt->fetch_cache[i]);
+		ptr += prebuilt->mysql_row_len;
+
+		ulint	magic2 = mach_read_from_4(ptr);
+		ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+	}
+
+	ut_free(prebuilt->fetch_cache);
+	prebuilt->fetch_cache = NULL;
+	prebuilt->fetch_cache_alloc = 0;
+}
+
 /********************************************************************//**
 Initialise the prefetch cache. */
 UNIV_INLINE
 void
 row_sel_prefetch_cache_init(
 /*========================*/
-	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
+	row_prebuilt_t*	prebuilt,	/*!< in/out: prebuilt struct */
+	ulint		n)		/*!< in: number of rows */
 {
 	ulint	i;
 	ulint	sz;
 	byte*	ptr;
 
-	/* Reserve space for the magic number. */
-	sz = UT_ARR_SIZE(prebuilt->fetch_cache) * (prebuilt->mysql_row_len + 8);
-	ptr = static_cast<byte*>(ut_malloc_nokey(sz));
+	row_sel_prefetch_cache_free(prebuilt);
+
+	/* Reserve space for the row pointers and the magic numbers. */
+	sz = n * (sizeof *prebuilt->fetch_cache
+		  + prebuilt->mysql_row_len + 8);
+	prebuilt->fetch_cache = static_cast<byte**>(ut_malloc_nokey(sz));
+	prebuilt->fetch_cache_alloc = n;
+	ptr = reinterpret_cast<byte*>(prebuilt->fetch_cache + n);
 
-	for (i = 0; i < UT_ARR_SIZE(prebuilt->fetch_cache); i++) {
+	for (i = 0; i < n; i++) {
 
 		/* A user has reported memory corruption in these
 		buffers in Linux. Put magic numbers there to help
@@ -3905,13 +3940,35 @@ row_sel_fetch_last_buf(
 	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
 {
 	ut_ad(!prebuilt->templ_contains_blob);
-	ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+	ut_ad(prebuilt->n_fetch_cached < prebuilt->fetch_cache_size);
 
-	if (prebuilt->fetch_cache[0] == NULL) {
-		/* Allocate memory for the fetch cache */
-		ut_ad(prebuilt->n_fetch_cached == 0);
-
-		row_sel_prefetch_cache_init(prebuilt);
+	if (prebuilt->n_fetch_cached == 0) {
+		/* A new batch is starting. If the rows of the previous
+		batches were all fetched, the scan is likely to continue:
+		let the batches grow with the scan. */
+		if (prebuilt->n_rows_fetched >= prebuilt->fetch_cache_size) {
+			prebuilt->fetch_cache_size = std::min(
+				2 * prebuilt->fetch_cache_size,
+				std::max<ulint>(
+					MYSQL_FETCH_CACHE_SIZE,
+					std::min<ulint>(
+						MYSQL_FETCH_CACHE_MAX_SIZE,
+						MYSQL_FETCH_CACHE_MAX_BYTES
+						/ (prebuilt->mysql_row_len
+						   + 8))));
+		}
+
+		if (prebuilt->fetch_cache_alloc
+		    < prebuilt->fetch_cache_size) {
+			/* Allocate memory for the fetch cache */
+			ut_d(if (prebuilt->fetch_cache_alloc) {
+				srv_stats.n_prefetch_grown.inc();
+			});
+			row_sel_prefetch_cache_init(
+				prebuilt, prebuilt->fetch_cache_size);
+		}
+
+		srv_stats.n_prefetch_batches.inc();
 	}
 
 	ut_ad(prebuilt->fetch_cache_first == 0);
@@ -4423,6 +4480,7 @@ row_search_mvcc(
 		prebuilt->n_rows_fetched = 0;
 		prebuilt->n_fetch_cached = 0;
 		prebuilt->fetch_cache_first = 0;
+		prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 		if (prebuilt->sel_graph == NULL) {
 			/* Build a dummy select query graph */
@@ -4447,17 +4505,20 @@ row_search_mvcc(
 			prebuilt->n_rows_fetched = 0;
 			prebuilt->n_fetch_cached = 0;
 			prebuilt->fetch_cache_first = 0;
+			prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 		} else if (UNIV_LIKELY(prebuilt->n_fetch_cached > 0)) {
 			row_sel_dequeue_cached_row_for_mysql(buf, prebuilt);
 
 			prebuilt->n_rows_fetched++;
+			srv_stats.n_prefetch_rows.inc();
 			trx->op_info = "";
 			DBUG_RETURN(DB_SUCCESS);
 		}
 
 		if (prebuilt->fetch_cache_first > 0
-		    && prebuilt->fetch_cache_first < MYSQL_FETCH_CACHE_SIZE) {
+		    && prebuilt->fetch_cache_first
+		    < prebuilt->fetch_cache_size) {
 early_not_found:
 			/* The previous returned row was popped from the fetch
 			cache, but the cache was not full at the time of the
@@ -5626,7 +5687,7 @@ row_search_mvcc(
 		not cache rows because there the cursor is a scrollable
 		cursor. */
 
-		ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+		ut_a(prebuilt->n_fetch_cached < prebuilt->fetch_cache_size);
 
 		/* We only convert from InnoDB row format to MySQL row
 		format when ICP is disabled. */
@@ -5678,7 +5739,7 @@ row_search_mvcc(
 			row_sel_enqueue_cache_row_for_mysql(buf, prebuilt);
 		}
 
-		if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+		if (prebuilt->n_fetch_cached < prebuilt->fetch_cache_size) {
 			goto next_rec;
 		}
 	} else {
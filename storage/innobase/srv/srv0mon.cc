@@ -217,6 +217,24 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_BUF_POOL_READ_AHEAD_EVICTED},
 
+	{"buffer_pool_read_ahead_leaf", "buffer",
+	 "Number of pages read ahead of scans of index leaf pages",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_BUF_POOL_READ_AHEAD_LEAF},
+
+	{"buffer_pool_read_ahead_leaf_hits", "buffer",
+	 "Leaf pages read ahead that the scan reached",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_BUF_POOL_READ_AHEAD_LEAF_HITS},
+
+	{"buffer_pool_read_ahead_leaf_wasted", "buffer",
+	 "Leaf pages read ahead that the scan did not reach",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_BUF_POOL_READ_AHEAD_LEAF_WASTED},
+
 	{"buffer_pool_pages_total", "buffer",
 	 "Total buffer pool size in pages (innodb_buffer_pool_pages_total)",
 	 static_cast<monitor_type_t>(
@@ -1409,6 +1427,18 @@ srv_mon_process_existing_counter(
 		value = buf_pool.stat.n_ra_pages_evicted;
 		break;
 
+	case MONITOR_OVLD_BUF_POOL_READ_AHEAD_LEAF:
+		value = buf_pool.stat.n_ra_pages_read_leaf;
+		break;
+
+	case MONITOR_OVLD_BUF_POOL_READ_AHEAD_LEAF_HITS:
+		value = buf_pool.stat.n_ra_leaf_hits;
+		break;
+
+	case MONITOR_OVLD_BUF_POOL_READ_AHEAD_LEAF_WASTED:
+		value = buf_pool.stat.n_ra_leaf_wasted;
+		break;
+
 	/* innodb_buffer_pool_pages_total */
 	case MONITOR_OVLD_BUF_POOL_PAGE_TOTAL:
 		value = buf_pool.get_n_pages();
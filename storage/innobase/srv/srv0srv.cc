@@ -44,6 +44,7 @@ Created 10/8/1995 Heikki Tuuri
 #include "mysql/psi/psi.h"
 
 #include "btr0sea.h"
+#include "buf0dump.h"
 #include "buf0flu.h"
 #include "buf0lru.h"
 #include "dict0boot.h"
@@ -123,6 +124,8 @@ unsigned long long	srv_max_undo_log_size;
 recovery and open all tables in RO mode instead of RW mode. We don't
 sync the max trx id to disk either. */
 my_bool	srv_read_only_mode;
+/** innodb_read_view_active_array */
+my_bool	srv_read_view_active_array;
 /** store to its own file each table created by an user; data
 dictionary tables are in the system tablespace 0 */
 my_bool	srv_file_per_table;
@@ -197,6 +200,12 @@ ulint	srv_buf_pool_base_size;
 ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 ulong	srv_buf_pool_dump_pct;
+/** Interval between periodic buffer pool dumps in seconds, or 0 */
+ulong	srv_buf_pool_dump_interval;
+/** innodb_buffer_pool_dump_format */
+ulong	srv_buf_pool_dump_format;
+/** Number of threads that submit the reads of a buffer pool load */
+uint	srv_buf_pool_load_threads;
 /** Abort load after this amount of pages */
 #ifdef UNIV_DEBUG
 ulong srv_buf_pool_load_pages_abort = LONG_MAX;
@@ -218,6 +227,10 @@ my_bool	srv_random_read_ahead;
 in the buffer cache and accessed sequentially for InnoDB to trigger a
 readahead request. */
 ulong	srv_read_ahead_threshold;
+/** innodb_read_ahead_leaf_pages; the maximum number of pages that
+buf_read_ahead_leaf() may read ahead of a scan of index leaf pages,
+or 0 to disable it */
+ulong	srv_read_ahead_leaf_pages;
 
 /** innodb_change_buffer_max_size; maximum on-disk size of change
 buffer in terms of percentage of the buffer pool. */
@@ -311,6 +324,13 @@ my_bool		srv_stats_include_delete_marked;
 unsigned long long	srv_stats_persistent_sample_pages;
 /** innodb_stats_auto_recalc */
 my_bool		srv_stats_auto_recalc;
+/** innodb_stats_analyze_threads; number of threads that analyze
+the indexes of a table in parallel */
+uint		srv_stats_analyze_threads;
+/** innodb_stats_random_dive_confidence; confidence level in percent
+of persistent statistics that are sampled by random leaf page dives,
+or 0 to sample the configured number of pages on a suitable level */
+uint		srv_stats_random_dive_confidence;
 
 /** innodb_stats_modified_counter; The number of rows modified before
 we calculate new statistics (default 0 = current limits) */
@@ -321,6 +341,9 @@ based on number of configured pages */
 my_bool	srv_stats_sample_traditional;
 
 my_bool	srv_use_doublewrite_buf;
+/** innodb_doublewrite_compact: whether to write only the payload of
+each page to the doublewrite buffer, with one checksum per batch */
+my_bool	srv_doublewrite_compact;
 
 /** innodb_sync_spin_loops */
 ulong	srv_n_spin_wait_rounds;
@@ -501,6 +524,9 @@ struct purge_coordinator_state
 {
   /** Snapshot of the last history length before the purge call.*/
   size_t m_history_length;
+  /** Number of successive purge batches after which the history
+  length had grown */
+  ulint m_history_growth;
   Atomic_counter<int> m_running;
 private:
   ulint count;
@@ -514,6 +540,9 @@ struct purge_coordinator_state
 
   static constexpr ulint adaptive_purge_threshold= 20;
   static constexpr ulint safety_net= 20;
+  /** Number of successive purge batches with a growing history
+  after which another purge task will be used */
+  static constexpr ulint history_growth_threshold= 3;
   ulint series[innodb_purge_threads_MAX + 1];
 
   inline void compute_series();
@@ -522,6 +551,8 @@ struct purge_coordinator_state
 
 public:
   inline void do_purge();
+  /** @return the number of purge tasks that are being used */
+  ulint threads_used() const { return n_use_threads; }
 };
 
 static purge_coordinator_state purge_state;
@@ -923,6 +954,15 @@ srv_printf_innodb_monitor(
 		static_cast<double>(srv_stats.n_system_rows_read
 				    - srv_n_system_rows_read_old)
 		/ time_elapsed);
+	if (const ulint n_batches = srv_stats.n_prefetch_batches) {
+		const ulint n_rows = srv_stats.n_prefetch_rows;
+		fprintf(file,
+			"Prefetch cache: " ULINTPF " batches, "
+			ULINTPF " rows, %.2f rows/batch\n",
+			n_batches, n_rows,
+			static_cast<double>(n_rows)
+			/ static_cast<double>(n_batches));
+	}
 	srv_n_rows_inserted_old = srv_stats.n_rows_inserted;
 	srv_n_rows_updated_old = srv_stats.n_rows_updated;
 	srv_n_rows_deleted_old = srv_stats.n_rows_deleted;
@@ -992,6 +1032,7 @@ srv_export_innodb_status(void)
 	ulint dblwr = buf_dblwr.submitted();
 	export_vars.innodb_dblwr_pages_written = buf_dblwr.written();
 	export_vars.innodb_dblwr_writes = buf_dblwr.batches();
+	export_vars.innodb_dblwr_compact_writes = buf_dblwr.compact_batches();
 	buf_dblwr.unlock();
 
 	export_vars.innodb_data_written = srv_stats.data_written + dblwr;
@@ -1004,6 +1045,8 @@ srv_export_innodb_status(void)
 #ifdef UNIV_DEBUG
 	export_vars.innodb_buffer_pool_pages_latched =
 		buf_get_latched_pages_number();
+	export_vars.innodb_prefetch_cache_grown = srv_stats.n_prefetch_grown;
+	export_vars.innodb_prefetch_cache_shrunk = srv_stats.n_prefetch_shrunk;
 #endif /* UNIV_DEBUG */
 	export_vars.innodb_buffer_pool_pages_total = buf_pool.get_n_pages();
 
@@ -1012,8 +1055,21 @@ srv_export_innodb_status(void)
 		- UT_LIST_GET_LEN(buf_pool.LRU)
 		- UT_LIST_GET_LEN(buf_pool.free);
 
+	buf_LRU_policy_stat_t	lru_stat[BUF_LRU_ADAPTIVE + 1];
+	buf_LRU_policy_stat(lru_stat);
+	export_vars.innodb_buffer_pool_midpoint_read_requests =
+		lru_stat[BUF_LRU_MIDPOINT].n_page_gets;
+	export_vars.innodb_buffer_pool_midpoint_reads =
+		lru_stat[BUF_LRU_MIDPOINT].n_pages_read;
+	export_vars.innodb_buffer_pool_adaptive_read_requests =
+		lru_stat[BUF_LRU_ADAPTIVE].n_page_gets;
+	export_vars.innodb_buffer_pool_adaptive_reads =
+		lru_stat[BUF_LRU_ADAPTIVE].n_pages_read;
+
 	export_vars.innodb_max_trx_id = trx_sys.get_max_trx_id();
 	export_vars.innodb_history_list_length = trx_sys.history_size_approx();
+	export_vars.innodb_purge_lag_seconds = purge_sys.lag();
+	export_vars.innodb_purge_threads_used = purge_state.threads_used();
 
 	mysql_mutex_lock(&lock_sys.wait_mutex);
 	export_vars.innodb_row_lock_waits = lock_sys.get_wait_cumulative();
@@ -1509,6 +1565,8 @@ void srv_master_callback(void*)
   else
     srv_master_do_idle_tasks(counter_time);
 
+  buf_dump_periodic();
+
   srv_main_thread_op_info= "sleeping";
 }
 
@@ -1646,12 +1704,31 @@ inline void purge_coordinator_state::do_purge()
         wakeup= true;
         break;
       }
+      else if (n_use_threads < n_threads &&
+               ++m_history_growth >= history_growth_threshold &&
+               lsn_age_factor < 100 - safety_net)
+      {
+        /* The purge is falling behind, even though the redo log
+        would allow more purge tasks to run. Unlike at more_threads,
+        lsn_age_factor may be at or above lsn_lwm here. Keep lsn_hwm
+        above it, so that the next round will not remove the task. */
+        m_history_growth= 0;
+        ++n_use_threads;
+        lsn_lwm-= series[n_use_threads];
+        if (lsn_hwm <= lsn_age_factor)
+          lsn_hwm= lsn_age_factor + 1;
+      }
+    }
+    else
+    {
+      m_history_growth= 0;
+      if (n_threads > n_use_threads &&
+          srv_max_purge_lag && m_history_length > srv_max_purge_lag)
+        goto more_threads;
+      else if (n_use_threads > 1 &&
+               old_activity_count == srv_sys.activity_count)
+        goto fewer_threads;
     }
-    else if (n_threads > n_use_threads &&
-             srv_max_purge_lag && m_history_length > srv_max_purge_lag)
-      goto more_threads;
-    else if (n_use_threads > 1 && old_activity_count == srv_sys.activity_count)
-      goto fewer_threads;
 
     ut_ad(n_use_threads);
     ut_ad(n_use_threads <= n_threads);
@@ -1752,6 +1829,7 @@ void purge_coordinator_state::refresh(bool full)
   log_sys.latch.rd_unlock();
 
   lsn_age_factor= ulint(((log_sys.get_lsn() - last) * 100) / max_age);
+  DBUG_EXECUTE_IF("purge_lsn_age_factor_60", lsn_age_factor= 60;);
 }
 
 
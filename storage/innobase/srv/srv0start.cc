@@ -823,7 +823,8 @@ static lsn_t srv_prepare_to_delete_redo_log_file()
 
   {
     const char *msg;
-    if (!latest_format)
+    if (!latest_format ||
+        (~log_t::FORMAT_ENCRYPTED & log_sys.format) == log_t::FORMAT_10_8)
     {
       msg= "Upgrading redo log: ";
 same_size:
@@ -1359,8 +1360,8 @@ dberr_t srv_start(bool create_new_db)
 		} else if (log_sys.file_size == srv_log_file_size
 			   && log_sys.format
 			   == (srv_encrypt_log
-			       ? log_t::FORMAT_ENC_10_8
-			       : log_t::FORMAT_10_8)) {
+			       ? log_t::FORMAT_ENC_10_9
+			       : log_t::FORMAT_10_9)) {
 			/* No need to add or remove encryption,
 			upgrade, or resize. */
 			delete_log_files();
@@ -1532,6 +1533,9 @@ dberr_t srv_start(bool create_new_db)
 #ifndef DBUG_OFF
 skip_monitors:
 #endif
+		/* Create the background deadlock detector task */
+		lock_deadlock_detect_start();
+
 		ut_ad(srv_force_recovery >= SRV_FORCE_NO_UNDO_LOG_SCAN
 		      || !purge_sys.enabled());
 
@@ -40,8 +40,6 @@ Created 3/26/1996 Heikki Tuuri
 #include "trx0trx.h"
 #include <mysql/service_wsrep.h>
 
-#include <unordered_map>
-
 /** Maximum allowable purge history length.  <=0 means 'infinite'. */
 ulong		srv_max_purge_lag = 0;
 
@@ -185,6 +183,9 @@ void purge_sys_t::create()
   truncate.current= NULL;
   truncate.last= NULL;
   heap= mem_heap_create(4096);
+  n_lag_samples= 0;
+  lag_interval= 1;
+  lag_since= 0;
 }
 
 /** Close the purge subsystem on shutdown. */
@@ -580,6 +581,137 @@ static void trx_purge_cleanse_purge_queue(const fil_space_t& space)
 	mysql_mutex_unlock(&purge_sys.pq_mutex);
 }
 
+/** Lock the modified pages of an undo tablespace that is being shrunk.
+
+During truncation, we do not want any writes to the file.
+
+If a log checkpoint was completed at LSN earlier than our
+mini-transaction commit and the server was killed, then
+discarding the to-be-trimmed pages without flushing would
+break crash recovery.
+@param space  undo tablespace
+@param first  the first page number to be discarded
+@param mtr    mini-transaction */
+static void trx_purge_latch_modified_pages(const fil_space_t &space,
+                                           uint32_t first, mtr_t &mtr)
+{
+  mysql_mutex_lock(&buf_pool.flush_list_mutex);
+
+  for (buf_page_t *bpage= UT_LIST_GET_LAST(buf_pool.flush_list); bpage; )
+  {
+    ut_ad(bpage->oldest_modification());
+    ut_ad(bpage->in_file());
+
+    buf_page_t *prev= UT_LIST_GET_PREV(list, bpage);
+
+    if (bpage->id().space() == space.id &&
+        bpage->id().page_no() >= first &&
+        bpage->oldest_modification() != 1)
+    {
+      ut_ad(bpage->frame);
+      auto block= reinterpret_cast<buf_block_t*>(bpage);
+      if (!bpage->lock.x_lock_try())
+      {
+      rescan:
+        /* Let buf_pool_t::release_freed_page() proceed. */
+        mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+        mysql_mutex_lock(&buf_pool.mutex);
+        mysql_mutex_lock(&buf_pool.flush_list_mutex);
+        mysql_mutex_unlock(&buf_pool.mutex);
+        bpage= UT_LIST_GET_LAST(buf_pool.flush_list);
+        continue;
+      }
+      buf_pool.flush_hp.set(prev);
+      mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+
+#ifdef BTR_CUR_HASH_ADAPT
+      ut_ad(!block->index); /* There is no AHI on undo tablespaces. */
+#endif
+      bpage->fix();
+      ut_ad(!bpage->is_io_fixed());
+      mysql_mutex_lock(&buf_pool.flush_list_mutex);
+
+      if (bpage->oldest_modification() > 1)
+      {
+        bpage->reset_oldest_modification();
+        mtr.memo_push(block, MTR_MEMO_PAGE_X_FIX);
+      }
+      else
+      {
+        bpage->unfix();
+        bpage->lock.x_unlock();
+      }
+
+      if (prev != buf_pool.flush_hp.get())
+        /* Rescan, because we may have lost the position. */
+        goto rescan;
+    }
+
+    bpage= prev;
+  }
+
+  mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+}
+
+/** Discard the free extents at the end of an undo tablespace
+while its rollback segments may remain in use.
+@param space  undo tablespace */
+static void trx_purge_shrink_undo_space(fil_space_t &space)
+{
+  /* The key rotation threads could be accessing the pages
+  that would be discarded. */
+  if (space.crypt_data && srv_n_fil_crypt_threads_started)
+    return;
+
+  /* Undo tablespace always are a single file. */
+  fil_node_t *file= UT_LIST_GET_FIRST(space.chain);
+  /* The undo tablespace files are never closed. */
+  ut_ad(file->is_open());
+
+  log_free_check();
+
+  mtr_t mtr;
+  mtr.start();
+  mtr.x_lock_space(&space);
+
+  /* Never shrink below the size of a newly created undo tablespace. */
+  dberr_t err= DB_SUCCESS;
+  const uint32_t size=
+    fsp_shrink_undo_tablespace(&space, SRV_UNDO_TABLESPACE_SIZE_IN_PAGES,
+                               &mtr, &err);
+  if (!size)
+  {
+    mtr.commit();
+    if (err != DB_SUCCESS)
+      ib::error() << "Failed to shrink " << file->name << ": " << err;
+    return;
+  }
+
+  trx_purge_latch_modified_pages(space, size, mtr);
+
+  mtr.set_named_space(&space);
+  mtr.shrink_pages(page_id_t(space.id, size));
+  mysql_mutex_lock(&fil_system.mutex);
+  space.size= file->size= size;
+  mysql_mutex_unlock(&fil_system.mutex);
+  mtr.commit_shrink(space);
+
+  DBUG_LOG("undo", "shrunk " << file->name << " to " << size << " pages");
+}
+
+/** Discard the free extents at the end of the undo tablespaces
+that exceed innodb_max_undo_log_size.
+@param threshold  innodb_max_undo_log_size in pages */
+static void trx_purge_shrink_undo_spaces(ulint threshold)
+{
+  for (uint32_t i= 0; i < srv_undo_tablespaces_active; i++)
+  {
+    fil_space_t *space= fil_space_get(srv_undo_space_id_start + i);
+    if (space && space->get_size() > threshold)
+      trx_purge_shrink_undo_space(*space);
+  }
+}
+
 #if defined __GNUC__ && __GNUC__ == 4 && !defined __clang__
 # if defined __arm__ || defined __aarch64__
 /* Work around an internal compiler error in GCC 4.8.5 */
@@ -614,15 +746,23 @@ TRANSACTIONAL_TARGET static void trx_purge_truncate_history()
       rseg.latch.wr_unlock();
     }
 
-  if (err != DB_SUCCESS || srv_undo_tablespaces_active < 2)
+  if (err != DB_SUCCESS || !srv_undo_log_truncate)
     return;
 
+  const ulint threshold= ulint(srv_max_undo_log_size >> srv_page_size_shift);
+
+  if (srv_undo_tablespaces_active < 2)
+  {
+    /* The tablespace cannot be reinitialized, because there would be
+    no other rollback segments for new transactions. */
+    trx_purge_shrink_undo_spaces(threshold);
+    return;
+  }
+
   while (srv_undo_log_truncate)
   {
     if (!purge_sys.truncate.current)
     {
-      const ulint threshold=
-        ulint(srv_max_undo_log_size >> srv_page_size_shift);
       for (uint32_t i= purge_sys.truncate.last
            ? purge_sys.truncate.last->id - srv_undo_space_id_start : 0,
            j= i;; )
@@ -671,6 +811,19 @@ TRANSACTIONAL_TARGET static void trx_purge_truncate_history()
       {
 not_free:
         rseg.latch.rd_unlock();
+        /* Rather than waiting for the tablespace to become free,
+        reclaim the free extents at the end of the oversized undo
+        tablespaces while their rollback segments remain in use. */
+        trx_purge_shrink_undo_spaces(threshold);
+        if (space.get_size() <= threshold)
+        {
+          /* Return the tablespace to use, and consider the next one. */
+          for (auto &r : trx_sys.rseg_array)
+            if (r.space == &space)
+              r.cancel_skip_allocation();
+          purge_sys.truncate.last= purge_sys.truncate.current;
+          purge_sys.truncate.current= nullptr;
+        }
         return;
       }
 
@@ -703,69 +856,8 @@ TRANSACTIONAL_TARGET static void trx_purge_truncate_history()
     mtr.start();
     mtr.x_lock_space(&space);
 
-    /* Lock all modified pages of the tablespace.
-
-    During truncation, we do not want any writes to the file.
-
-    If a log checkpoint was completed at LSN earlier than our
-    mini-transaction commit and the server was killed, then
-    discarding the to-be-trimmed pages without flushing would
-    break crash recovery. */
-    mysql_mutex_lock(&buf_pool.flush_list_mutex);
-
-    for (buf_page_t *bpage= UT_LIST_GET_LAST(buf_pool.flush_list); bpage; )
-    {
-      ut_ad(bpage->oldest_modification());
-      ut_ad(bpage->in_file());
-
-      buf_page_t *prev= UT_LIST_GET_PREV(list, bpage);
-
-      if (bpage->id().space() == space.id &&
-          bpage->oldest_modification() != 1)
-      {
-        ut_ad(bpage->frame);
-        auto block= reinterpret_cast<buf_block_t*>(bpage);
-        if (!bpage->lock.x_lock_try())
-        {
-        rescan:
-          /* Let buf_pool_t::release_freed_page() proceed. */
-          mysql_mutex_unlock(&buf_pool.flush_list_mutex);
-          mysql_mutex_lock(&buf_pool.mutex);
-          mysql_mutex_lock(&buf_pool.flush_list_mutex);
-          mysql_mutex_unlock(&buf_pool.mutex);
-          bpage= UT_LIST_GET_LAST(buf_pool.flush_list);
-          continue;
-        }
-        buf_pool.flush_hp.set(prev);
-        mysql_mutex_unlock(&buf_pool.flush_list_mutex);
-
-#ifdef BTR_CUR_HASH_ADAPT
-        ut_ad(!block->index); /* There is no AHI on undo tablespaces. */
-#endif
-        bpage->fix();
-        ut_ad(!bpage->is_io_fixed());
-        mysql_mutex_lock(&buf_pool.flush_list_mutex);
-
-        if (bpage->oldest_modification() > 1)
-        {
-          bpage->reset_oldest_modification();
-          mtr.memo_push(block, MTR_MEMO_PAGE_X_FIX);
-        }
-        else
-        {
-          bpage->unfix();
-          bpage->lock.x_unlock();
-        }
-
-        if (prev != buf_pool.flush_hp.get())
-          /* Rescan, because we may have lost the position. */
-          goto rescan;
-      }
-
-      bpage= prev;
-    }
-
-    mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+    /* Lock all modified pages of the tablespace. */
+    trx_purge_latch_modified_pages(space, 0, mtr);
 
     /* Re-initialize tablespace, in a single mini-transaction. */
     const ulint size= SRV_UNDO_TABLESPACE_SIZE_IN_PAGES;
@@ -1130,6 +1222,55 @@ trx_purge_fetch_next_rec(
 	return trx_purge_get_next_rec(n_pages_handled, heap);
 }
 
+/** Determine the purge task that an undo log record is assigned to.
+All records that refer to the same clustered index record must be
+processed by the same task, in the undo log order. The row-level records
+are distributed by the table identifier and the first PRIMARY KEY field,
+so that the history of a single table is purged by all tasks.
+@param undo_rec	undo log record
+@param n_tasks	number of purge tasks
+@return purge task number, less than n_tasks */
+static ulint trx_purge_rec_task(const trx_undo_rec_t *undo_rec, ulint n_tasks)
+{
+	ulint		type;
+	ulint		cmpl_info;
+	bool		updated_extern;
+	undo_no_t	undo_no;
+	table_id_t	table_id;
+
+	const byte* ptr = trx_undo_rec_get_pars(
+		undo_rec, &type, &cmpl_info, &updated_extern,
+		&undo_no, &table_id);
+
+	ulint fold = ut_fold_ull(table_id);
+
+	switch (type) {
+	case TRX_UNDO_UPD_DEL_REC:
+	case TRX_UNDO_UPD_EXIST_REC:
+	case TRX_UNDO_DEL_MARK_REC:
+		trx_id_t	trx_id;
+		roll_ptr_t	roll_ptr;
+		byte		info_bits;
+		ptr = trx_undo_update_rec_get_sys_cols(ptr, &trx_id,
+						       &roll_ptr, &info_bits);
+		if (info_bits & REC_INFO_MIN_REC_FLAG) {
+			/* The metadata record of instant ALTER TABLE */
+			break;
+		}
+		/* fall through */
+	case TRX_UNDO_INSERT_REC:
+		const byte*	field;
+		uint32_t	len, orig_len;
+		trx_undo_rec_get_col_val(ptr, &field, &len, &orig_len);
+		if (len < UNIV_EXTERN_STORAGE_FIELD) {
+			fold = ut_fold_ulint_pair(fold,
+						  ut_fold_binary(field, len));
+		}
+	}
+
+	return fold % n_tasks;
+}
+
 /** Run a purge batch.
 @param n_purge_threads	number of purge threads
 @return number of undo log pages handled in the batch */
@@ -1176,19 +1317,20 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 
 	ut_ad(purge_sys.head <= purge_sys.tail);
 
-	i = 0;
+	purge_node_t*	nodes[innodb_purge_threads_MAX];
+
+	for (i = 0; i < n_purge_threads; i++) {
+		ut_a(thr != NULL);
+		nodes[i] = static_cast<purge_node_t*>(thr->child);
+		ut_a(que_node_get_type(nodes[i]) == QUE_NODE_PURGE);
+		thr = UT_LIST_GET_NEXT(thrs, thr);
+	}
 
-	std::unordered_map<table_id_t, purge_node_t*> table_id_map;
 	mem_heap_empty(purge_sys.heap);
 
 	while (UNIV_LIKELY(srv_undo_sources) || !srv_fast_shutdown) {
-		purge_node_t*		node;
 		trx_purge_rec_t		purge_rec;
 
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
 
@@ -1208,25 +1350,11 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 			continue;
 		}
 
-		table_id_t table_id = trx_undo_rec_get_table_id(
-			purge_rec.undo_rec);
-
-		purge_node_t *& table_node = table_id_map[table_id];
-
-		if (table_node) {
-			node = table_node;
-		} else {
-			thr = UT_LIST_GET_NEXT(thrs, thr);
-
-			if (!(++i % n_purge_threads)) {
-				thr = UT_LIST_GET_FIRST(
-					purge_sys.query->thrs);
-			}
-
-			ut_a(thr != NULL);
-			table_node = node;
-		}
-
+		purge_node_t* node = nodes[n_purge_threads == 1
+					   ? 0
+					   : trx_purge_rec_task(
+						   purge_rec.undo_rec,
+						   n_purge_threads)];
 		node->undo_recs.push(purge_rec);
 
 		if (n_pages_handled >= srv_purge_batch_size) {
@@ -1317,6 +1445,37 @@ TRANSACTIONAL_INLINE void purge_sys_t::clone_end_view()
 #endif
 }
 
+void purge_sys_t::update_lag(time_t now)
+{
+  /* This is only invoked by the purge coordinator, which is
+  the only thread that may modify tail and lag_samples. */
+  if (!n_lag_samples ||
+      now - lag_samples[n_lag_samples - 1].time >= time_t(lag_interval))
+  {
+    if (n_lag_samples == array_elements(lag_samples))
+    {
+      /* Thin out the samples, so that they cover a longer period of time */
+      for (unsigned i= 1; i < n_lag_samples / 2; i++)
+        lag_samples[i]= lag_samples[2 * i];
+      n_lag_samples/= 2;
+      lag_interval*= 2;
+    }
+    lag_samples[n_lag_samples++]= {trx_sys.get_max_trx_id(), now};
+  }
+
+  /* Find the latest sample that was taken before the oldest
+  unpurged transaction committed, and discard the older samples. */
+  unsigned i= 0;
+  while (i + 1 < n_lag_samples && lag_samples[i + 1].trx_id <= tail.trx_no)
+    i++;
+  if (i)
+  {
+    n_lag_samples-= i;
+    memmove(lag_samples, lag_samples + i, n_lag_samples * sizeof *lag_samples);
+  }
+  lag_since= lag_samples[0].time;
+}
+
 /**
 Run a purge batch.
 @param n_tasks   number of purge tasks to submit to the queue
@@ -1357,6 +1516,7 @@ TRANSACTIONAL_TARGET ulint trx_purge(ulint n_tasks, bool truncate)
 	trx_purge_wait_for_workers_to_complete();
 
 	purge_sys.clone_end_view();
+	purge_sys.update_lag(time(nullptr));
 
 	if (truncate) {
 		trx_purge_truncate_history();
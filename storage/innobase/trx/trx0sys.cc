@@ -152,6 +152,9 @@ void trx_sys_t::create()
   m_initialised= true;
   trx_list.create();
   rw_trx_hash.init();
+  m_active_array= srv_read_view_active_array;
+  if (m_active_array)
+    active_trx.create();
 }
 
 size_t trx_sys_t::history_size()
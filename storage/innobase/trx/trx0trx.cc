@@ -498,7 +498,39 @@ inline void trx_t::release_locks()
     ut_ad(!lock.n_rec_locks);
     ut_ad(UT_LIST_GET_LEN(lock.trx_locks) == 0);
     ut_ad(ib_vector_is_empty(autoinc_locks));
-    mem_heap_empty(lock.lock_heap);
+    /* If the lock structs did not fit in the first block of lock_heap,
+    replace it with a heap whose first block is large enough (but not
+    allocated from the buffer pool), so that the locks of subsequent
+    similar transactions will be allocated from the retained block.
+
+    Other threads allocate from our lock_heap only while holding
+    trx_t::mutex, in lock_rec_create_low() on behalf of an active
+    transaction or when moving one of our locks; because we are
+    committed and hold no locks, that can no longer happen. Other
+    threads read lock.lock_heap (mem_heap_get_size() in trx_print(),
+    INFORMATION_SCHEMA.INNODB_TRX, or deadlock reporting) while holding
+    exclusive lock_sys.latch, which our shared latch excludes. We
+    acquire both, so that the pointer is never observed while the old
+    heap is being freed. */
+    const ulint size= mem_heap_get_size(lock.lock_heap);
+    const ulint max_size= std::min<ulint>(MEM_BLOCK_STANDARD_SIZE,
+                                          srv_page_size / 2 -
+                                          MEM_BLOCK_HEADER_SIZE -
+                                          UNIV_MEM_ALIGNMENT);
+    if (size > mem_block_get_len(lock.lock_heap) &&
+        mem_block_get_len(lock.lock_heap) < max_size)
+    {
+      mem_heap_t *heap= mem_heap_create_typed(std::min(size, max_size),
+                                              MEM_HEAP_FOR_LOCK_HEAP);
+      lock_sys.rd_lock(SRW_LOCK_CALL);
+      mutex_lock();
+      std::swap(heap, lock.lock_heap);
+      mutex_unlock();
+      lock_sys.rd_unlock();
+      mem_heap_free(heap);
+    }
+    else
+      mem_heap_empty(lock.lock_heap);
   }
 
   lock.table_locks.clear();
@@ -692,7 +724,7 @@ static dberr_t trx_resurrect(trx_undo_t *undo, trx_rseg_t *rseg,
   trx->start_time_micro= start_time_micro;
   trx->dict_operation= undo->dict_operation;
 
-  trx_sys.rw_trx_hash.insert(trx);
+  trx_sys.register_recovered_rw(trx);
   trx_sys.rw_trx_hash.put_pins(trx);
   if (trx_state_eq(trx, TRX_STATE_ACTIVE))
     *rows_to_undo+= trx->undo_no;
@@ -0,0 +1,201 @@
+/* Copyright (c) 2023, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "tap.h"
+#include "my_sys.h"
+#include "lf.h"
+#include "m_ctype.h"
+#include "trx0active.h"
+
+constexpr unsigned N_THREADS= 30;
+constexpr unsigned N_ROUNDS= 10000;
+/** number of threads that take snapshots while others commit */
+constexpr unsigned N_READERS= 4;
+/** number of active transactions in the benchmark */
+constexpr unsigned N_ACTIVE= 2000;
+/** number of snapshots in the benchmark */
+constexpr unsigned N_SNAPSHOTS= 1000;
+
+static trx_active_t active;
+static std::atomic<ib_id_t> next_id{1};
+static std::atomic<bool> failed;
+static std::atomic<bool> committing;
+
+static void test_insert_erase()
+{
+  std::vector<ib_id_t> ids;
+  for (auto i= N_ROUNDS; i--; )
+  {
+    const ib_id_t id= next_id.fetch_add(1);
+    const uint32_t slot= active.insert(id);
+    active.assign_no(slot, id + 1);
+    ids.clear();
+    active.snapshot(ids, IB_ID_MAX);
+    if (slot == trx_active_t::NONE ||
+        std::find(ids.begin(), ids.end(), id) == ids.end())
+      failed= true;
+    active.erase(slot);
+  }
+}
+
+/** Register, assign a serialisation number and deregister transactions,
+like trx_sys_t::register_rw(), assign_new_trx_no() and deregister_rw() */
+static void test_commit()
+{
+  for (auto i= N_ROUNDS; i--; )
+  {
+    const ib_id_t id= next_id.fetch_add(2);
+    const uint32_t slot= active.insert(id);
+    active.assign_no(slot, id + 1);
+    active.erase(slot);
+  }
+}
+
+/** Take snapshots while test_commit() is running, and check that the
+serialisation number of a transaction is never that of another one */
+static void test_snapshot()
+{
+  while (committing)
+    active.for_each([](ib_id_t id, ib_id_t no)
+    {
+      if (no != IB_ID_MAX && no != id + 1)
+        failed= true;
+    });
+}
+
+/** Element of the LF_HASH in the benchmark, like rw_trx_hash_element_t */
+struct element_t
+{
+  ib_id_t id;
+  ib_id_t no;
+};
+
+/** Argument of copy_one_id() */
+struct snapshot_arg
+{
+  std::vector<ib_id_t> ids;
+  ib_id_t limit;
+  ib_id_t no;
+};
+
+/** Collect an identifier like trx_sys_t::copy_one_id() */
+static my_bool copy_one_id(void *el, void *a)
+{
+  const element_t *element= static_cast<const element_t*>(el);
+  snapshot_arg *arg= static_cast<snapshot_arg*>(a);
+  if (element->id < arg->limit)
+  {
+    arg->ids.push_back(element->id);
+    if (element->no < arg->no)
+      arg->no= element->no;
+  }
+  return 0;
+}
+
+/** Compare snapshots of trx_active_t to those of LF_HASH */
+static void benchmark()
+{
+  LF_HASH hash;
+  lf_hash_init(&hash, sizeof(element_t), LF_HASH_UNIQUE, 0,
+               sizeof(ib_id_t), 0, &my_charset_bin);
+  LF_PINS *pins= lf_hash_get_pins(&hash);
+
+  std::vector<uint32_t> slots;
+  for (ib_id_t id= 1; id <= N_ACTIVE; id++)
+  {
+    element_t element{id, IB_ID_MAX};
+    lf_hash_insert(&hash, pins, &element);
+    slots.push_back(active.insert(id));
+  }
+
+  snapshot_arg arg;
+  arg.ids.reserve(N_ACTIVE + 32);
+  ulonglong start= my_interval_timer();
+  for (auto i= N_SNAPSHOTS; i--; )
+  {
+    arg.ids.clear();
+    arg.limit= arg.no= N_ACTIVE + 1;
+    lf_hash_iterate(&hash, pins, copy_one_id, &arg);
+  }
+  const ulonglong hash_ns= my_interval_timer() - start;
+  const size_t n_hash= arg.ids.size();
+
+  start= my_interval_timer();
+  for (auto i= N_SNAPSHOTS; i--; )
+  {
+    arg.ids.clear();
+    active.snapshot(arg.ids, N_ACTIVE + 1);
+  }
+  const ulonglong array_ns= my_interval_timer() - start;
+
+  ok(n_hash == N_ACTIVE && arg.ids.size() == N_ACTIVE, "snapshot size");
+  diag("%u snapshots of %u transactions: rw_trx_hash %llu ns,"
+       " trx_active_t %llu ns", N_SNAPSHOTS, N_ACTIVE, hash_ns, array_ns);
+
+  for (uint32_t slot : slots)
+    active.erase(slot);
+  lf_hash_put_pins(pins);
+  lf_hash_destroy(&hash);
+}
+
+int main(int argc __attribute__((unused)), char **argv)
+{
+  std::thread t[N_THREADS];
+
+  MY_INIT(argv[0]);
+
+  plan(5);
+
+  active.create();
+
+  for (auto i= N_THREADS; i--; )
+    t[i]= std::thread(test_insert_erase);
+
+  for (auto i= N_THREADS; i--; )
+    t[i].join();
+
+  ok(!failed, "insert, snapshot, erase");
+
+  std::thread r[N_READERS];
+  committing= true;
+  for (auto i= N_READERS; i--; )
+    r[i]= std::thread(test_snapshot);
+  for (auto i= N_THREADS; i--; )
+    t[i]= std::thread(test_commit);
+  for (auto i= N_THREADS; i--; )
+    t[i].join();
+  committing= false;
+  for (auto i= N_READERS; i--; )
+    r[i].join();
+
+  ok(!failed, "snapshot concurrently with commit");
+
+  std::vector<ib_id_t> ids;
+  active.snapshot(ids, IB_ID_MAX);
+  ok(ids.empty() && !active.overflowed(),
+     "all slots freed");
+
+  benchmark();
+
+  ids.clear();
+  active.snapshot(ids, IB_ID_MAX);
+  ok(ids.empty(), "all slots freed after benchmark");
+
+  my_end(0);
+  return exit_status();
+}